@@ -18,6 +18,7 @@
 // --------------------------------------------------------------------------------------------------------------------
 
 #include "embot_prot_eth_ropframe.h"
+#include <vector>
 
 // --------------------------------------------------------------------------------------------------------------------
 // - pimpl: private implementation (see scott meyers: item 22 of effective modern c++, item 31 of effective c++
@@ -31,8 +32,19 @@ struct embot::prot::eth::diagnostic::Host::Impl
     embot::prot::eth::ropframe::Parser *_ropframeparser {nullptr};
     embot::prot::eth::rop::Descriptor ropdes {};
     
-    // it should be a map<ipv4, uint64_t>
-    uint64_t rxsequencenumber {0};
+    // the sources are kept in an open addressing hash table w/ linear probing which has at least twice the slots 
+    // of config.maxsources, so that a lookup is O(1). a source is removed only by reset()
+    struct Slot
+    {
+        Source source {};
+        uint64_t window {0};    // bit i is set if sequence number (source.lastsequence - i) was received
+        bool used {false};
+    };
+    
+    static constexpr uint64_t windowsize = 64;
+    std::vector<Slot> slots {};
+    size_t mask {0};
+    size_t numberofsources {0};
 
     
     Impl() = default;   
@@ -59,6 +71,10 @@ struct embot::prot::eth::diagnostic::Host::Impl
             _ropframeparser = nullptr;
         }
         
+        slots.clear();
+        mask = 0;
+        numberofsources = 0;
+        
         initted = false;
 
         return true;
@@ -75,10 +91,154 @@ struct embot::prot::eth::diagnostic::Host::Impl
 
         _ropframeparser = new embot::prot::eth::ropframe::Parser; // created, but it is an empty shell which will point to the accepted ropframe
         
+        if(0 != config.maxsources)
+        {
+            size_t n = 2;
+            while(n < 2*config.maxsources)
+            {
+                n <<= 1;
+            }
+            slots.resize(n);
+            mask = n - 1;
+        }
+        numberofsources = 0;
+        
         initted = true;
         return true;
     }
     
+    // it returns the index of the slot of ipv4 or of the empty slot where it should go. slots.size() if none of the two
+    size_t lookup(const embot::prot::eth::IPv4 &ipv4) const
+    {
+        if(slots.empty())
+        {
+            return 0;
+        }
+        
+        size_t i = (static_cast<uint32_t>(ipv4.v * 2654435761u) >> 8) & mask;
+        for(size_t n=0; n<slots.size(); n++)
+        {
+            if((!slots[i].used) || (slots[i].source.ipv4.v == ipv4.v))
+            {
+                return i;
+            }
+            i = (i+1) & mask;
+        }
+        return slots.size();
+    }
+    
+    void track(const embot::prot::eth::IPv4 &ipv4, uint64_t sequence, embot::core::Time age)
+    {
+        size_t i = lookup(ipv4);
+        if(i >= slots.size())
+        {
+            return;
+        }
+        
+        Slot &slot = slots[i];
+        Source &s = slot.source;
+        
+        if(!slot.used)
+        {
+            if(numberofsources >= config.maxsources)
+            {   // the table is full: this source is not tracked
+                return;
+            }
+            slot.used = true;
+            slot.window = 1;
+            numberofsources++;
+            s = {};
+            s.ipv4 = ipv4;
+            s.frames = 1;
+            s.lastsequence = sequence;
+            s.lastage = age;
+            return;
+        }
+        
+        s.frames++;
+        
+        if(sequence > s.lastsequence)
+        {   // the expected case w/ delta = 1
+            uint64_t delta = sequence - s.lastsequence;
+            if(delta > 1)
+            {
+                s.gaps++;
+                s.lost += (delta - 1);
+            }
+            slot.window = (delta >= windowsize) ? 1 : ((slot.window << delta) | 1);
+            s.lastsequence = sequence;
+            if((age > s.lastage) && ((age - s.lastage) > s.maxagedelta))
+            {
+                s.maxagedelta = age - s.lastage;
+            }
+            s.lastage = age;
+            return;
+        }
+        
+        uint64_t delta = s.lastsequence - sequence;
+        if(delta >= windowsize)
+        {   // too old to be a late one: the source has restarted  
+            s.restarts++;
+            slot.window = 1;
+            s.lastsequence = sequence;
+            s.lastage = age;
+        }
+        else if(0 != (slot.window & (static_cast<uint64_t>(1) << delta)))
+        {
+            s.duplicates++;
+        }
+        else
+        {   // a late one which fills a hole
+            slot.window |= (static_cast<uint64_t>(1) << delta);
+            s.reordered++;
+            if(s.lost > 0)
+            {
+                s.lost--;
+            }
+        }
+    }
+    
+    bool get(const embot::prot::eth::IPv4 &ipv4, Source &source) const
+    {
+        size_t i = lookup(ipv4);
+        if((i >= slots.size()) || (!slots[i].used))
+        {
+            return false;
+        }
+        source = slots[i].source;
+        return true;
+    }
+    
+    size_t snapshot(Source *sources, size_t capacity) const
+    {
+        size_t n = 0;
+        if(nullptr == sources)
+        {
+            return 0;
+        }
+        for(const auto &slot : slots)
+        {
+            if(n >= capacity)
+            {
+                break;
+            }
+            if(slot.used)
+            {
+                sources[n++] = slot.source;
+            }
+        }
+        return n;
+    }
+    
+    void reset()
+    {
+        for(auto &slot : slots)
+        {
+            slot = {};
+        }
+        numberofsources = 0;
+    }
+    
     
 //    bool load(EOrop* rop, embot::prot::eth::rop::Descriptor &ropdes)
 //    {
@@ -116,9 +276,8 @@ struct embot::prot::eth::diagnostic::Host::Impl
             return false;
         }
 
-        // check sequence number ... from each ip address, so ... maybe a map. but not in here
-        
-        uint64_t rxsequencenumber = _ropframeparser->getSequenceNumber();
+        // check sequence number of each ip address
+        track(ipv4, _ropframeparser->getSequenceNumber(), _ropframeparser->getTime());
         
         // and parse
         uint16_t numberofprocessed = 0;
@@ -152,9 +311,8 @@ struct embot::prot::eth::diagnostic::Host::Impl
             return false;
         }
 
-        // check sequence number ... from each ip address, so ... maybe a map. but not in here
-        
-        uint64_t rxsequencenumber = _ropframeparser->getSequenceNumber();
+        // check sequence number of each ip address
+        track(ipv4, _ropframeparser->getSequenceNumber(), _ropframeparser->getTime());
         
         // and parse
         uint16_t numberofprocessed = 0;
@@ -212,5 +370,25 @@ bool embot::prot::eth::diagnostic::Host::accept(const embot::prot::eth::IPv4 &ip
     return pImpl->accept(ipv4, ropframedata, onrop,orig);
 }
 
+size_t embot::prot::eth::diagnostic::Host::numberofsources() const
+{
+    return pImpl->numberofsources;
+}
+
+bool embot::prot::eth::diagnostic::Host::get(const embot::prot::eth::IPv4 &ipv4, Source &source) const
+{
+    return pImpl->get(ipv4, source);
+}
+
+size_t embot::prot::eth::diagnostic::Host::snapshot(Source *sources, size_t capacity) const
+{
+    return pImpl->snapshot(sources, capacity);
+}
+
+void embot::prot::eth::diagnostic::Host::reset()
+{
+    pImpl->reset();
+}
+
 // - end-of-file (leave a blank line after)----------------------------------------------------------------------------
 
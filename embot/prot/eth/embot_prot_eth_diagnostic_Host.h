@@ -26,11 +26,30 @@ namespace embot { namespace prot { namespace eth { namespace diagnostic {
             bool concurrentuse {false};
             size_t ropcapacity {128};
             embot::prot::eth::rop::fpOnROP onrop {nullptr};
+            size_t maxsources {64}; // the max number of ipv4 addresses whose ropframes are tracked by sequence number
             Config() = default;
-            constexpr Config(bool cu, size_t rc, embot::prot::eth::rop::fpOnROP o) 
-               : concurrentuse(cu), ropcapacity(rc), onrop(o) {}
+            constexpr Config(bool cu, size_t rc, embot::prot::eth::rop::fpOnROP o, size_t ms = 64) 
+               : concurrentuse(cu), ropcapacity(rc), onrop(o), maxsources(ms) {}
             bool isvalid() const { return (!onrop) && (ropcapacity >= 40); }
         };         
+        
+        // the statistics of the ropframes received from a given ipv4 address. 
+        // the sequence numbers are checked against a window of the latest 64: a ropframe older than that is considered 
+        // the sign that the source has restarted and the tracking starts again from it. 
+        struct Source
+        {
+            embot::prot::eth::IPv4 ipv4 {};
+            uint64_t frames {0};                // all the accepted ropframes, also duplicates and late ones
+            uint64_t lastsequence {0};          // the highest sequence number received 
+            uint64_t lost {0};                  // the sequence numbers still missing  
+            uint64_t gaps {0};                  // the times the sequence number jumped forward by more than one
+            uint64_t duplicates {0};            // the ropframes w/ a sequence number already received
+            uint64_t reordered {0};             // the ropframes arrived after a following one, they also decrement lost
+            uint32_t restarts {0};              // the times the sequence number went back beyond the window
+            embot::core::Time lastage {0};      // the age of the latest ropframe, as written by the source
+            embot::core::Time maxagedelta {0};  // the max difference of age between two consecutive ropframes
+            Source() = default;
+        };
                
         Host();  
         ~Host();
@@ -41,6 +60,12 @@ namespace embot { namespace prot { namespace eth { namespace diagnostic {
         bool initted() const;
         bool accept(const embot::prot::eth::IPv4 &ipv4, const embot::core::Data &ropframedata, embot::prot::eth::rop::fpOnROPext onrop ,void* orig);  
         bool accept(const embot::prot::eth::IPv4 &ipv4, const embot::core::Data &ropframedata, embot::prot::eth::rop::fpOnROP onrop = nullptr);  
+        
+        // the statistics of the sources. they must be called by the same thread which calls accept()
+        size_t numberofsources() const;
+        bool get(const embot::prot::eth::IPv4 &ipv4, Source &source) const;
+        size_t snapshot(Source *sources, size_t capacity) const; // copies at most capacity items, returns how many
+        void reset(); // clears the statistics of all the sources 
     
     private:    
         struct Impl;
@@ -20,6 +20,8 @@
 
 #include "embot_prot_eth_rop.h"
 #include "embot_prot_eth_ropframe.h"
+#include <atomic>
+#include <algorithm>
 
 // --------------------------------------------------------------------------------------------------------------------
 // - pimpl: private implementation (see scott meyers: item 22 of effective modern c++, item 31 of effective c++
@@ -31,8 +33,11 @@ struct embot::prot::eth::diagnostic::Node::Impl
     bool initted {false}; 
 
     embot::prot::eth::ropframe::Former *_ropframeformer {nullptr};
-    // used by _ropframeformer
+    // used by _ropframeformer. it holds config.numberofropframes buffers: the one at formingframe is loaded in the 
+    // _ropframeformer, the ones w/ inuse[i] true are given to the caller by acquire() and not yet released
     uint8_t *ropframedata {nullptr};
+    size_t formingframe {0};
+    std::atomic<bool> *inuse {nullptr};
     embot::core::Data buffer {nullptr, 0};
     uint8_t *bufferdata {nullptr};
     size_t buffercapacity {0};
@@ -45,6 +50,22 @@ struct embot::prot::eth::diagnostic::Node::Impl
     embot::prot::eth::rop::Stream *ropstr_info {nullptr};
     embot::prot::eth::rop::Stream *ropstr_infobasic {nullptr};
     
+    // concurrentuse mode: add() encodes the rop in a Cell of a bounded multi-producer single-consumer queue 
+    // (see dmitry vyukov's bounded mpmc queue). a Cell is free for the producer of position pos when its sequence is
+    // pos, and it is ready for the consumer when its sequence is pos+1
+    struct Cell
+    {
+        std::atomic<size_t> sequence {0};
+        uint16_t size {0};
+        uint8_t *stream {nullptr};
+    };
+    
+    Cell *cells {nullptr};
+    uint8_t *cellsdata {nullptr};
+    size_t numberofcells {0};
+    std::atomic<size_t> enqueuepos {0};
+    size_t dequeuepos {0};    
+    
     
     Impl() = default;   
 
@@ -76,6 +97,12 @@ struct embot::prot::eth::diagnostic::Node::Impl
             delete[] ropframedata;
             ropframedata = nullptr;
         }
+        
+        if(nullptr != inuse)
+        {
+            delete[] inuse;
+            inuse = nullptr;
+        }
 
         if(nullptr != _ropframeformer)
         {
@@ -107,6 +134,15 @@ struct embot::prot::eth::diagnostic::Node::Impl
             delete _ropstream;
             _ropstream =  nullptr;
         }
+        
+        if(nullptr != cells)
+        {
+            delete[] cells;
+            cells = nullptr;
+            delete[] cellsdata;
+            cellsdata = nullptr;
+            numberofcells = 0;
+        }
 
         initted = false;
 
@@ -128,7 +164,13 @@ struct embot::prot::eth::diagnostic::Node::Impl
         config = c;
         _ropframeformer = new embot::prot::eth::ropframe::Former; // empty shell
         uint16_t nbytes4frame = config.ropframecapacity;
-        ropframedata = new uint8_t[nbytes4frame];
+        ropframedata = new uint8_t[nbytes4frame * config.numberofropframes];
+        inuse = new std::atomic<bool>[config.numberofropframes];
+        for(size_t i=0; i<config.numberofropframes; i++)
+        {
+            inuse[i].store(false, std::memory_order_relaxed);
+        }
+        formingframe = 0;
         // give memory to the empty shell, so that it contains the header-ropspace-footer + a service ropstream
         _ropstream = new embot::prot::eth::rop::Stream(config.singleropstreamcapacity);
         _ropframeformer->load({ropframedata, nbytes4frame}, _ropstream);         
@@ -175,9 +217,173 @@ struct embot::prot::eth::diagnostic::Node::Impl
             plusMODE
         };
         ropstr_infolarge->load(sig_infolarge);
+        
+        if(config.concurrentuse)
+        {   // the queue can host at least two ropframes full of InfoBasic
+            constexpr size_t smallestrop = embot::prot::eth::rop::Header::sizeofobject + embot::prot::eth::diagnostic::InfoBasic::sizeofobject;
+            size_t required = std::max<size_t>(4, 2 * config.ropframecapacity / smallestrop);
+            numberofcells = 1;
+            while(numberofcells < required)
+            {
+                numberofcells <<= 1;
+            }
+            // the stride keeps each stream 8-aligned, so that the rop::Header can be written in place
+            size_t stride = (config.singleropstreamcapacity + 7) & ~static_cast<size_t>(7);
+            cells = new Cell[numberofcells];
+            cellsdata = new uint8_t[numberofcells * stride];
+            for(size_t i=0; i<numberofcells; i++)
+            {
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+                cells[i].stream = cellsdata + i * stride;
+            }
+            enqueuepos.store(0, std::memory_order_relaxed);
+            dequeuepos = 0;
+        }
+        
         initted = true;
         return true;
     }
+    
+    // concurrentuse mode only. it returns the Cell reserved to the caller or nullptr if the queue is full
+    Cell * acquire(size_t &pos)
+    {
+        const size_t mask = numberofcells - 1;
+        pos = enqueuepos.load(std::memory_order_relaxed);
+        for(;;)
+        {
+            Cell *cell = &cells[pos & mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t dif = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if(0 == dif)
+            {
+                if(enqueuepos.compare_exchange_weak(pos, pos+1, std::memory_order_relaxed))
+                {
+                    return cell;
+                }
+                // else: pos was updated by compare_exchange_weak() 
+            }
+            else if(dif < 0)
+            {
+                return nullptr;
+            }
+            else
+            {
+                pos = enqueuepos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    
+    // concurrentuse mode only. it makes the Cell visible to prepare()
+    void publish(Cell *cell, size_t pos, uint16_t size)
+    {
+        cell->size = size;
+        cell->sequence.store(pos+1, std::memory_order_release);
+    }
+    
+    // concurrentuse mode only. it tells if a rop of a given size can ever enter the ropframe
+    bool fits(size_t size) const
+    {
+        return (size <= config.singleropstreamcapacity) && 
+               ((size + embot::prot::eth::ropframe::Header::sizeofobject + embot::prot::eth::ropframe::Footer::sizeofobject) <= config.ropframecapacity);
+    }
+    
+    // concurrentuse mode only. it enqueues a ropstream already formed
+    bool enqueue(const uint8_t *ropstream, size_t size)
+    {
+        if(!fits(size))
+        {
+            return false;
+        }
+        size_t pos = 0;
+        Cell *cell = acquire(pos);
+        if(nullptr == cell)
+        {
+            return false;
+        }
+        std::memmove(cell->stream, ropstream, size);
+        publish(cell, pos, static_cast<uint16_t>(size));
+        return true;
+    }
+    
+    // concurrentuse mode only. it enqueues a preformed ropstream w/ new data, as embot::prot::eth::rop::Stream::update() does
+    bool enqueue(embot::prot::eth::rop::Stream *preformed, const embot::core::Data &data)
+    {
+        uint8_t *strm = nullptr;
+        size_t ss = 0;
+        preformed->retrieve(&strm, ss); // it is only read, so it can be shared by all the threads
+        if(!fits(ss))
+        {
+            return false;
+        }
+        size_t pos = 0;
+        Cell *cell = acquire(pos);
+        if(nullptr == cell)
+        {
+            return false;
+        }
+        const embot::prot::eth::rop::Header *header = reinterpret_cast<const embot::prot::eth::rop::Header*>(strm);
+        std::memmove(cell->stream, strm, ss);
+        std::memmove(cell->stream + embot::prot::eth::rop::Header::sizeofobject, data.pointer, std::min<size_t>(header->datasize, data.capacity));
+        publish(cell, pos, static_cast<uint16_t>(ss));
+        return true;
+    }
+    
+    // concurrentuse mode only. it enqueues a rop encoded as embot::prot::eth::rop::Stream::load() does
+    bool enqueue(const embot::prot::eth::rop::Descriptor &des)
+    {
+        size_t required = embot::prot::eth::rop::Stream::capacityfor(des.opcode, des.value.capacity, des.plus);
+        if(!fits(required))
+        {
+            return false;
+        }
+        size_t pos = 0;
+        Cell *cell = acquire(pos);
+        if(nullptr == cell)
+        {
+            return false;
+        }
+        
+        embot::prot::eth::rop::Header *header = reinterpret_cast<embot::prot::eth::rop::Header*>(cell->stream);
+        uint8_t *data = cell->stream + embot::prot::eth::rop::Header::sizeofobject;
+        *header = {{des.plus, embot::prot::eth::rop::RQST::none, embot::prot::eth::rop::CONF::none}, des.opcode, 
+                   static_cast<uint16_t>(embot::prot::eth::rop::normalisedsizeofdata(des.value.capacity)), des.id32};
+        if(des.value.isvalid())
+        {
+            std::memmove(data, des.value.pointer, std::min<size_t>(header->datasize, des.value.capacity));
+        }
+        if(des.hassignature())
+        {
+            std::memmove(data + header->datasize, &des.signature, sizeof(des.signature));
+        }
+        if(des.hastime())
+        {
+            std::memmove(data + header->datasize + 4, &des.time, sizeof(des.time));
+        }
+        
+        publish(cell, pos, static_cast<uint16_t>(required));
+        return true;
+    }
+    
+    // concurrentuse mode only. it moves the ready rops into the ropframe until it is full 
+    void drain()
+    {
+        const size_t mask = numberofcells - 1;
+        for(;;)
+        {
+            Cell *cell = &cells[dequeuepos & mask];
+            if(cell->sequence.load(std::memory_order_acquire) != (dequeuepos+1))
+            {   // empty or the producer has not finished yet
+                break;
+            }
+            uint16_t availspace = 0;
+            if(false == _ropframeformer->pushback({cell->stream, cell->size}, availspace))
+            {   // the ropframe is full: the rop stays in the queue
+                break;
+            }
+            cell->sequence.store(dequeuepos + numberofcells, std::memory_order_release);
+            dequeuepos++;
+        }
+    }
 
     bool add(const embot::core::Data &ropstream)
     {
@@ -190,6 +396,11 @@ struct embot::prot::eth::diagnostic::Node::Impl
         {
             return false;
         }
+        
+        if(config.concurrentuse)
+        {
+            return enqueue(ropstream.getU08ptr(), ropstream.capacity);
+        }
 
         uint16_t availspace = 0;
         return _ropframeformer->pushback(ropstream, availspace);
@@ -207,6 +418,11 @@ struct embot::prot::eth::diagnostic::Node::Impl
         {
             return false;
         }        
+        
+        if(config.concurrentuse)
+        {
+            return enqueue(ropdes);
+        }
           
         uint16_t availspace = 0;
         return _ropframeformer->pushback(ropdes, availspace);
@@ -223,6 +439,10 @@ struct embot::prot::eth::diagnostic::Node::Impl
         // i need a pre-former rop (or ropstream) where to just add the infobasic stuff
         embot::core::Data da{const_cast<embot::prot::eth::diagnostic::InfoBasic*>(&infobasic), embot::prot::eth::diagnostic::InfoBasic::sizeofobject};
         //embot::core::Data da{&infobasic, embot::prot::eth::diagnostic::InfoBasic::size};
+        if(config.concurrentuse)
+        {
+            return enqueue(ropstr_infobasic, da);
+        }
         static uint32_t sig = 0;
         ropstr_infobasic->update(da, sig++);
         
@@ -245,6 +465,10 @@ struct embot::prot::eth::diagnostic::Node::Impl
         
         // i need a pre-former rop (or ropstream) where to just add the info stuff
         embot::core::Data da{const_cast<embot::prot::eth::diagnostic::Info*>(&info), embot::prot::eth::diagnostic::Info::sizeofobject};
+        if(config.concurrentuse)
+        {
+            return enqueue(stream, da);
+        }
         static uint32_t sig = 0;
         stream->update(da, sig++);
         
@@ -267,6 +491,10 @@ struct embot::prot::eth::diagnostic::Node::Impl
 
         // i need a pre-former rop (or ropstream) where to just add the infobasic stuff
         embot::core::Data da{const_cast<embot::prot::eth::diagnostic::InfoLarge*>(&infolarge), embot::prot::eth::diagnostic::InfoLarge::sizeofobject};
+        if(config.concurrentuse)
+        {
+            return enqueue(stream, da);
+        }
         static uint32_t sig = 0;
         stream->update(da, sig++);
 
@@ -290,6 +518,11 @@ struct embot::prot::eth::diagnostic::Node::Impl
 
         sizeofropframe = 0;
 #if 1
+        if(config.concurrentuse)
+        {
+            drain();
+        }
+        
         if(0 == _ropframeformer->getNumberOfROPs())
         {
             return false;
@@ -382,8 +615,83 @@ struct embot::prot::eth::diagnostic::Node::Impl
         return true;
     }
     
+    bool acquire(embot::core::Data &ropframe)
+    {
+        if(!initted)
+        {
+            return false;
+        }
+        
+        if(config.concurrentuse)
+        {
+            drain();
+        }
+        
+        if(0 == _ropframeformer->getNumberOfROPs())
+        {
+            return false;
+        }
+        
+        // i need a free buffer where to form the next ropframe
+        const size_t n = config.numberofropframes;
+        size_t next = n;
+        for(size_t i=1; i<n; i++)
+        {
+            size_t candidate = (formingframe + i) % n;
+            if(false == inuse[candidate].load(std::memory_order_acquire))
+            {
+                next = candidate;
+                break;
+            }
+        }
+        
+        if(n == next)
+        {   // all the other buffers are still used by the caller: the rops stay in the current ropframe
+            return false;
+        }
+        
+        embot::core::Time timenow = embot::core::now();
+        _ropframeformer->set(timenow, sequencenumber++);
+        _ropframeformer->get(ropframe);
+        inuse[formingframe].store(true, std::memory_order_relaxed);
+        
+        // the former now uses the other buffer
+        formingframe = next;
+        _ropframeformer->load({ropframedata + next * config.ropframecapacity, config.ropframecapacity}, _ropstream);
+        
+        return true;
+    }
+    
+    bool release(const embot::core::Data &ropframe)
+    {
+        if(!initted)
+        {
+            return false;
+        }
+        
+        const uint8_t *p = ropframe.getU08ptr();
+        if((p < ropframedata) || (p >= (ropframedata + config.numberofropframes * config.ropframecapacity)))
+        {
+            return false;
+        }
+        
+        size_t i = (p - ropframedata) / config.ropframecapacity;
+        if((ropframedata + i * config.ropframecapacity) != p)
+        {
+            return false;
+        }
+        
+        bool expected = true;
+        return inuse[i].compare_exchange_strong(expected, false, std::memory_order_release, std::memory_order_relaxed);
+    }
+    
     uint16_t getNumberOfROPs() const
     {
+        if(config.concurrentuse)
+        {   // also the ones still in the queue 
+            size_t queued = enqueuepos.load(std::memory_order_relaxed) - dequeuepos;
+            return _ropframeformer->getNumberOfROPs() + static_cast<uint16_t>(queued);
+        }
         return _ropframeformer->getNumberOfROPs();
     }
 
@@ -460,6 +768,16 @@ bool embot::prot::eth::diagnostic::Node::retrieve(embot::core::Data &datainropfr
     return pImpl->retrieve(datainropframe);
 }
 
+bool embot::prot::eth::diagnostic::Node::acquire(embot::core::Data &ropframe)
+{
+    return pImpl->acquire(ropframe);
+}
+
+bool embot::prot::eth::diagnostic::Node::release(const embot::core::Data &ropframe)
+{
+    return pImpl->release(ropframe);
+}
+
 uint16_t embot::prot::eth::diagnostic::Node::getNumberOfROPs() const
 {
     return pImpl->getNumberOfROPs();
@@ -27,14 +27,15 @@ namespace embot { namespace prot { namespace eth { namespace diagnostic {
     public:
         struct Config
         {
-            bool concurrentuse {false}; // ffu
+            bool concurrentuse {false}; // if true, add() can be called by many threads at the same time. prepare() and retrieve() by one only
             uint16_t singleropstreamcapacity {128};
             uint16_t ropframecapacity {512};
+            uint8_t numberofropframes {2}; // the buffers used by acquire() / release(). with 1, acquire() cannot be used
             // todo: 
             // - add any customisation such as: capacityofropframe, maxropsize, capacity of fifo of ropframes, etc.  
             Config() = default;
-            constexpr Config(bool cu, uint16_t src, uint16_t rfc) : concurrentuse(cu), singleropstreamcapacity(src), ropframecapacity(rfc) {}
-            bool isvalid() const { return (ropframecapacity > (28+32)) && (singleropstreamcapacity > 32); }
+            constexpr Config(bool cu, uint16_t src, uint16_t rfc, uint8_t nrf = 2) : concurrentuse(cu), singleropstreamcapacity(src), ropframecapacity(rfc), numberofropframes(nrf) {}
+            bool isvalid() const { return (ropframecapacity > (28+32)) && (singleropstreamcapacity > 32) && (numberofropframes > 0); }
         };         
                
         Node();  
@@ -42,6 +43,13 @@ namespace embot { namespace prot { namespace eth { namespace diagnostic {
 
         // usage: init(), then add() as many rops one wants, then when one wants to attempt transmit: 
         // if(prepare()) { retrieve(data); <alert the sender>}
+        // in concurrentuse mode add() does not touch the ropframe: it encodes the rop into a bounded lock-free queue 
+        // which prepare() drains into the ropframe. the rops which dont fit the ropframe stay in the queue for the 
+        // next prepare(). add() returns false if the queue is full.
+        // zero-copy alternative to prepare() + retrieve(): if(acquire(frame)) { <send frame>; release(frame); }
+        // acquire() completes the ropframe in place and gives a read-only view of it while the following rops are formed
+        // inside another of the Config::numberofropframes buffers. the view is valid until release(), which can be 
+        // called by any thread. acquire() returns false if there are no rops or if all the other buffers are not released yet.
 
         bool init(const Config &config);
         bool initted() const;
@@ -52,6 +60,8 @@ namespace embot { namespace prot { namespace eth { namespace diagnostic {
         bool add(const embot::prot::eth::diagnostic::InfoLarge &infolarge);
         bool prepare(size_t &sizeofropframe); // returns true if anything to retrieve. in sizeofropframe the size of required mem
         bool retrieve(embot::core::Data &datainropframe); // it copies the ropframe. 
+        bool acquire(embot::core::Data &ropframe);
+        bool release(const embot::core::Data &ropframe);
         uint16_t getNumberOfROPs() const;
 
     private:    
@@ -243,6 +243,55 @@ namespace embot { namespace prot {  namespace eth { namespace rop {
     };  
 
 
+    // it is inline so that the templated ropframe::Parser::parse() can decode the rops w/out any call
+    inline bool Descriptor::load(embot::core::Data &stream, uint16_t &consumed)
+    {
+        reset();
+        consumed = 0;
+        if(false == stream.isvalid())
+        {
+            return false;
+        }
+        
+        if(stream.capacity < Header::sizeofobject)
+        {
+            return false;
+        }
+        
+        Header *rophead = reinterpret_cast<Header*>(stream.pointer);
+        
+        // now i need to see how big the ropstream is expected to be
+        size_t expectedsize = Stream::capacityfor(rophead->opc, rophead->datasize, rophead->fmt.getPLUS());
+        if((expectedsize > stream.capacity) || (0 != (rophead->datasize % 4))) // it was < ...
+        {
+            return false;
+        }
+        
+        // ok, we can consume the bytes
+        consumed = expectedsize;
+        
+        // and we fill the fields of the Descriptor
+        opcode = rophead->opc;
+        id32 = rophead->id32;
+        value.capacity = rophead->datasize;
+        value.pointer = (0 == value.capacity) ? nullptr : (stream.getU08ptr() + sizeof(Header));
+        uint16_t offset_time = 0;
+        if(rophead->fmt.isPLUSsignature())
+        {
+            offset_time = sizeof(signature);
+            std::memmove(&signature, stream.getU08ptr() + sizeof(Header) + rophead->datasize, sizeof(signature));
+        }
+        if(rophead->fmt.isPLUStime())
+        {
+            std::memmove(&time, stream.getU08ptr() + sizeof(Header) + rophead->datasize + offset_time, sizeof(time));
+        }  
+        
+        rophead->fmt.extract(plus, rqst, conf);
+        
+        return true;  
+    }
+
+
 
 }}}} // namespace embot { namespace prot {  namespace eth { namespace rop {
 
@@ -368,6 +368,17 @@ struct coreImpl
         return true;
     }
 
+    bool getROPs(embot::core::Data &ropstream, uint16_t &numberofrops) const
+    {
+        if(nullptr == ref2header)
+        {
+            return false;
+        }
+        ropstream.load(ref2body, ref2header->sizeofbody);
+        numberofrops = ref2header->numberofrops;
+        return true;
+    }
+
     bool get(embot::core::Data& frame, uint16_t &capacity) const
     {
         frame.capacity = getSize();
@@ -423,11 +434,21 @@ bool embot::prot::eth::ropframe::Parser::parse(const embot::prot::eth::IPv4 &ipv
     return pImpl->parse(ipv4, onrop, numberofprocessed,orig);
 }
 
+bool embot::prot::eth::ropframe::Parser::getROPs(embot::core::Data &ropstream, uint16_t &numberofrops) const
+{
+    return pImpl->getROPs(ropstream, numberofrops);
+}
+
 uint64_t  embot::prot::eth::ropframe::Parser::getSequenceNumber() const
 {
     return pImpl->getSequenceNumber();
 }
 
+embot::core::Time embot::prot::eth::ropframe::Parser::getTime() const
+{
+    return pImpl->getTime();
+}
+
 bool embot::prot::eth::ropframe::Parser::isvalid() const
 {
     return pImpl->isvalid();
@@ -17,6 +17,7 @@
 #include "embot_core.h"
 #include "embot_core_utils.h"
 #include "embot_prot_eth_rop.h"
+#include <utility>
 
 
     // description
@@ -128,6 +129,8 @@ namespace embot { namespace prot {  namespace eth { namespace ropframe {
     // a. it is created as an empty shell to which we can load() a received ropframe and later unload() it.
     // b. we can check: if it isvalid(), its size, number of rops etc. 
     // c. we can parse all the ROPs inside by calling a user-defined callback
+    // d. or we can parse them w/ the templated parse() which accepts any callable (a lambda, a functor, a Dispatcher<>)
+    //    so that the compiler can inline the processing of each ROP.
     
     class Parser
     {
@@ -147,12 +150,92 @@ namespace embot { namespace prot {  namespace eth { namespace ropframe {
         uint64_t getSequenceNumber() const;           
         bool parse(const embot::prot::eth::IPv4 &ipv4, embot::prot::eth::rop::fpOnROPext onrop,  uint16_t &numberofprocessed,void* orig); 
         bool parse(const embot::prot::eth::IPv4 &ipv4, embot::prot::eth::rop::fpOnROP onrop, uint16_t &numberofprocessed);        
+        // onrop must be callable as: bool onrop(const embot::prot::eth::IPv4 &ipv4, const embot::prot::eth::rop::Descriptor &rop)
+        // otherwise this overload is discarded, so that a nullptr goes to the one w/ fpOnROP which returns false
+        template<typename ONROP, typename = decltype(std::declval<ONROP&>()(std::declval<const embot::prot::eth::IPv4&>(), std::declval<const embot::prot::eth::rop::Descriptor&>()))>
+        bool parse(const embot::prot::eth::IPv4 &ipv4, ONROP &&onrop, uint16_t &numberofprocessed);
                        
     private:    
+        bool getROPs(embot::core::Data &ropstream, uint16_t &numberofrops) const;
         struct Impl;
         Impl *pImpl;     
     };
     
+    
+    // ropframe::On<> and ropframe::Dispatcher<> - description:
+    // a. they form a table built at compile time which maps an ID32 to the function which processes its ROP.
+    //    the ID32 is a template parameter, hence it can be computed with the constexpr embot::prot::eth::getID32()
+    // b. a Dispatcher<> is a callable for the templated Parser::parse(). the ROPs whose ID32 is not in the table
+    //    are skipped and their processing returns false.
+    // c. it is a compile error to have the same ID32 twice in the table.
+    // example:
+    // using Table = Dispatcher<On<getID32(EP::management, EN::mnInfo, 0, 0), onmninfo>, On<getID32(...), onother>>;
+    // parser.parse(ipv4, Table{}, numberofprocessed);
+    
+    template<embot::prot::eth::ID32 ID, embot::prot::eth::rop::fpOnROP ONROP>
+    struct On
+    {
+        constexpr static embot::prot::eth::ID32 id32 = ID;
+        static bool process(const embot::prot::eth::IPv4 &ipv4, const embot::prot::eth::rop::Descriptor &rop) { return ONROP(ipv4, rop); }
+    };
+    
+    template<typename... ONs>
+    struct Dispatcher;
+    
+    template<>
+    struct Dispatcher<>
+    {
+        constexpr static bool contains(embot::prot::eth::ID32) { return false; }
+        bool operator()(const embot::prot::eth::IPv4 &, const embot::prot::eth::rop::Descriptor &) const { return false; }
+    };
+    
+    template<typename ON, typename... ONs>
+    struct Dispatcher<ON, ONs...>
+    {
+        static_assert(!Dispatcher<ONs...>::contains(ON::id32), "embot::prot::eth::ropframe::Dispatcher has the same ID32 more than once");
+        
+        constexpr static bool contains(embot::prot::eth::ID32 id) { return (ON::id32 == id) || Dispatcher<ONs...>::contains(id); }
+        
+        bool operator()(const embot::prot::eth::IPv4 &ipv4, const embot::prot::eth::rop::Descriptor &rop) const 
+        { 
+            return (ON::id32 == rop.id32) ? ON::process(ipv4, rop) : Dispatcher<ONs...>{}(ipv4, rop); 
+        }
+    };
+    
+    
+    template<typename ONROP, typename>
+    bool Parser::parse(const embot::prot::eth::IPv4 &ipv4, ONROP &&onrop, uint16_t &numberofprocessed)
+    {
+        numberofprocessed = 0;
+        
+        embot::core::Data ropstream {};
+        uint16_t numberofrops = 0;
+        if(false == getROPs(ropstream, numberofrops))
+        {
+            return false;
+        }
+        
+        embot::prot::eth::rop::Descriptor des {};
+        uint8_t *body = ropstream.getU08ptr();
+        uint16_t avail = ropstream.capacity;
+        for(uint16_t i=0; i<numberofrops; i++)
+        {
+            uint16_t consumed = 0;
+            embot::core::Data stream(body, avail);
+            if(false == des.load(stream, consumed))
+            {
+                break;
+            }
+            
+            numberofprocessed += consumed;
+            body += consumed; 
+            avail -= consumed;            
+            onrop(ipv4, des);
+        }
+        
+        return true;
+    }
+    
 
 }}}} // namespace embot { namespace prot {  namespace eth { namespace rop {
 
@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2026 iCub Tech - Istituto Italiano di Tecnologia
+*/
+
+// - brief
+//   contention benchmark of embot::prot::eth::diagnostic::Node: 8 producer threads add() InfoBasic at full rate while
+//   one consumer thread calls prepare() and retrieve() and parses the ropframes. it compares the concurrentuse mode
+//   against the default mode where a std::mutex serialises add() and prepare() as the users had to do. it reports the
+//   adds per second, the adds refused because the node is full and the rops delivered per second. it fails if a rop
+//   is lost, repeated or out of the order of its producer.
+//   usage: bench_embot_prot_eth_diagnostic_Node [milliseconds of every measure]
+
+
+#include "embot_prot_eth_diagnostic_Node.h"
+#include "embot_prot_eth_ropframe.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace {
+
+    constexpr size_t numberofproducers = 8;
+    constexpr uint16_t ropframecapacity = 1024;
+
+    struct Result
+    {
+        uint64_t added {0};
+        uint64_t refused {0};
+        uint64_t delivered {0};
+        uint64_t wrong {0};
+    };
+
+    struct Bench
+    {
+        embot::prot::eth::diagnostic::Node node {};
+        std::mutex mtx {};
+        bool concurrentuse {false};
+        std::atomic<bool> stop {false};
+        std::atomic<size_t> running {0};
+        uint64_t added[numberofproducers] {0};
+        uint64_t refused[numberofproducers] {0};
+        uint32_t expected[numberofproducers] {0};
+        uint64_t delivered {0};
+        uint64_t wrong {0};
+
+        bool add(const embot::prot::eth::diagnostic::InfoBasic &info)
+        {
+            if(concurrentuse)
+            {
+                return node.add(info);
+            }
+            std::lock_guard<std::mutex> lock(mtx);
+            return node.add(info);
+        }
+
+        bool prepare(size_t &size)
+        {
+            if(concurrentuse)
+            {
+                return node.prepare(size);
+            }
+            std::lock_guard<std::mutex> lock(mtx);
+            return node.prepare(size);
+        }
+    };
+
+    void producer(Bench *b, size_t id)
+    {
+        uint32_t sequence = 0;
+        while(!b->stop.load(std::memory_order_relaxed))
+        {
+            embot::prot::eth::diagnostic::InfoBasic info {};
+            info.code = 0x01000001;
+            info.par16 = static_cast<uint16_t>(id);
+            info.par64 = (static_cast<uint64_t>(id) << 32) | sequence;
+            if(b->add(info))
+            {
+                sequence++;
+                b->added[id]++;
+            }
+            else
+            {
+                b->refused[id]++;
+            }
+        }
+        b->running--;
+    }
+
+    void consume(Bench *b, uint8_t *frame)
+    {   // each producer must be seen with its sequence numbers in order and without holes
+        embot::prot::eth::ropframe::Parser parser {};
+        uint16_t processed = 0;
+        parser.load({frame, ropframecapacity});
+        parser.parse({}, [b](const embot::prot::eth::IPv4 &, const embot::prot::eth::rop::Descriptor &rop)
+        {
+            embot::prot::eth::diagnostic::InfoBasic info {};
+            std::memmove(&info, rop.value.pointer, sizeof(info));
+            size_t id = static_cast<size_t>(info.par64 >> 32);
+            if((id >= numberofproducers) || (static_cast<uint32_t>(info.par64) != b->expected[id]))
+            {
+                b->wrong++;
+            }
+            else
+            {
+                b->expected[id]++;
+            }
+            b->delivered++;
+            return true;
+        }, processed);
+    }
+
+    Result run(bool concurrentuse, uint32_t ms)
+    {
+        Bench b {};
+        b.concurrentuse = concurrentuse;
+        b.node.init({concurrentuse, 128, ropframecapacity});
+
+        std::vector<uint8_t> frame(ropframecapacity);
+        std::vector<std::thread> producers {};
+        b.running = numberofproducers;
+        for(size_t i=0; i<numberofproducers; i++)
+        {
+            producers.emplace_back(producer, &b, i);
+        }
+
+        auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(ms);
+        for(;;)
+        {
+            size_t size = 0;
+            bool producing = (std::chrono::steady_clock::now() < end);
+            // read before prepare(): a producer stops running only after its last add()
+            size_t running = b.running.load();
+            if(!producing)
+            {
+                b.stop = true;
+            }
+            if(b.prepare(size))
+            {
+                embot::core::Data data {frame.data(), frame.size()};
+                b.node.retrieve(data);
+                consume(&b, frame.data());
+            }
+            else if(!producing && (0 == running))
+            {   // the producers have stopped and the node is empty
+                break;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+        for(auto &t : producers)
+        {
+            t.join();
+        }
+
+        Result r {};
+        for(size_t i=0; i<numberofproducers; i++)
+        {
+            r.added += b.added[i];
+            r.refused += b.refused[i];
+        }
+        r.delivered = b.delivered;
+        r.wrong = b.wrong + ((r.added > r.delivered) ? (r.added - r.delivered) : (r.delivered - r.added));
+        return r;
+    }
+
+}
+
+
+int main(int argc, char *argv[])
+{
+    uint32_t ms = (argc > 1) ? static_cast<uint32_t>(std::atoi(argv[1])) : 100;
+    int errors = 0;
+
+    std::printf("%-10s %10s %14s %14s %14s\n", "mode", "producers", "adds/s", "refused/s", "delivered/s");
+    for(bool concurrentuse : {false, true})
+    {
+        const char *name = concurrentuse ? "concurrent" : "mutex";
+        Result r = run(concurrentuse, ms);
+        if(0 != r.wrong)
+        {
+            std::printf("FAIL: %llu rops lost, repeated or out of order with %s\n", static_cast<unsigned long long>(r.wrong), name);
+            errors++;
+        }
+        std::printf("%-10s %10zu %14.0f %14.0f %14.0f\n", name, numberofproducers, 1000.0*r.added/ms, 1000.0*r.refused/ms, 1000.0*r.delivered/ms);
+    }
+
+    std::printf("%s\n", (0 == errors) ? "OK" : "FAIL");
+    return (0 == errors) ? 0 : 1;
+}
+
+
+// - end-of-file (leave a blank line after)----------------------------------------------------------------------------
+
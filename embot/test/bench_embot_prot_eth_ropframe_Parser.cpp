@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2026 iCub Tech - Istituto Italiano di Tecnologia
+*/
+
+// - brief
+//   benchmark of embot::prot::eth::ropframe::Parser::parse() on synthetic ropframes with 1 to 100 sig<> rops: the
+//   overload w/ a rop::fpOnROP against the templated one w/ a lambda which the compiler can inline. both callbacks do
+//   the same work on every rop. it reports the nanoseconds per ropframe and per rop. it fails if the two overloads do
+//   not process the same rops, or if parse() w/ a nullptr callback does not return false.
+//   usage: bench_embot_prot_eth_ropframe_Parser [milliseconds of every measure]
+
+
+#include "embot_prot_eth_ropframe.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+
+namespace {
+
+    constexpr size_t capacityofropframe = 4096;
+    constexpr size_t sizeofvalue = 16;
+
+    struct Work
+    {
+        uint64_t rops {0};
+        uint64_t sum {0};
+    };
+
+    Work work {};
+    volatile uint64_t sink {0};
+
+    // the processing of a rop: the same for both overloads
+    inline void process(Work &w, const embot::prot::eth::rop::Descriptor &rop)
+    {
+        w.rops++;
+        w.sum += rop.id32 + rop.value.getU08ptr()[0];
+    }
+
+    bool onrop(const embot::prot::eth::IPv4 &, const embot::prot::eth::rop::Descriptor &rop)
+    {
+        process(work, rop);
+        return true;
+    }
+
+    bool build(std::vector<uint8_t> &frame, uint16_t numberofrops)
+    {
+        embot::prot::eth::ropframe::Former former {};
+        embot::prot::eth::rop::Stream stream {64};
+        uint8_t value[sizeofvalue] = {0};
+        uint16_t available = 0;
+
+        frame.assign(capacityofropframe, 0);
+        if(false == former.load({frame.data(), frame.size()}, &stream))
+        {
+            return false;
+        }
+        for(uint16_t i=0; i<numberofrops; i++)
+        {
+            value[0] = static_cast<uint8_t>(i);
+            embot::prot::eth::rop::Descriptor des {embot::prot::eth::rop::OPC::sig, embot::prot::eth::getID32(embot::prot::eth::EP::management, embot::prot::eth::EN::mnInfo, 0, static_cast<embot::prot::eth::Tag>(i % 8)),
+                                                   {value, sizeof(value)}};
+            if(false == former.pushback(des, available))
+            {
+                return false;
+            }
+        }
+        return (numberofrops == former.getNumberOfROPs());
+    }
+
+    // it parses the ropframe once and returns what the callback saw
+    Work once(embot::prot::eth::ropframe::Parser &parser, bool templated)
+    {
+        uint16_t processed = 0;
+        Work local {};
+        work = {};
+        if(templated)
+        {
+            parser.parse({}, [&local](const embot::prot::eth::IPv4 &, const embot::prot::eth::rop::Descriptor &rop) { process(local, rop); return true; }, processed);
+            return local;
+        }
+        parser.parse({}, onrop, processed);
+        return work;
+    }
+
+    // it returns the nanoseconds per ropframe
+    double run(embot::prot::eth::ropframe::Parser &parser, bool templated, uint32_t ms)
+    {
+        const embot::prot::eth::IPv4 ipv4 {};
+        uint16_t processed = 0;
+        uint64_t frames = 0;
+        auto start = std::chrono::steady_clock::now();
+        auto end = start + std::chrono::milliseconds(ms);
+        auto now = start;
+
+        Work local {};
+        do
+        {
+            for(int i=0; i<100; i++)
+            {
+                if(templated)
+                {
+                    parser.parse(ipv4, [&local](const embot::prot::eth::IPv4 &, const embot::prot::eth::rop::Descriptor &rop) { process(local, rop); return true; }, processed);
+                }
+                else
+                {
+                    parser.parse(ipv4, onrop, processed);
+                }
+            }
+            frames += 100;
+            now = std::chrono::steady_clock::now();
+        } while(now < end);
+
+        sink = local.sum + work.sum;
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count()) / frames;
+    }
+
+}
+
+
+int main(int argc, char *argv[])
+{
+    uint32_t ms = (argc > 1) ? static_cast<uint32_t>(std::atoi(argv[1])) : 100;
+    int errors = 0;
+    std::vector<uint8_t> frame {};
+    uint16_t processed = 0;
+
+    // a nullptr selects the overload w/ fpOnROP, which refuses it
+    build(frame, 1);
+    embot::prot::eth::ropframe::Parser parser {};
+    parser.load({frame.data(), frame.size()});
+    if(false != parser.parse({}, nullptr, processed))
+    {
+        std::printf("FAIL: parse() accepts a nullptr callback\n");
+        errors++;
+    }
+
+    std::printf("%6s %14s %14s %14s %14s\n", "rops", "fp ns/frame", "tmpl ns/frame", "fp ns/rop", "tmpl ns/rop");
+    for(uint16_t n : {1, 10, 25, 50, 100})
+    {
+        if(false == build(frame, n))
+        {
+            std::printf("FAIL: cannot build a ropframe w/ %u rops\n", n);
+            errors++;
+            break;
+        }
+        parser.load({frame.data(), frame.size()});
+        Work fp = once(parser, false);
+        Work tmpl = once(parser, true);
+        if((n != fp.rops) || (n != tmpl.rops) || (fp.sum != tmpl.sum))
+        {
+            std::printf("FAIL: the two overloads process different rops w/ %u rops\n", n);
+            errors++;
+        }
+        double fpns = run(parser, false, ms);
+        double tmplns = run(parser, true, ms);
+        std::printf("%6u %14.1f %14.1f %14.2f %14.2f\n", n, fpns, tmplns, fpns/n, tmplns/n);
+    }
+
+    std::printf("%s\n", (0 == errors) ? "OK" : "FAIL");
+    return (0 == errors) ? 0 : 1;
+}
+
+
+// - end-of-file (leave a blank line after)----------------------------------------------------------------------------
+
@@ -30,12 +30,89 @@
 // - external dependencies
 // --------------------------------------------------------------------------------------------------------------------
 
+#include <atomic>
+#include <algorithm>
+
 
 
 // --------------------------------------------------------------------------------------------------------------------
 // - pimpl: private implementation (see scott meyers: item 22 of effective modern c++, item 31 of effective c++
 // --------------------------------------------------------------------------------------------------------------------
 
+namespace embot { namespace tools {
+    
+    // it maps a value into a bin in [0, nsteps+1]: bin 0 is below, bin nsteps+1 is beyond, bin i+1 is inside[i]
+    struct Bins
+    {
+        std::uint64_t min {0};
+        std::uint64_t max {0};
+        std::uint32_t step {1};
+        std::uint32_t beyond {1};
+        std::uint8_t shift {0};
+        bool usesshift {false};
+        
+        static constexpr std::size_t chunk {64};
+        
+        void load(const Histogram::Config &config)
+        {
+            min = config.min;
+            max = config.max;
+            step = config.step;
+            beyond = config.nsteps() + 1;
+            usesshift = (0 == (step & (step - 1)));
+            shift = 0;
+            for(std::uint32_t s = step; s > 1; s >>= 1)
+            {
+                shift++;
+            }
+        }
+        
+        std::uint32_t bin(std::uint64_t val) const
+        {
+            if(val < min)
+            {
+                return 0;
+            }
+            if(val >= max)
+            {
+                return beyond;
+            }
+            return 1 + static_cast<std::uint32_t>(usesshift ? ((val - min) >> shift) : ((val - min) / step));
+        }
+        
+        // number must be <= chunk. the loops have no branches, so that they can be vectorised
+        void bins(const std::uint64_t *values, std::size_t number, std::uint32_t *out) const
+        {
+            if(true == usesshift)
+            {
+                for(std::size_t i=0; i<number; i++)
+                {
+                    const std::uint64_t v = values[i];
+                    std::uint64_t b = ((v - min) >> shift) + 1;
+                    b = (v < min) ? 0 : b;
+                    b = (v >= max) ? beyond : b;
+                    out[i] = static_cast<std::uint32_t>(b);
+                }
+            }
+            else
+            {
+                for(std::size_t i=0; i<number; i++)
+                {
+                    const std::uint64_t v = values[i];
+                    std::uint64_t b = ((v - min) / step) + 1;
+                    b = (v < min) ? 0 : b;
+                    b = (v >= max) ? beyond : b;
+                    out[i] = static_cast<std::uint32_t>(b);
+                }                
+            }
+        }
+    };
+    
+    constexpr std::size_t Bins::chunk;
+    
+} } // namespace embot { namespace tools {
+
+
 struct embot::tools::Histogram::Impl
 {  
 
@@ -48,6 +125,7 @@ struct embot::tools::Histogram::Impl
     }; 
     
     Status status;    
+    Bins bins;
 
     Impl() 
     { 
@@ -64,6 +142,7 @@ struct embot::tools::Histogram::Impl
         status.config = config;
         
         status.numofbins = status.config.nsteps();    
+        bins.load(status.config);
         
         status.values.inside.reserve(status.config.nsteps());                
         status.values.inside.resize(status.config.nsteps(), 0); 
@@ -89,7 +168,8 @@ struct embot::tools::Histogram::Impl
         }
         else if(val < status.config.max)
         {
-            std::uint64_t index = (val - status.config.min) / status.config.step;
+            const std::uint64_t offset = val - status.config.min;
+            std::uint64_t index = (true == bins.usesshift) ? (offset >> bins.shift) : (offset / status.config.step);
             if(index < status.numofbins)
             {
                 status.values.inside[index] ++;
@@ -109,6 +189,76 @@ struct embot::tools::Histogram::Impl
         return true;
     }
     
+    void increment(std::uint32_t bin, std::uint64_t occurrences)
+    {
+        if(0 == bin)
+        {
+            status.values.below += occurrences;
+        }
+        else if(bin > status.numofbins)
+        {
+            status.values.beyond += occurrences;
+        }
+        else
+        {
+            status.values.inside[bin-1] += occurrences;
+        }
+        status.values.total += occurrences;
+    }
+    
+    bool add(const std::uint64_t *values, std::size_t number)
+    {
+        if((false == status.config.isvalid()) || ((nullptr == values) && (number > 0)))
+        {  
+            return false;
+        }
+        
+        // the occurrences are also incremented w/out branches: an out of range bin is clamped into inside[] but adds zero
+        std::uint64_t *inside = status.values.inside.data();
+        const std::uint32_t beyond = status.numofbins + 1;
+        std::uint64_t below = 0;
+        std::uint64_t above = 0;
+        std::uint32_t bb[Bins::chunk];
+        for(std::size_t done=0; done<number; done+=Bins::chunk)
+        {
+            const std::size_t n = std::min(Bins::chunk, number-done);
+            bins.bins(&values[done], n, bb);
+            for(std::size_t i=0; i<n; i++)
+            {
+                const std::uint32_t b = bb[i];
+                const bool isbelow = (0 == b);
+                const bool isbeyond = (beyond == b);
+                below += isbelow;
+                above += isbeyond;
+                inside[std::min(std::max(b, 1u), status.numofbins) - 1] += !(isbelow || isbeyond);
+            }
+        }
+        
+        status.values.below += below;
+        status.values.beyond += above;
+        status.values.total += number;
+        
+        return true;
+    }
+    
+    bool merge(const Impl &other)
+    {
+        if((false == status.config.isvalid()) || (false == (status.config == other.status.config)))
+        {
+            return false;
+        }
+        
+        for(std::uint32_t i=0; i<status.numofbins; i++)
+        {
+            status.values.inside[i] += other.status.values.inside[i];
+        }
+        status.values.below += other.status.values.below;
+        status.values.beyond += other.status.values.beyond;
+        status.values.total += other.status.values.total;
+        
+        return true;
+    }
+    
     
     bool reset()
     {
@@ -123,6 +273,315 @@ struct embot::tools::Histogram::Impl
 
 
 
+struct embot::tools::HistogramShards::Impl
+{ 
+    struct Shard
+    {   // the bins are in the same order as in Bins. each Shard has its own allocation so that shards do not share cache lines
+        std::atomic<std::uint64_t> *occurrences {nullptr};
+        std::uint32_t number {0};
+        
+        void init(std::uint32_t n)
+        {
+            delete[] occurrences;
+            number = n;
+            occurrences = new std::atomic<std::uint64_t>[number];
+            clear();
+        }
+        
+        void clear()
+        {
+            for(std::uint32_t i=0; i<number; i++)
+            {
+                occurrences[i].store(0, std::memory_order_relaxed);
+            }
+        }
+        
+        // only the owner writes, so a relaxed load + store is enough and a reader never sees a torn value
+        void increment(std::uint32_t bin)
+        {
+            std::atomic<std::uint64_t> &o = occurrences[bin];
+            o.store(o.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+        
+        ~Shard() { delete[] occurrences; }
+    };
+    
+    Histogram::Config config {};
+    Bins bins {};
+    Shard *shards {nullptr};
+    std::uint8_t numberofshards {0};
+    
+    Impl() = default;
+    
+    ~Impl()
+    {
+        delete[] shards;
+    }
+    
+    bool init(const Histogram::Config &cfg, std::uint8_t n)
+    {
+        if((false == cfg.isvalid()) || (0 == n))
+        {
+            return false;
+        }
+        
+        config = cfg;
+        bins.load(config);
+        
+        delete[] shards;
+        numberofshards = n;
+        shards = new Shard[numberofshards];
+        for(std::uint8_t s=0; s<numberofshards; s++)
+        {
+            shards[s].init(config.nsteps() + 2);
+        }
+        
+        return true;
+    }
+    
+    bool add(std::uint8_t shard, std::uint64_t value)
+    {
+        if(shard >= numberofshards)
+        {
+            return false;
+        }
+        
+        shards[shard].increment(bins.bin(value));
+        return true;
+    }
+    
+    bool add(std::uint8_t shard, const std::uint64_t *values, std::size_t number)
+    {
+        if((shard >= numberofshards) || ((nullptr == values) && (number > 0)))
+        {
+            return false;
+        }
+        
+        Shard &sh = shards[shard];
+        std::uint32_t bb[Bins::chunk];
+        for(std::size_t done=0; done<number; done+=Bins::chunk)
+        {
+            const std::size_t n = std::min(Bins::chunk, number-done);
+            bins.bins(&values[done], n, bb);
+            for(std::size_t i=0; i<n; i++)
+            {
+                sh.increment(bb[i]);
+            }
+        }
+        
+        return true;
+    }
+    
+    bool merge(Histogram::Impl &histo) const
+    {
+        if((0 == numberofshards) || (false == (config == histo.status.config)))
+        {
+            return false;
+        }
+        
+        for(std::uint8_t s=0; s<numberofshards; s++)
+        {
+            const Shard &sh = shards[s];
+            for(std::uint32_t b=0; b<sh.number; b++)
+            {
+                const std::uint64_t o = sh.occurrences[b].load(std::memory_order_relaxed);
+                if(0 != o)
+                {
+                    histo.increment(b, o);
+                }
+            }
+        }
+        
+        return true;
+    }
+    
+    bool reset()
+    {
+        for(std::uint8_t s=0; s<numberofshards; s++)
+        {
+            shards[s].clear();
+        }
+        return true;
+    }
+};
+
+
+
+struct embot::tools::LogHistogram::Impl
+{
+    Config config {};
+    Values values {};
+    std::uint64_t *occurrences {nullptr};
+    std::uint32_t numberofbins {0};
+    std::uint32_t linear {0};       // 2^significantbits: the number of bins of width 1
+    std::uint32_t half {0};         // 2^(significantbits-1): the number of bins in each following power of two
+    
+    Impl() = default;
+    
+    ~Impl()
+    {
+        delete[] occurrences;
+    }
+    
+    static std::uint8_t msb(std::uint64_t v)
+    {   // v must be > 0
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::uint8_t>(63 - __builtin_clzll(v));
+#else
+        std::uint8_t r = 0;
+        for(std::uint8_t s=32; s>0; s>>=1)
+        {
+            if(v >= (static_cast<std::uint64_t>(1) << s))
+            {
+                v >>= s;
+                r += s;
+            }
+        }
+        return r;
+#endif
+    }
+    
+    std::uint32_t index(std::uint64_t v) const
+    {
+        if(v < linear)
+        {
+            return static_cast<std::uint32_t>(v);
+        }
+        const std::uint8_t shift = msb(v) - config.significantbits + 1;
+        return linear + (shift-1)*half + static_cast<std::uint32_t>((v >> shift) - half);
+    }
+    
+    void edges(std::uint32_t i, std::uint64_t &lowest, std::uint64_t &highest) const
+    {
+        if(i < linear)
+        {
+            lowest = highest = i;
+            return;
+        }
+        const std::uint32_t j = i - linear;
+        const std::uint8_t shift = static_cast<std::uint8_t>(j / half + 1);
+        lowest = static_cast<std::uint64_t>(j % half + half) << shift;
+        highest = lowest + (static_cast<std::uint64_t>(1) << shift) - 1;
+    }
+    
+    bool init(const Config &cfg)
+    {
+        if(false == cfg.isvalid())
+        {
+            return false;
+        }
+        
+        config = cfg;
+        linear = 1u << config.significantbits;
+        half = linear >> 1;
+        numberofbins = index(config.highest) + 1;
+        
+        delete[] occurrences;
+        occurrences = new std::uint64_t[numberofbins];
+        
+        return reset();
+    }
+    
+    bool add(std::uint64_t v)
+    {
+        if(nullptr == occurrences)
+        {   // not yet initted
+            return false;
+        }
+        
+        if(v > config.highest)
+        {
+            values.beyond++;
+            occurrences[numberofbins-1]++;
+        }
+        else
+        {
+            occurrences[index(v)]++;
+        }
+        
+        if((0 == values.total) || (v < values.min))
+        {
+            values.min = v;
+        }
+        if(v > values.max)
+        {
+            values.max = v;
+        }
+        values.total++;
+        
+        return true;
+    }
+    
+    bool merge(const Impl &other)
+    {
+        if((nullptr == occurrences) || (false == (config == other.config)))
+        {
+            return false;
+        }
+        
+        if(0 == other.values.total)
+        {
+            return true;
+        }
+        
+        for(std::uint32_t i=0; i<numberofbins; i++)
+        {
+            occurrences[i] += other.occurrences[i];
+        }
+        
+        values.min = (0 == values.total) ? other.values.min : std::min(values.min, other.values.min);
+        values.max = std::max(values.max, other.values.max);
+        values.beyond += other.values.beyond;
+        values.total += other.values.total;
+        
+        return true;
+    }
+    
+    bool reset()
+    {
+        if(nullptr == occurrences)
+        {
+            return false;
+        }
+        std::fill(occurrences, occurrences+numberofbins, 0);
+        values = {};
+        return true;
+    }
+    
+    std::uint64_t percentile(double p) const
+    {
+        if((nullptr == occurrences) || (0 == values.total))
+        {
+            return 0;
+        }
+        
+        p = std::min(std::max(p, 0.0), 100.0);
+        std::uint64_t target = static_cast<std::uint64_t>(p * static_cast<double>(values.total) / 100.0 + 0.5);
+        target = std::max<std::uint64_t>(target, 1);
+        if(target >= values.total)
+        {
+            return values.max;
+        }
+        
+        std::uint64_t cumulative = 0;
+        for(std::uint32_t i=0; i<numberofbins; i++)
+        {
+            cumulative += occurrences[i];
+            if(cumulative >= target)
+            {
+                std::uint64_t lo = 0;
+                std::uint64_t hi = 0;
+                edges(i, lo, hi);
+                return std::max(std::min(hi, values.max), values.min);
+            }
+        }
+        
+        return values.max;
+    }
+};
+
+
+
 struct embot::tools::PeriodValidator::Impl
 { 
     embot::core::Time previous {0};
@@ -131,10 +590,12 @@ struct embot::tools::PeriodValidator::Impl
     bool enabledReport {false};
     bool enabledAlert {false};
     bool usehisto {false};
+    bool useloghisto {false};
     
     Config configuration {};
     
     embot::tools::Histogram histo {};
+    embot::tools::LogHistogram loghisto {};
 
 
     Impl() = default;
@@ -156,6 +617,11 @@ struct embot::tools::PeriodValidator::Impl
             usehisto = true;
             histo.init(configuration.histoconfig);
         }
+        else if(true == configuration.loghistoconfig.isvalid())
+        {
+            useloghisto = true;
+            loghisto.init(configuration.loghistoconfig);
+        }
 
         return true;        
     }
@@ -184,6 +650,10 @@ struct embot::tools::PeriodValidator::Impl
         {
             histo.add(delta);
         }
+        else if(true == useloghisto)
+        {
+            loghisto.add(delta);
+        }
         
         enabledAlert = false;
         enabledReport = false;
@@ -195,7 +665,7 @@ struct embot::tools::PeriodValidator::Impl
         }
                
 
-        if((true == usehisto) && ((currtime_usec - prevreport) > configuration.reportinterval))
+        if(((true == usehisto) || (true == useloghisto)) && ((currtime_usec - prevreport) > configuration.reportinterval))
         {
             prevreport = currtime_usec;
             enabledReport = (configuration.reportinterval > 0) ? true : false;            
@@ -215,6 +685,7 @@ struct embot::tools::PeriodValidator::Impl
         enabledAlert = false;  
     
         histo.reset(); 
+        loghisto.reset();
 
         return true;                
     }
@@ -272,6 +743,16 @@ bool embot::tools::Histogram::add(std::uint64_t value)
     return pImpl->add(value);
 }
 
+bool embot::tools::Histogram::add(const std::uint64_t *values, std::size_t number)
+{
+    return pImpl->add(values, number);
+}
+
+bool embot::tools::Histogram::merge(const Histogram &other)
+{
+    return pImpl->merge(*other.pImpl);
+}
+
 const embot::tools::Histogram::Config * embot::tools::Histogram::getconfig() const
 {
     return &pImpl->status.config;
@@ -391,6 +872,111 @@ bool embot::tools::Histogram::probabilitydensityfunction(std::vector<std::uint32
 }
 
 
+embot::tools::HistogramShards::HistogramShards() 
+: pImpl(new Impl)
+{   
+
+}
+
+embot::tools::HistogramShards::~HistogramShards()
+{   
+    delete pImpl;
+}
+
+bool embot::tools::HistogramShards::init(const Histogram::Config &config, std::uint8_t numberofshards) 
+{   
+    return pImpl->init(config, numberofshards);
+}
+
+std::uint8_t embot::tools::HistogramShards::numberofshards() const
+{
+    return pImpl->numberofshards;
+}
+
+bool embot::tools::HistogramShards::add(std::uint8_t shard, std::uint64_t value)
+{
+    return pImpl->add(shard, value);
+}
+
+bool embot::tools::HistogramShards::add(std::uint8_t shard, const std::uint64_t *values, std::size_t number)
+{
+    return pImpl->add(shard, values, number);
+}
+
+bool embot::tools::HistogramShards::merge(Histogram &histo) const
+{
+    return pImpl->merge(*histo.pImpl);
+}
+
+bool embot::tools::HistogramShards::reset()
+{
+    return pImpl->reset();
+}
+
+
+embot::tools::LogHistogram::LogHistogram() 
+: pImpl(new Impl)
+{   
+
+}
+
+embot::tools::LogHistogram::~LogHistogram()
+{   
+    delete pImpl;
+}
+
+bool embot::tools::LogHistogram::init(const Config &config) 
+{   
+    return pImpl->init(config);
+}
+
+bool embot::tools::LogHistogram::add(std::uint64_t value)
+{
+    return pImpl->add(value);
+}
+
+bool embot::tools::LogHistogram::merge(const LogHistogram &other)
+{
+    return pImpl->merge(*other.pImpl);
+}
+
+bool embot::tools::LogHistogram::reset()
+{
+    return pImpl->reset();
+}
+
+const embot::tools::LogHistogram::Config * embot::tools::LogHistogram::getconfig() const
+{
+    return &pImpl->config;
+}
+
+const embot::tools::LogHistogram::Values * embot::tools::LogHistogram::getvalues() const
+{
+    return &pImpl->values;
+}
+
+std::uint64_t embot::tools::LogHistogram::percentile(double p) const
+{
+    return pImpl->percentile(p);
+}
+
+std::uint32_t embot::tools::LogHistogram::numberofbins() const
+{
+    return pImpl->numberofbins;
+}
+
+bool embot::tools::LogHistogram::bin(std::uint32_t i, std::uint64_t &lowest, std::uint64_t &highest, std::uint64_t &occurrences) const
+{
+    if(i >= pImpl->numberofbins)
+    {
+        return false;
+    }
+    pImpl->edges(i, lowest, highest);
+    occurrences = pImpl->occurrences[i];
+    return true;
+}
+
+
 embot::tools::PeriodValidator::PeriodValidator() 
 : pImpl(new Impl)
 {   
@@ -437,6 +1023,11 @@ const embot::tools::Histogram * embot::tools::PeriodValidator::histogram() const
     return &pImpl->histo;
 }
 
+const embot::tools::LogHistogram * embot::tools::PeriodValidator::loghistogram() const
+{
+    return &pImpl->loghisto;
+}
+
 
 // - end-of-file (leave a blank line after)----------------------------------------------------------------------------
 
@@ -30,6 +30,7 @@
 // - we also don't use in here any embot::core funtions or types to guarantee maximum portability.
 
 #include <cstdint>
+#include <cstddef>
 #include <vector>
 #include "embot_core.h"
 
@@ -41,6 +42,7 @@ namespace embot { namespace tools {
         
         struct Config
         {   // there are nsteps() intervals each containing .step values which fill the range [.min, ... , .max)
+            // if .step is a power of two, the interval of a value is found with a shift rather than a division
             std::uint64_t min {0};        // the start value of first interval.
             std::uint64_t max {0};        // the upper limit of all possible values (which is actually max-1).
             std::uint32_t step {0};       // the width of the interval 
@@ -49,6 +51,7 @@ namespace embot { namespace tools {
             std::uint64_t range() const { return max - min; }
             std::uint32_t nsteps() const { return ( (range() + step - 1) / step); }
             bool isvalid() const { return ((0 == step) || (min >= max)) ? false : true; }
+            bool operator==(const Config &other) const { return (min == other.min) && (max == other.max) && (step == other.step); }
         };
         
         struct Values
@@ -67,6 +70,13 @@ namespace embot { namespace tools {
         
         bool add(std::uint64_t value);
         
+        // it adds number values in one go. the intervals are computed for a chunk of values in a loop w/out branches 
+        // which the compiler can vectorise, and only then the occurrences are incremented. 
+        bool add(const std::uint64_t *values, std::size_t number);
+        
+        // it adds the occurrences of other, which must have been initted with the same Config.
+        bool merge(const Histogram &other);
+        
         bool reset();  
         
         const embot::tools::Histogram::Config * getconfig() const;
@@ -79,11 +89,98 @@ namespace embot { namespace tools {
         bool probabilitydensityfunction(std::vector<std::uint32_t> &values, const std::uint32_t scale) const;
         bool probabilitydensityfunction(std::vector<double> &values) const;
         
-    private:        
+    private:  
+        friend class HistogramShards;      
         struct Impl;
         Impl *pImpl;    
     };    
     
+    
+    // it is a Histogram split in shards, one for each thread which adds values. the owner of a shard is the only writer 
+    // of its occurrences, so add() does not need any lock nor any atomic read-modify-write. the occurrences of all the 
+    // shards are summed by merge() which can be called by any other thread while the owners keep on adding.
+    class HistogramShards
+    {
+    public:
+    
+        HistogramShards();
+        ~HistogramShards();
+        
+        bool init(const Histogram::Config &config, std::uint8_t numberofshards);
+        
+        std::uint8_t numberofshards() const;
+        
+        // they must be called only by the thread which owns shard
+        bool add(std::uint8_t shard, std::uint64_t value);
+        bool add(std::uint8_t shard, const std::uint64_t *values, std::size_t number);
+        
+        // it adds the occurrences of all the shards into histo, which must have been initted with the same Config.
+        bool merge(Histogram &histo) const;
+        
+        // it must not be called while the shards are in use.
+        bool reset();
+        
+    private:        
+        struct Impl;
+        Impl *pImpl;    
+    };
+    
+    
+    // it is a log-linear histogram (as in HDR histograms) which covers a wide range of values with a bounded relative error
+    // and a fixed memory footprint. the values in [0, 2^significantbits) have a bin each. above that, every power of two is
+    // split in 2^(significantbits-1) bins of equal width, so that a value is represented with a relative error of at most 
+    // 2^(1-significantbits). add() is O(1) and does not allocate. 
+    class LogHistogram
+    {
+    public:
+        
+        struct Config
+        {   
+            std::uint64_t highest {0};          // the highest value tracked w/ bounded error. the bigger values are counted in the last bin and in Values::beyond
+            std::uint8_t significantbits {0};   // in [2, 16]. e.g., 7 gives a relative error <= 1.6% and 64 bins for each power of two
+            Config() = default;
+            Config(std::uint64_t hi, std::uint8_t sb) : highest(hi), significantbits(sb) {}
+            bool isvalid() const { return ((significantbits < 2) || (significantbits > 16) || (highest < (1u << significantbits))) ? false : true; }
+            bool operator==(const Config &other) const { return (highest == other.highest) && (significantbits == other.significantbits); }
+        };
+        
+        struct Values
+        {
+            std::uint64_t total {0};            // number of added values
+            std::uint64_t beyond {0};           // number of added values > config.highest
+            std::uint64_t min {0};              // the exact minimum of the added values
+            std::uint64_t max {0};              // the exact maximum of the added values
+        };
+        
+        LogHistogram();
+        ~LogHistogram();
+        
+        bool init(const Config &config);
+        
+        bool add(std::uint64_t value);
+        
+        // it adds the occurrences of other, which must have been initted with the same Config.
+        bool merge(const LogHistogram &other);
+        
+        bool reset();
+        
+        const embot::tools::LogHistogram::Config * getconfig() const;
+        const embot::tools::LogHistogram::Values * getvalues() const;
+        
+        // it returns the highest value which is equivalent (within the relative error) to the value below which lies 
+        // the percentage p of the added values. p is in [0.0, 100.0], so p = 50.0 is the median. it returns 0 if empty.
+        // p = 100.0 returns Values::max
+        std::uint64_t percentile(double p) const;
+        
+        // the bins, to be used to print or plot the distribution
+        std::uint32_t numberofbins() const;
+        bool bin(std::uint32_t i, std::uint64_t &lowest, std::uint64_t &highest, std::uint64_t &occurrences) const;
+        
+    private:        
+        struct Impl;
+        Impl *pImpl;    
+    };
+    
 } } // namespace embot { namespace tools {
 
 
@@ -102,9 +199,12 @@ namespace embot { namespace tools {
             embot::core::Time                   alertvalue {0};                 // it is the value beyond which we produce an alert string. it must be > period.  
             embot::core::Time                   reportinterval {0};             // if not zero, it keeps the value in usec between two reports
             embot::tools::Histogram::Config     histoconfig {};                 // if is valid(), then we produce an histogram  
+            embot::tools::LogHistogram::Config  loghistoconfig {};              // if is valid() and histoconfig is not, then we produce a log-linear histogram
             Config() = default;
             Config(embot::core::Time pe, embot::core::Time al, embot::core::Time ri, const embot::tools::Histogram::Config &hi) 
                 : period(pe), alertvalue(al), reportinterval(ri), histoconfig(hi) {}
+            Config(embot::core::Time pe, embot::core::Time al, embot::core::Time ri, const embot::tools::LogHistogram::Config &lo) 
+                : period(pe), alertvalue(al), reportinterval(ri), loghistoconfig(lo) {}
             bool isvalid() const { return ((0 == period) || (period >= alertvalue)) ? false : true; }
         };
         
@@ -129,6 +229,7 @@ namespace embot { namespace tools {
         bool alert(embot::core::Time &deltatime) const;
         
         const embot::tools::Histogram * histogram() const;
+        const embot::tools::LogHistogram * loghistogram() const;
                
     private:        
         struct Impl;
@@ -25,6 +25,8 @@
 #include "string.h"
 #include "EOtheMemoryPool.h"
 #include "EOtheErrorManager.h"
+#include "EOVtheSystem.h"
+#include "stdio.h"
 
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -63,7 +65,13 @@
 // --------------------------------------------------------------------------------------------------------------------
 // - declaration of static functions
 // --------------------------------------------------------------------------------------------------------------------
-// empty-section
+
+#if defined(EOVMUTEX_PROFILER)
+static eOnanotime_t s_eov_mutex_profiler_now(void);
+static uint8_t s_eov_mutex_profiler_bin(eOnanotime_t nanosec);
+static void s_eov_mutex_profiler_taken(EOVmutex *mutex, eOnanotime_t waited, eObool_t contended);
+static void s_eov_mutex_profiler_released(EOVmutex *mutex);
+#endif
 
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -72,6 +80,12 @@
 
 static const char s_eobj_ownname[] = "EOVmutex";
 
+#if defined(EOVMUTEX_PROFILER)
+// the mutexes are recorded at creation. creation and deletion of mutexes are not expected to run concurrently
+static EOVmutex * s_eov_mutex_profiler_mutexes[EOVMUTEX_PROFILER_CAPACITY] = {NULL};
+static uint16_t s_eov_mutex_profiler_numberof = 0;
+#endif
+
 
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -101,6 +115,31 @@ extern eOresult_t eov_mutex_Take(EOVmutexDerived *d, eOreltime_t tout)
 //		return(eores_NOK_nullpointer);     
 //	}
 
+#if defined(EOVMUTEX_PROFILER)
+    if(EOVMUTEX_PROFILER_CAPACITY != mutex->index)
+    {   // we try w/out waiting first, so that we know if the mutex is contended. the wait is measured around both 
+        // attempts, because a derived mutex which ignores the timeout blocks already inside the first one
+        eOnanotime_t start = s_eov_mutex_profiler_now();
+        eOresult_t res = fptr(d, eok_reltimeZERO);
+        eObool_t contended = eobool_false;
+        if((eores_OK != res) && (eok_reltimeZERO != tout))
+        {
+            contended = eobool_true;
+            res = fptr(d, tout);
+        }
+        if(eores_OK == res)
+        {
+            eOnanotime_t waited = s_eov_mutex_profiler_now() - start;
+            if(waited > EOVMUTEX_PROFILER_CONTENDEDNANOSEC)
+            {
+                contended = eobool_true;
+            }
+            s_eov_mutex_profiler_taken(mutex, waited, contended);
+        }
+        return(res);
+    }
+#endif
+
     // call funtion of derived object. it cant be NULL
     return(fptr(d, tout));
 }
@@ -126,6 +165,11 @@ extern eOresult_t eov_mutex_Release(EOVmutexDerived *d)
 //		return(eores_NOK_nullpointer);     
 //	}
 
+#if defined(EOVMUTEX_PROFILER)
+    // we are still holding the mutex, so we can write its profile
+    s_eov_mutex_profiler_released(mutex);
+#endif
+
     // call funtion of derived object. it cant be NULL
     return(fptr(d));
 	
@@ -157,6 +201,167 @@ extern void eov_mutex_Delete(EOVmutexDerived *d)
 }
 
 
+extern eOresult_t eov_mutex_SetName(EOVmutexDerived *d, const char *name)
+{
+    EOVmutex *mutex = (EOVmutex*) eo_common_getbaseobject(d);
+    
+    if(NULL == mutex) 
+    {
+        return(eores_NOK_nullpointer); 
+    }
+    
+#if defined(EOVMUTEX_PROFILER)    
+    if(EOVMUTEX_PROFILER_CAPACITY == mutex->index)
+    {
+        uint16_t i = 0;
+        for(i=0; i<EOVMUTEX_PROFILER_CAPACITY; i++)
+        {
+            if(NULL == s_eov_mutex_profiler_mutexes[i])
+            {
+                break;
+            }
+        }
+        if(EOVMUTEX_PROFILER_CAPACITY == i)
+        {
+            return(eores_NOK_busy);
+        }
+        s_eov_mutex_profiler_mutexes[i] = mutex;
+        s_eov_mutex_profiler_numberof++;
+        mutex->index = i;
+        mutex->derived = d;
+    }
+    mutex->profile.name = name;
+    return(eores_OK);
+#else
+    (void)name;
+    return(eores_NOK_unsupported);
+#endif
+}
+
+
+extern uint16_t eov_mutex_Profiler_NumberOf(void)
+{
+#if defined(EOVMUTEX_PROFILER) 
+    return(s_eov_mutex_profiler_numberof);
+#else
+    return(0);
+#endif
+}
+
+
+extern eOresult_t eov_mutex_Profiler_Get(uint16_t i, eOvmutex_profile_t *profile)
+{
+    if(NULL == profile)
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+#if defined(EOVMUTEX_PROFILER)
+    {
+        uint16_t n = 0;
+        uint16_t j = 0;
+        EOVmutex *mutex = NULL;
+        // the i-th recorded mutex is the i-th non NULL slot
+        for(j=0; j<EOVMUTEX_PROFILER_CAPACITY; j++)
+        {
+            if(NULL != s_eov_mutex_profiler_mutexes[j])
+            {
+                if(n == i)
+                {
+                    mutex = s_eov_mutex_profiler_mutexes[j];
+                    break;
+                }
+                n++;
+            }
+        }
+        
+        if(NULL == mutex)
+        {
+            return(eores_NOK_generic);
+        }
+        
+        // we call the derived object directly, else the copy itself would be recorded
+        if(eores_OK != ((eOres_fp_voidp_uint32_t)mutex->vtable[VF00_take])(mutex->derived, eok_reltimeINFINITE))
+        {
+            return(eores_NOK_timeout);
+        }
+        memcpy(profile, &mutex->profile, sizeof(eOvmutex_profile_t));
+        ((eOres_fp_voidp_t)mutex->vtable[VF01_release])(mutex->derived);
+        
+        return(eores_OK);
+    }
+#else
+    (void)i;
+    return(eores_NOK_unsupported);
+#endif
+}
+
+
+extern void eov_mutex_Profiler_Reset(void)
+{
+#if defined(EOVMUTEX_PROFILER)
+    uint16_t i = 0;
+    for(i=0; i<EOVMUTEX_PROFILER_CAPACITY; i++)
+    {
+        EOVmutex *mutex = s_eov_mutex_profiler_mutexes[i];
+        if(NULL != mutex)
+        {
+            const char *name = mutex->profile.name;
+            ((eOres_fp_voidp_uint32_t)mutex->vtable[VF00_take])(mutex->derived, eok_reltimeINFINITE);
+            memset(&mutex->profile, 0, sizeof(eOvmutex_profile_t));
+            mutex->profile.name = name;
+            ((eOres_fp_voidp_t)mutex->vtable[VF01_release])(mutex->derived);
+        }
+    }
+#endif
+}
+
+
+extern uint32_t eov_mutex_Profiler_Dump(char *str, uint32_t size)
+{
+    uint32_t written = 0;
+    
+    if((NULL == str) || (0 == size))
+    {
+        return(0);
+    }
+    
+    str[0] = 0;
+    
+#if defined(EOVMUTEX_PROFILER)
+    {
+        uint16_t i = 0;
+        uint16_t n = eov_mutex_Profiler_NumberOf();
+        eOvmutex_profile_t prof = {0};
+        int r = snprintf(str, size, "%-28s %12s %10s %10s %10s %10s %10s\n", "mutex", "takes", "contended", "avgwait", "maxwait", "avghold", "maxhold");
+        written = (r > 0) ? (uint32_t)r : 0;
+        for(i=0; (i<n) && (written < size); i++)
+        {
+            if(eores_OK != eov_mutex_Profiler_Get(i, &prof))
+            {
+                continue;
+            }
+            // the times are in micro-seconds
+            r = snprintf(&str[written], size - written, "%-28s %12llu %10llu %10llu %10llu %10llu %10llu\n", 
+                         (NULL == prof.name) ? "?" : prof.name, 
+                         (unsigned long long)prof.takes, 
+                         (unsigned long long)prof.contended,
+                         (unsigned long long)((0 == prof.contended) ? 0 : (prof.waitnanosec / prof.contended / 1000)),
+                         (unsigned long long)(prof.waitmaxnanosec / 1000),
+                         (unsigned long long)((0 == prof.takes) ? 0 : (prof.holdnanosec / prof.takes / 1000)),
+                         (unsigned long long)(prof.holdmaxnanosec / 1000));
+            written += (r > 0) ? (uint32_t)r : 0;
+        }
+        if(written >= size)
+        {   // truncated
+            written = size - 1;
+        }
+    }
+#endif
+    
+    return(written);
+}
+
 
 // --------------------------------------------------------------------------------------------------------------------
 // - definition of extern hidden functions 
@@ -177,6 +382,13 @@ extern EOVmutex* eov_mutex_hid_New(void)
     retptr->vtable[VF01_release]        = NULL;
     retptr->vtable[VF02_delete]         = NULL;
     // other stuff
+#if defined(EOVMUTEX_PROFILER)
+    memset(&retptr->profile, 0, sizeof(eOvmutex_profile_t));
+    retptr->derived = NULL;
+    retptr->takenat = 0;
+    retptr->depth = 0;
+    retptr->index = EOVMUTEX_PROFILER_CAPACITY;
+#endif
 
 
 	return(retptr);	
@@ -189,6 +401,14 @@ extern void eov_mutex_hid_Delete(EOVmutex *p)
     {
         return;
     }
+    
+#if defined(EOVMUTEX_PROFILER)
+    if(EOVMUTEX_PROFILER_CAPACITY != p->index)
+    {
+        s_eov_mutex_profiler_mutexes[p->index] = NULL;
+        s_eov_mutex_profiler_numberof--;
+    }
+#endif
 
     memset(p, 0, sizeof(EOVmutex));
     
@@ -214,7 +434,78 @@ extern eOresult_t eov_mutex_hid_SetVTABLE(EOVmutex *p, eOres_fp_voidp_uint32_t v
 // --------------------------------------------------------------------------------------------------------------------
 // - definition of static functions 
 // --------------------------------------------------------------------------------------------------------------------
-// empty section
+
+#if defined(EOVMUTEX_PROFILER)
+
+static eOnanotime_t s_eov_mutex_profiler_now(void)
+{
+    eOnanotime_t t = 0;
+    eov_sys_NanoTimeGet(eov_sys_GetHandle(), &t);
+    return(t);
+}
+
+
+static uint8_t s_eov_mutex_profiler_bin(eOnanotime_t nanosec)
+{
+    uint8_t bin = 0;
+    uint64_t usec = nanosec / 1000;
+    while((0 != usec) && (bin < (EOVMUTEX_PROFILER_BINS-1)))
+    {
+        usec >>= 1;
+        bin++;
+    }
+    return(bin);
+}
+
+
+static void s_eov_mutex_profiler_taken(EOVmutex *mutex, eOnanotime_t waited, eObool_t contended)
+{
+    if(0 != mutex->depth++)
+    {   // a recursive take: it does not start a new hold
+        mutex->profile.takes++;
+        return;
+    }
+    
+    mutex->profile.takes++;
+    if(eobool_true == contended)
+    {
+        mutex->profile.contended++;
+        mutex->profile.waitnanosec += waited;
+        if(waited > mutex->profile.waitmaxnanosec)
+        {
+            mutex->profile.waitmaxnanosec = waited;
+        }
+        mutex->profile.waithistogram[s_eov_mutex_profiler_bin(waited)]++;
+    }
+    
+    mutex->takenat = s_eov_mutex_profiler_now();
+}
+
+
+static void s_eov_mutex_profiler_released(EOVmutex *mutex)
+{
+    eOnanotime_t held = 0;
+    
+    if(0 == mutex->depth)
+    {   // not taken through eov_mutex_Take() after it was recorded
+        return;
+    }
+    
+    if(0 != --mutex->depth)
+    {
+        return;
+    }
+    
+    held = s_eov_mutex_profiler_now() - mutex->takenat;
+    mutex->profile.holdnanosec += held;
+    if(held > mutex->profile.holdmaxnanosec)
+    {
+        mutex->profile.holdmaxnanosec = held;
+    }
+    mutex->profile.holdhistogram[s_eov_mutex_profiler_bin(held)]++;
+}
+
+#endif // EOVMUTEX_PROFILER
 
 
 
@@ -51,7 +51,21 @@ extern "C" {
 
 
 // - public #define  --------------------------------------------------------------------------------------------------
-// empty-section
+
+/** @def        EOVMUTEX_PROFILER_BINS
+    @brief      number of bins of the wait and hold histograms of the lock-contention profiler. bin i counts the durations 
+                in [2^(i-1), 2^i) micro-seconds, bin 0 those below 1 micro-second and the last one all the longer durations.
+ **/
+#define EOVMUTEX_PROFILER_BINS      16
+
+/** @def        EOVMUTEX_PROFILER_CONTENDEDNANOSEC
+    @brief      a take which waits longer than this is counted as contended even if it succeeded at first attempt. 
+                some derived mutexes ignore the timeout (e.g., the ace mutex used by the EOYmutex with the user backend), 
+                so their attempt without waiting blocks until the mutex is free and succeeds.
+ **/
+#if !defined(EOVMUTEX_PROFILER_CONTENDEDNANOSEC)
+    #define EOVMUTEX_PROFILER_CONTENDEDNANOSEC     2000
+#endif
   
 
 // - declaration of public user-defined types ------------------------------------------------------------------------- 
@@ -80,6 +94,23 @@ typedef EOVmutexDerived* (*eov_mutex_fn_mutexderived_new)(void);
     @brief      eov_mutexderived_fn_delete is used to represent a pointer to a function which deallocates a derived mutex.
  **/
 typedef void (*eov_mutex_fn_mutexderived_delete)(EOVmutexDerived* m);
+
+
+/** @typedef    typedef struct eOvmutex_profile_t
+    @brief      eOvmutex_profile_t contains what the lock-contention profiler has recorded about a mutex. 
+ **/
+typedef struct
+{
+    const char      *name;                                  /**< the name given with eov_mutex_SetName(), or NULL */
+    uint64_t        takes;                                  /**< number of successful takes */
+    uint64_t        contended;                              /**< number of takes which did not succeed at first attempt or waited longer than EOVMUTEX_PROFILER_CONTENDEDNANOSEC */
+    uint64_t        waitnanosec;                            /**< total time spent waiting for the mutex */
+    uint64_t        waitmaxnanosec;                         /**< longest wait */
+    uint64_t        holdnanosec;                            /**< total time the mutex was held */
+    uint64_t        holdmaxnanosec;                         /**< longest hold */
+    uint32_t        waithistogram[EOVMUTEX_PROFILER_BINS];  /**< histogram of the waits of the contended takes */
+    uint32_t        holdhistogram[EOVMUTEX_PROFILER_BINS];  /**< histogram of the holds */
+} eOvmutex_profile_t;
     
 // - declaration of extern public variables, ... but better using use _get/_set instead -------------------------------
 // empty-section
@@ -120,6 +151,53 @@ extern eOpurevirtual eOresult_t eov_mutex_Release(EOVmutexDerived *d);
 extern eOpurevirtual void eov_mutex_Delete(EOVmutexDerived *d);
 
 
+/** @fn         extern eOresult_t eov_mutex_SetName(EOVmutexDerived *d, const char *name)
+    @brief      Gives a name to the mutex and records it in the lock-contention profiler, which from then on measures
+                its takes and releases done with eov_mutex_Take() and eov_mutex_Release(). The profiler is compiled in 
+                only if the library is built with the macro EOVMUTEX_PROFILER defined, otherwise the mutexes are not 
+                instrumented at all. It must not be called while the mutex is taken.
+    @param      d               Pointer to the mutex-derived object
+    @param      name            A string which must stay valid for the life of the mutex
+    @return     eores_OK in case of success, eores_NOK_busy if the profiler already records EOVMUTEX_PROFILER_CAPACITY 
+                mutexes, eores_NOK_unsupported if the profiler is not compiled in, or eores_NOK_nullpointer if d is NULL.
+ **/
+extern eOresult_t eov_mutex_SetName(EOVmutexDerived *d, const char *name);
+
+
+/** @fn         extern uint16_t eov_mutex_Profiler_NumberOf(void)
+    @brief      Tells how many mutexes are recorded by the lock-contention profiler.
+    @return     the number of mutexes, 0 if the profiler is not compiled in.
+ **/
+extern uint16_t eov_mutex_Profiler_NumberOf(void);
+
+
+/** @fn         extern eOresult_t eov_mutex_Profiler_Get(uint16_t i, eOvmutex_profile_t *profile)
+    @brief      Retrieves what the profiler has recorded for the i-th mutex. The mutex is taken while copying, so 
+                the values are coherent. 
+    @param      i               The index of the mutex in [0, eov_mutex_Profiler_NumberOf())
+    @param      profile         The recorded values
+    @return     eores_OK in case of success, eores_NOK_generic if i is out of range, eores_NOK_unsupported if 
+                the profiler is not compiled in, or eores_NOK_nullpointer if profile is NULL.
+ **/
+extern eOresult_t eov_mutex_Profiler_Get(uint16_t i, eOvmutex_profile_t *profile);
+
+
+/** @fn         extern void eov_mutex_Profiler_Reset(void)
+    @brief      Clears what the profiler has recorded for all the mutexes.
+ **/
+extern void eov_mutex_Profiler_Reset(void);
+
+
+/** @fn         extern uint32_t eov_mutex_Profiler_Dump(char *str, uint32_t size)
+    @brief      Writes in str one line for each recorded mutex with its name, takes, contended takes, average and max 
+                wait and hold times, sorted as they were created. 
+    @param      str             The destination string
+    @param      size            The size of str
+    @return     the number of written characters (w/out the terminator). 0 if the profiler is not compiled in.
+ **/
+extern uint32_t eov_mutex_Profiler_Dump(char *str, uint32_t size);
+
+
 
 /** @}            
     end of group eov_mutex  
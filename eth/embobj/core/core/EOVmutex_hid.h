@@ -47,6 +47,9 @@ extern "C" {
 #define VF02_delete                 2
 #define VTABLESIZE_mutex            3
 
+// the lock-contention profiler is compiled in only if EOVMUTEX_PROFILER is defined (e.g., w/ cmake option EMBOBJ_MUTEX_PROFILER)
+#define EOVMUTEX_PROFILER_CAPACITY  128
+
 
 // - definition of the hidden struct implementing the object ----------------------------------------------------------
 
@@ -63,7 +66,13 @@ struct EOVmutex_hid
     void * vtable[VTABLESIZE_mutex];
 
     // - other stuff
-    // empty-section
+#if defined(EOVMUTEX_PROFILER)
+    eOvmutex_profile_t          profile;        // written by the thread which holds the mutex
+    EOVmutexDerived             *derived;       // the object which contains this one, used to take the mutex when reading profile
+    eOnanotime_t                takenat;        // when the outermost take succeeded
+    uint32_t                    depth;          // number of nested takes of the holder
+    uint16_t                    index;          // position inside the profiler, EOVMUTEX_PROFILER_CAPACITY if not recorded
+#endif
 };
 
 
@@ -67,7 +67,14 @@
 // --------------------------------------------------------------------------------------------------------------------
 // - declaration of static functions
 // --------------------------------------------------------------------------------------------------------------------
-// empty-section
+
+#if defined(EOFIFO_SPSC_LOCKFREE)
+static eOsizecntnr_t s_eo_fifo_spsc_size(EOfifo *fifo);
+static eOresult_t s_eo_fifo_spsc_put(EOfifo *fifo, void *pitem);
+static eOresult_t s_eo_fifo_spsc_get(EOfifo *fifo, const void **ppitem);
+static eOresult_t s_eo_fifo_spsc_rem(EOfifo *fifo, void *pitem);
+static void s_eo_fifo_spsc_clear(EOfifo *fifo);
+#endif
 
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -86,6 +93,15 @@ extern EOfifo * eo_fifo_New(eOsizeitem_t item_size, eOsizecntnr_t capacity,
                             eOres_fp_voidp_uint32_t item_init, uint32_t init_arg, 
                             eOres_fp_voidp_voidp_t item_copy, eOres_fp_voidp_t item_clear,
                             EOVmutexDerived *mutex) 
+{
+    return(eo_fifo_NewWithAccess(item_size, capacity, item_init, init_arg, item_copy, item_clear, mutex, eo_fifo_access_mutex));
+}
+
+
+extern EOfifo * eo_fifo_NewWithAccess(eOsizeitem_t item_size, eOsizecntnr_t capacity,
+                                      eOres_fp_voidp_uint32_t item_init, uint32_t init_arg, 
+                                      eOres_fp_voidp_voidp_t item_copy, eOres_fp_voidp_t item_clear,
+                                      EOVmutexDerived *mutex, eOfifo_access_t access) 
 {
     EOfifo *retptr = NULL; 
     
@@ -100,6 +116,21 @@ extern EOfifo * eo_fifo_New(eOsizeitem_t item_size, eOsizecntnr_t capacity,
 
     // now i copy the passed mutex into mutexfifo. beware for future use, ... it may be NULL
     retptr->mutex = mutex;
+    
+    retptr->spsc = eobool_false;
+#if defined(EOFIFO_SPSC_LOCKFREE)
+    if(eo_fifo_access_spsc == access)
+    {
+        // the deque is used only as storage: its size, first and next stay untouched and the mutex is not needed
+        retptr->spsc = eobool_true;
+        retptr->mutex = NULL;
+    }
+    atomic_init(&retptr->head, 0);
+    atomic_init(&retptr->tail, 0);
+#else
+    retptr->head = 0;
+    retptr->tail = 0;
+#endif
  
     // ok, done
     return(retptr);
@@ -188,6 +219,14 @@ extern eOresult_t eo_fifo_Size(EOfifo *fifo, eOsizecntnr_t *size, eOreltime_t to
         return(eores_NOK_nullpointer);
     }
     
+#if defined(EOFIFO_SPSC_LOCKFREE)
+    if(eobool_true == fifo->spsc)
+    {
+        *size = s_eo_fifo_spsc_size(fifo);
+        return(eores_OK);
+    }
+#endif
+    
     if(NULL == fifo->mutex)    
     {
         // the fifo is not protected with a mutex, thus it is simple.
@@ -225,6 +264,13 @@ extern eOresult_t eo_fifo_Put(EOfifo *fifo, void *pitem, eOreltime_t tout)
         return(eores_NOK_nullpointer);
     }
     
+#if defined(EOFIFO_SPSC_LOCKFREE)
+    if(eobool_true == fifo->spsc)
+    {
+        return(s_eo_fifo_spsc_put(fifo, pitem));
+    }
+#endif
+    
     if(NULL == fifo->mutex)    
     {
         // the fifo is not protected with a mutex, thus it is simple.
@@ -282,6 +328,13 @@ extern eOresult_t eo_fifo_Get(EOfifo *fifo, const void **ppitem, eOreltime_t tou
         return(eores_NOK_nullpointer);
     }
     
+#if defined(EOFIFO_SPSC_LOCKFREE)
+    if(eobool_true == fifo->spsc)
+    {
+        return(s_eo_fifo_spsc_get(fifo, ppitem));
+    }
+#endif
+    
     if(NULL == fifo->mutex)    
     {
         // the fifo is not protected with a mutex, thus it is simple.
@@ -333,6 +386,13 @@ extern eOresult_t eo_fifo_Rem(EOfifo *fifo, eOreltime_t tout) {
         return(eores_NOK_nullpointer);
     }
     
+#if defined(EOFIFO_SPSC_LOCKFREE)
+    if(eobool_true == fifo->spsc)
+    {
+        return(s_eo_fifo_spsc_rem(fifo, NULL));
+    }
+#endif
+    
     if(NULL == fifo->mutex)    
     {
         // the fifo is not protected with a mutex, thus it is simple.
@@ -371,6 +431,13 @@ extern eOresult_t eo_fifo_GetRem(EOfifo *fifo, void *pitem, eOreltime_t tout)
         return(eores_NOK_nullpointer);
     }
     
+#if defined(EOFIFO_SPSC_LOCKFREE)
+    if(eobool_true == fifo->spsc)
+    {
+        return(s_eo_fifo_spsc_rem(fifo, pitem));
+    }
+#endif
+    
     if(NULL == fifo->mutex)    
     {
         // the fifo is not protected with a mutex, thus it is simple.
@@ -449,6 +516,14 @@ extern eOresult_t eo_fifo_Clear(EOfifo *fifo, eOreltime_t tout)
         return(eores_NOK_nullpointer);
     }
     
+#if defined(EOFIFO_SPSC_LOCKFREE)
+    if(eobool_true == fifo->spsc)
+    {
+        s_eo_fifo_spsc_clear(fifo);
+        return(eores_OK);
+    }
+#endif
+    
     if(NULL == fifo->mutex)    
     {
         // the fifo is not protected with a mutex, thus it is simple.
@@ -485,7 +560,136 @@ extern eOresult_t eo_fifo_Clear(EOfifo *fifo, eOreltime_t tout)
 // --------------------------------------------------------------------------------------------------------------------
 // - definition of static functions 
 // --------------------------------------------------------------------------------------------------------------------
-// empty-section
+
+#if defined(EOFIFO_SPSC_LOCKFREE)
+
+// head and tail run in [0, 2*capacity) so that a full fifo (tail - head = capacity) can be told apart from 
+// an empty one (tail = head) without wasting a slot. the producer owns tail, the consumer owns head: each side 
+// publishes its own index with release semantics and reads the other with acquire semantics.
+
+EO_static_inline uint32_t s_eo_fifo_spsc_count(EOfifo *fifo, uint32_t head, uint32_t tail)
+{
+    return((tail >= head) ? (tail - head) : (tail + 2*(uint32_t)fifo->dek->capacity - head));
+}
+
+EO_static_inline uint32_t s_eo_fifo_spsc_next(EOfifo *fifo, uint32_t index)
+{
+    index++;
+    return((index == 2*(uint32_t)fifo->dek->capacity) ? (0) : (index));
+}
+
+EO_static_inline uint8_t * s_eo_fifo_spsc_item(EOfifo *fifo, uint32_t index)
+{
+    if(index >= fifo->dek->capacity)
+    {
+        index -= fifo->dek->capacity;
+    }
+    return(&((uint8_t*)fifo->dek->stored_items)[index * fifo->dek->item_size]);
+}
+
+static eOsizecntnr_t s_eo_fifo_spsc_size(EOfifo *fifo)
+{
+    uint32_t head = atomic_load_explicit(&fifo->head, memory_order_acquire);
+    uint32_t tail = atomic_load_explicit(&fifo->tail, memory_order_acquire);
+    return((eOsizecntnr_t)s_eo_fifo_spsc_count(fifo, head, tail));
+}
+
+static eOresult_t s_eo_fifo_spsc_put(EOfifo *fifo, void *pitem)
+{
+    uint32_t tail = atomic_load_explicit(&fifo->tail, memory_order_relaxed);
+    uint32_t head = atomic_load_explicit(&fifo->head, memory_order_acquire);
+    uint8_t *item = NULL;
+    
+    if(NULL == pitem)
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    if(s_eo_fifo_spsc_count(fifo, head, tail) == fifo->dek->capacity)
+    {
+        // queue is full
+        return(eores_NOK_busy);
+    }
+    
+    item = s_eo_fifo_spsc_item(fifo, tail);
+    if(NULL != fifo->dek->item_copy_fn) 
+    {
+        fifo->dek->item_copy_fn(item, pitem);
+    }
+    else
+    {
+        memcpy(item, pitem, fifo->dek->item_size);
+    }
+    
+    atomic_store_explicit(&fifo->tail, s_eo_fifo_spsc_next(fifo, tail), memory_order_release);
+    return(eores_OK);
+}
+
+static eOresult_t s_eo_fifo_spsc_get(EOfifo *fifo, const void **ppitem)
+{
+    uint32_t head = atomic_load_explicit(&fifo->head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&fifo->tail, memory_order_acquire);
+    
+    if(head == tail)
+    {
+        *ppitem = NULL;
+        return(eores_NOK_nodata);
+    }
+    
+    // the item stays valid until the consumer removes it because the producer cannot write it before
+    *ppitem = s_eo_fifo_spsc_item(fifo, head);
+    return(eores_OK);
+}
+
+static eOresult_t s_eo_fifo_spsc_rem(EOfifo *fifo, void *pitem)
+{
+    uint32_t head = atomic_load_explicit(&fifo->head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&fifo->tail, memory_order_acquire);
+    uint8_t *item = NULL;
+    
+    if(head == tail)
+    {
+        return(eores_NOK_nodata);
+    }
+    
+    item = s_eo_fifo_spsc_item(fifo, head);
+    
+    if(NULL != pitem)
+    {
+        if(NULL != fifo->dek->item_copy_fn) 
+        {
+            fifo->dek->item_copy_fn(pitem, item);
+        }
+        else
+        {
+            memcpy(pitem, item, fifo->dek->item_size);
+        }
+    }
+    
+    if(NULL != fifo->dek->item_clear_fn) 
+    {
+        fifo->dek->item_clear_fn(item);
+    } 
+    else 
+    { 
+        memset(item, 0, fifo->dek->item_size);
+    }
+    
+    atomic_store_explicit(&fifo->head, s_eo_fifo_spsc_next(fifo, head), memory_order_release);
+    return(eores_OK);
+}
+
+static void s_eo_fifo_spsc_clear(EOfifo *fifo)
+{
+    // it is called by the consumer: it removes only what the producer has published so far
+    eOsizecntnr_t n = s_eo_fifo_spsc_size(fifo);
+    for(; n > 0; n--)
+    {
+        s_eo_fifo_spsc_rem(fifo, NULL);
+    }
+}
+
+#endif
 
 
 
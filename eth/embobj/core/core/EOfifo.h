@@ -60,6 +60,21 @@ extern "C" {
 typedef struct EOfifo_hid EOfifo;
 
 
+/** @typedef    typedef enum eOfifo_access_t
+    @brief      Tells how concurrent access to the EOfifo is managed. With eo_fifo_access_mutex every operation
+                is protected by the mutex passed at construction (if not NULL). With eo_fifo_access_spsc the fifo
+                must be used by one producer thread only (eo_fifo_Put()) and one consumer thread only 
+                (eo_fifo_Get(), eo_fifo_Rem(), eo_fifo_GetRem(), eo_fifo_Clear()): the operations do not take any
+                mutex and are wait-free. If the compiler does not offer c11 atomics, eo_fifo_access_spsc behaves
+                as eo_fifo_access_mutex. 
+ **/
+typedef enum
+{
+    eo_fifo_access_mutex    = 0,
+    eo_fifo_access_spsc     = 1
+} eOfifo_access_t;
+
+
     
 // - declaration of extern public variables, ... but better using use _get/_set instead -------------------------------
 // empty-section
@@ -92,6 +107,23 @@ extern EOfifo * eo_fifo_New(eOsizeitem_t item_size, eOsizecntnr_t capacity,
                             eOres_fp_voidp_voidp_t item_copy, eOres_fp_voidp_t item_clear,
                             EOVmutexDerived *mutex);
 
+
+/** @fn         extern EOfifo * eo_fifo_NewWithAccess(eOsizeitem_t item_size, eOsizecntnr_t capacity,
+                                            eOres_fp_voidp_uint32_t item_init, uint32_t init_arg, 
+                                            eOres_fp_voidp_voidp_t item_copy, eOres_fp_voidp_t item_clear,
+                                            EOVmutexDerived *mutex, eOfifo_access_t access)
+    @brief      Creates a new EOfifo object as eo_fifo_New() does but it also selects the access mode. 
+    @param      mutex           Pointer to an object derived by mutex which will protect from concurrent access.
+                                In eo_fifo_access_spsc mode it is used only if the lock-free mode is not available.
+    @param      access          The access mode.
+    @return     Pointer to the required EOfifo object. The pointer is always not NULL.
+ **/
+extern EOfifo * eo_fifo_NewWithAccess(eOsizeitem_t item_size, eOsizecntnr_t capacity,
+                                      eOres_fp_voidp_uint32_t item_init, uint32_t init_arg, 
+                                      eOres_fp_voidp_voidp_t item_copy, eOres_fp_voidp_t item_clear,
+                                      EOVmutexDerived *mutex, eOfifo_access_t access);
+
+
 /** @fn         extern void eo_fifo_Delete(EOfifo * fifo)
     @brief      deletes the fifo, it calls eo_fifo_Clear() before destroying the objects.
     @param      fifo            Pointer to the EOfifo object.
@@ -152,7 +184,8 @@ extern eOresult_t eo_fifo_Get(EOfifo *fifo, const void **ppitem, eOreltime_t tou
     @param      fifo            Pointer to the EOfifo object.
     @param      tout            Timeout for the operation in micro-seconds.
     @return     eores_OK upon success, eores_NOK_nullpointer if fifo is NULL, eores_NOK_timeout if 
-                the mutex was busy within the specified timeout.
+                the mutex was busy within the specified timeout. with eo_fifo_access_spsc it returns 
+                eores_NOK_nodata if the fifo is empty.
  **/
 extern eOresult_t eo_fifo_Rem(EOfifo *fifo, eOreltime_t tout); 
 
@@ -82,6 +82,12 @@ static const char s_eobj_ownname[] = "EOfifoByte";
 
 
 extern EOfifoByte* eo_fifobyte_New(eOsizecntnr_t capacity, EOVmutexDerived *mutex) 
+{
+    return(eo_fifobyte_NewWithAccess(capacity, mutex, eo_fifo_access_mutex));
+}
+
+
+extern EOfifoByte* eo_fifobyte_NewWithAccess(eOsizecntnr_t capacity, EOVmutexDerived *mutex, eOfifo_access_t access) 
 {
     EOfifoByte *retptr = NULL; 
     
@@ -92,7 +98,7 @@ extern EOfifoByte* eo_fifobyte_New(eOsizecntnr_t capacity, EOVmutexDerived *mute
 
     // now i create a fifo made of bytes (no ctor or dtor!) and i fill it into the fifo of 
     // the fifobyte. it can never be NULL 
-    retptr->fifo = eo_fifo_New(1, capacity, NULL, 0, NULL, NULL, mutex);
+    retptr->fifo = eo_fifo_NewWithAccess(1, capacity, NULL, 0, NULL, NULL, mutex, access);
 
     // ok, done
     return(retptr);
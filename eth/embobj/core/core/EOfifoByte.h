@@ -48,6 +48,7 @@ extern "C" {
 
 #include "EoCommon.h"
 #include "EOVmutex.h"
+#include "EOfifo.h"
 
 
 
@@ -82,6 +83,18 @@ typedef struct EOfifoByte_hid EOfifoByte;
 extern EOfifoByte* eo_fifobyte_New(eOsizecntnr_t capacity, EOVmutexDerived *mutex);
 
 
+/** @fn         extern EOfifoByte* eo_fifobyte_NewWithAccess(eOsizecntnr_t capacity, EOVmutexDerived *mutex, eOfifo_access_t access)
+    @brief      Creates a new EOfifoByte object as eo_fifobyte_New() does but it also selects the access mode. 
+                With eo_fifo_access_spsc the object must have only one writer and one reader thread and
+                the mutex is used only if the lock-free mode is not available (see eOfifo_access_t).
+    @param      capacity        Maximum number of byte items that will be stored in the fifobyte queue
+    @param      mutex           Pointer to a mutex-derived object or NULL.
+    @param      access          The access mode.
+    @return     Pointer to the object. The function always returns a valid not NULL pointer.
+ **/
+extern EOfifoByte* eo_fifobyte_NewWithAccess(eOsizecntnr_t capacity, EOVmutexDerived *mutex, eOfifo_access_t access);
+
+
  
 /** @fn         extern void eo_fifobyte_Delete(EOfifoByte *fifobyte)
     @brief      deletes the fifobyte queue. it clears the object before.
@@ -29,6 +29,10 @@ extern "C" {
 #include "EOdeque.h"
 #include "EOVmutex.h"
 
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+#endif
+
 
 // - declaration of extern public interface ---------------------------------------------------------------------------
  
@@ -36,7 +40,18 @@ extern "C" {
 
 
 // - #define used with hidden struct ----------------------------------------------------------------------------------
-// empty-section
+
+// the lock-free single-producer / single-consumer mode needs c11 atomics. on compilers without them
+// the eo_fifo_access_spsc flag falls back to the normal path with the mutex passed at construction.
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_ATOMICS__)
+    #define EOFIFO_SPSC_LOCKFREE
+#endif
+
+#if defined(EOFIFO_SPSC_LOCKFREE)
+typedef atomic_uint_least32_t   eOfifo_spscindex_t;
+#else
+typedef uint32_t                eOfifo_spscindex_t;
+#endif
 
 
 // - definition of the hidden struct implementing the object ----------------------------------------------------------
@@ -54,6 +69,9 @@ struct EOfifo_hid
     EOdeque                 *dek;
     EOVmutexDerived         *mutex;
     // other stuff
+    eObool_t                spsc;       // if eobool_true, the deque is used as a ring accessed only by head and tail
+    eOfifo_spscindex_t      head;       // in [0, 2*capacity). written only by the consumer
+    eOfifo_spscindex_t      tail;       // in [0, 2*capacity). written only by the producer
 };
 
 #ifdef __cplusplus
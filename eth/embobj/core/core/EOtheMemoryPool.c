@@ -27,6 +27,13 @@
 #include "EOtheErrorManager.h"
 #include "EOVmutex.h"
 
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+#if defined(EO_TAILOR_CODE_FOR_LINUX)
+#include <pthread.h>
+#endif
+#endif
+
 
 // --------------------------------------------------------------------------------------------------------------------
 // - declaration of extern public interface
@@ -45,7 +52,19 @@
 // --------------------------------------------------------------------------------------------------------------------
 // - #define with internal scope
 // --------------------------------------------------------------------------------------------------------------------
-// empty-section
+
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_ATOMICS__)
+    #define EOMEMPOOL_ARENA_AVAILABLE
+#endif
+
+// with pthreads the arena of a thread is handed to the orphan list when the thread exits
+#if defined(EOMEMPOOL_ARENA_AVAILABLE) && defined(EO_TAILOR_CODE_FOR_LINUX)
+    #define EOMEMPOOL_ARENA_THREADEXIT
+#endif
+
+#define EOMEMPOOL_ARENA_SMALLESTCLASS       16U
+#define EOMEMPOOL_ARENA_BIGGESTCLASS        (EOMEMPOOL_ARENA_SMALLESTCLASS << (eo_mempool_arena_numberofsizeclasses-1))
+#define EOMEMPOOL_ARENA_CHUNKSIZE           (128*1024)
 
  // --------------------------------------------------------------------------------------------------------------------
 // - definition (and initialisation) of extern variables, but better using _get(), _set() 
@@ -62,7 +81,50 @@ const eOmempool_cfg_t eom_mempool_DefaultCfg =
 // --------------------------------------------------------------------------------------------------------------------
 // - typedef with internal scope
 // --------------------------------------------------------------------------------------------------------------------
-// empty-section
+
+#if defined(EOMEMPOOL_ARENA_AVAILABLE)
+
+// every block of mode eo_mempool_alloc_arena is preceded by this header. its size keeps the 16-byte alignment of
+// the heap. when the block is free, the bytes just after the header hold the link to the next free block.
+typedef union
+{
+    struct
+    {
+        eOmempool_arena_t*          arena;      // NULL for the blocks taken directly from the heap
+        uint32_t                    sizeclass;
+        uint32_t                    size;
+    } head;
+    uint64_t                        aligner[2];
+} eOmempool_arena_block_t;
+
+typedef union eOmempool_arena_chunk_t
+{
+    union eOmempool_arena_chunk_t*  next;
+    uint64_t                        aligner[2];
+} eOmempool_arena_chunk_t;
+
+struct eOmempool_arena_hid
+{
+    eOmempool_arena_t*              next;       // in the list of all the arenas
+    eOmempool_arena_t*              nextorphan; // in the list of the arenas of the exited threads
+    eOmempool_arena_chunk_t*        chunks;
+    uint8_t*                        bump;
+    uint8_t*                        bumpend;
+    eOmempool_arena_block_t*        freelist[eo_mempool_arena_numberofsizeclasses];     // used only by the thread which selects the arena
+    _Atomic(eOmempool_arena_block_t*) remotelist[eo_mempool_arena_numberofsizeclasses]; // filled by the other threads
+    atomic_uint_least32_t           allocated[eo_mempool_arena_numberofsizeclasses];    // written only by the thread which selects the arena
+    atomic_uint_least32_t           released[eo_mempool_arena_numberofsizeclasses];     // written only by the thread which selects the arena
+    atomic_uint_least32_t           remotereleased[eo_mempool_arena_numberofsizeclasses];
+};
+
+typedef struct
+{   // it contains the blocks taken directly from the heap and the ones of the arenas already released
+    atomic_uint_least32_t           allocated[eo_mempool_arena_numberofsizeclasses+1];
+    atomic_uint_least32_t           released[eo_mempool_arena_numberofsizeclasses+1];
+    atomic_uint_least32_t           heapbytes;
+} eOmempool_arena_globalstats_t;
+
+#endif
 
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -77,6 +139,21 @@ static void s_memfree(void *p);
 
 static void * s_memrealloc(void *p, uint32_t s);
 
+#if defined(EOMEMPOOL_ARENA_AVAILABLE)
+static eOmempool_arena_t * s_eo_mempool_arena_new(void);
+static eOmempool_arena_t * s_eo_mempool_arena_current(void);
+static eOmempool_arena_t * s_eo_mempool_arena_adopt(void);
+static void s_eo_mempool_arena_drain(eOmempool_arena_t *arena);
+#if defined(EOMEMPOOL_ARENA_THREADEXIT)
+static void s_eo_mempool_arena_key_create(void);
+static void s_eo_mempool_arena_threadexit(void *arena);
+#endif
+static void * s_eo_mempool_arena_allocate(uint32_t size);
+static void * s_eo_mempool_arena_reallocate(void *m, uint32_t size);
+static void s_eo_mempool_arena_release(void *m);
+static void s_eo_mempool_arena_stats_get(eOmempool_arena_stats_t *stats);
+#endif
+
 //static size_t s_eo_mempool_heap_sizeof_allocated_pointer(void* p);
 
 //static uint16_t s_align_size(eOmempool_alignment_t alignmode, uint16_t size);
@@ -133,6 +210,19 @@ static EOtheMemoryPool s_the_mempool =
     }
 };
 
+#if defined(EOMEMPOOL_ARENA_AVAILABLE)
+static _Thread_local eOmempool_arena_t * s_eo_mempool_arena_ofthread = NULL;
+static _Thread_local eOmempool_arena_t * s_eo_mempool_arena_selected = NULL;
+static eOmempool_arena_globalstats_t s_eo_mempool_arena_stats;
+static eOmempool_arena_t * s_eo_mempool_arena_all = NULL;
+static eOmempool_arena_t * s_eo_mempool_arena_orphans = NULL;
+static atomic_flag s_eo_mempool_arena_lock = ATOMIC_FLAG_INIT;      // protects s_eo_mempool_arena_all and s_eo_mempool_arena_orphans
+#if defined(EOMEMPOOL_ARENA_THREADEXIT)
+static pthread_once_t s_eo_mempool_arena_keyonce = PTHREAD_ONCE_INIT;
+static pthread_key_t s_eo_mempool_arena_key;                        // its destructor runs at the exit of a thread which has an arena
+#endif
+#endif
+
 
 // --------------------------------------------------------------------------------------------------------------------
 // - definition of extern public functions
@@ -170,6 +260,15 @@ extern EOtheMemoryPool * eo_mempool_Initialise(const eOmempool_cfg_t *cfg)
     
     switch(cfg->mode)
     {
+#if !defined(EOMEMPOOL_ARENA_AVAILABLE)
+        case eo_mempool_alloc_arena:
+        {
+            // without c11 atomics the arenas are not available: we use the heap as in dynamic mode
+            s_the_mempool.config.mode = eo_mempool_alloc_dynamic;
+        } // and continue as for eo_mempool_alloc_dynamic
+#else
+        case eo_mempool_alloc_arena:
+#endif
         case eo_mempool_alloc_dynamic:
         {
             if(NULL != cfg->conf)
@@ -314,6 +413,13 @@ extern void * eo_mempool_GetMemory(EOtheMemoryPool *p, eOmempool_alignment_t ali
             usedbytesheap = eo_common_msize(ret);
         } break;
         
+#if defined(EOMEMPOOL_ARENA_AVAILABLE)        
+        case eo_mempool_alloc_arena:
+        {   // the statistics are kept by the arena without any eo_common_msize()
+            ret = s_eo_mempool_arena_allocate(number*size);
+        } break;
+#endif
+        
         case eo_mempool_alloc_mixed:
         {        
             if(0 == (p->thepool.status.poolsmask & (uint8_t)alignmode))
@@ -334,6 +440,10 @@ extern void * eo_mempool_GetMemory(EOtheMemoryPool *p, eOmempool_alignment_t ali
             //size = s_align_size(alignmode, size);  // alignment is internal to s_eo_mempool_get_static()
             ret = s_eo_mempool_get_static(alignmode, size, number, &usedbytespool);
         } break;
+        
+        default:
+        {
+        } break;
     
     }
     
@@ -356,6 +466,14 @@ extern void * eo_mempool_GetMemory(EOtheMemoryPool *p, eOmempool_alignment_t ali
 
 extern uint32_t eo_mempool_SizeOfAllocated(EOtheMemoryPool *p)
 {
+#if defined(EOMEMPOOL_ARENA_AVAILABLE)
+    if(eo_mempool_alloc_arena == s_the_mempool.config.mode)
+    {
+        eOmempool_arena_stats_t stats;
+        s_eo_mempool_arena_stats_get(&stats);
+        return(stats.usedbytes);
+    }
+#endif
     return(s_the_mempool.stats.usedbytespool+s_the_mempool.stats.usedbytesheap);
 }
 
@@ -365,9 +483,26 @@ extern eOmempool_alloc_mode_t eo_mempool_alloc_mode_Get(EOtheMemoryPool *p)
 }
 
 
+extern eObool_t eo_mempool_alloc_mode_IsDynamic(EOtheMemoryPool *p)
+{   
+    return(((eo_mempool_alloc_dynamic == s_the_mempool.config.mode) || (eo_mempool_alloc_arena == s_the_mempool.config.mode)) ? eobool_true : eobool_false);
+}
+
+
 extern void * eo_mempool_New(EOtheMemoryPool *p, uint32_t size)
 {
-    void *ret = s_the_mempool.theheap.allocate(size);
+    void *ret = NULL;
+    
+#if defined(EOMEMPOOL_ARENA_AVAILABLE)
+    if(eo_mempool_alloc_arena == s_the_mempool.config.mode)
+    {
+        ret = s_eo_mempool_arena_allocate(size);
+    }
+    else
+#endif
+    {
+        ret = s_the_mempool.theheap.allocate(size);
+    }
 
     if(NULL == ret)
     {   // manage the fatal error in case memory could not be achieved
@@ -379,7 +514,10 @@ extern void * eo_mempool_New(EOtheMemoryPool *p, uint32_t size)
         eo_errman_Error(eo_errman_GetHandle(), eo_errortype_fatal, "eo_mempool_New() no more memory", s_eobj_ownname, &errdes);
     }
     
-    s_the_mempool.stats.usedbytesheap += eo_common_msize(ret);      
+    if(eo_mempool_alloc_arena != s_the_mempool.config.mode)
+    {
+        s_the_mempool.stats.usedbytesheap += eo_common_msize(ret);
+    }
 
     return(ret);   
 }
@@ -395,7 +533,7 @@ extern void * eo_mempool_Realloc(EOtheMemoryPool *p, void *m, uint32_t size)
     }
     
     
-    if(eo_mempool_alloc_dynamic != s_the_mempool.config.mode)
+    if(eobool_false == eo_mempool_alloc_mode_IsDynamic(p))
     {
         eOerrmanDescriptor_t errdes = {0};
         errdes.code             = eo_errman_code_sys_wrongusage;
@@ -407,12 +545,21 @@ extern void * eo_mempool_Realloc(EOtheMemoryPool *p, void *m, uint32_t size)
         return(NULL);
     }            
     
-    if(NULL != m)
+#if defined(EOMEMPOOL_ARENA_AVAILABLE)
+    if(eo_mempool_alloc_arena == s_the_mempool.config.mode)
     {
-        s_the_mempool.stats.usedbytesheap -= eo_common_msize(m); 
-    }    
+        ret = s_eo_mempool_arena_reallocate(m, size);
+    }
+    else
+#endif
+    {
+        if(NULL != m)
+        {
+            s_the_mempool.stats.usedbytesheap -= eo_common_msize(m); 
+        }    
     
-    ret = s_the_mempool.theheap.reallocate(m, size);
+        ret = s_the_mempool.theheap.reallocate(m, size);
+    }
     
     if(NULL == ret)
     {   // manage the fatal error in case memory could not be achieved
@@ -424,7 +571,10 @@ extern void * eo_mempool_Realloc(EOtheMemoryPool *p, void *m, uint32_t size)
         eo_errman_Error(eo_errman_GetHandle(), eo_errortype_fatal, "eo_mempool_Realloc() no more memory", s_eobj_ownname, &errdes);
     }
     
-    s_the_mempool.stats.usedbytesheap += eo_common_msize(ret);  
+    if(eo_mempool_alloc_arena != s_the_mempool.config.mode)
+    {
+        s_the_mempool.stats.usedbytesheap += eo_common_msize(ret);  
+    }
     
     return(ret);   
 }
@@ -437,11 +587,19 @@ extern void eo_mempool_Delete(EOtheMemoryPool *p, void *m)
         return;
     }
     
-    if(eo_mempool_alloc_dynamic != s_the_mempool.config.mode)
+    if(eobool_false == eo_mempool_alloc_mode_IsDynamic(p))
     {        
-        eo_errman_Error(eo_errman_GetHandle(), eo_errortype_warning, "eo_mempool_Delete(): only w/ eo_mempool_alloc_dynamic", s_eobj_ownname, &eo_errman_DescrWrongUsageLocal);       
+        eo_errman_Error(eo_errman_GetHandle(), eo_errortype_warning, "eo_mempool_Delete(): only w/ eo_mempool_alloc_dynamic or eo_mempool_alloc_arena", s_eobj_ownname, &eo_errman_DescrWrongUsageLocal);       
         return;
     }        
+    
+#if defined(EOMEMPOOL_ARENA_AVAILABLE)
+    if(eo_mempool_alloc_arena == s_the_mempool.config.mode)
+    {
+        s_eo_mempool_arena_release(m);
+        return;
+    }
+#endif
         
     s_the_mempool.stats.usedbytesheap -= eo_common_msize(m); 
 
@@ -449,6 +607,114 @@ extern void eo_mempool_Delete(EOtheMemoryPool *p, void *m)
 }
 
 
+extern eOmempool_arena_t * eo_mempool_arena_New(EOtheMemoryPool *p)
+{
+#if defined(EOMEMPOOL_ARENA_AVAILABLE)
+    if(eo_mempool_alloc_arena == s_the_mempool.config.mode)
+    {
+        return(s_eo_mempool_arena_new());
+    }
+#endif
+    return(NULL);
+}
+
+
+extern eOmempool_arena_t * eo_mempool_arena_Select(EOtheMemoryPool *p, eOmempool_arena_t *arena)
+{
+#if defined(EOMEMPOOL_ARENA_AVAILABLE)
+    eOmempool_arena_t *prev = s_eo_mempool_arena_selected;
+    s_eo_mempool_arena_selected = arena;
+    return(prev);
+#else
+    return(NULL);
+#endif
+}
+
+
+extern void eo_mempool_arena_Release(EOtheMemoryPool *p, eOmempool_arena_t *arena)
+{
+#if defined(EOMEMPOOL_ARENA_AVAILABLE)
+    uint8_t i = 0;
+    eOmempool_arena_chunk_t *chunk = NULL;
+    eOmempool_arena_t **pp = NULL;
+    
+    if(NULL == arena)
+    {
+        return;
+    }
+    
+    if(arena == s_eo_mempool_arena_selected)
+    {
+        s_eo_mempool_arena_selected = NULL;
+    }
+    
+    if(arena == s_eo_mempool_arena_ofthread)
+    {
+        s_eo_mempool_arena_ofthread = NULL;
+#if defined(EOMEMPOOL_ARENA_THREADEXIT)
+        pthread_setspecific(s_eo_mempool_arena_key, NULL);
+#endif
+    }
+    
+    while(atomic_flag_test_and_set_explicit(&s_eo_mempool_arena_lock, memory_order_acquire))
+    {
+        ;
+    }
+    
+    for(pp = &s_eo_mempool_arena_all; NULL != *pp; pp = &(*pp)->next)
+    {
+        if(arena == *pp)
+        {
+            *pp = arena->next;
+            break;
+        }
+    }
+    
+    // the blocks still in use are counted as released now
+    for(i=0; i<eo_mempool_arena_numberofsizeclasses; i++)
+    {
+        uint32_t n = atomic_load_explicit(&arena->allocated[i], memory_order_relaxed);
+        atomic_fetch_add_explicit(&s_eo_mempool_arena_stats.allocated[i], n, memory_order_relaxed);
+        atomic_fetch_add_explicit(&s_eo_mempool_arena_stats.released[i], n, memory_order_relaxed);
+    }
+    
+    atomic_flag_clear_explicit(&s_eo_mempool_arena_lock, memory_order_release);
+    
+    chunk = arena->chunks;
+    while(NULL != chunk)
+    {
+        eOmempool_arena_chunk_t *next = chunk->next;
+        s_the_mempool.theheap.release(chunk);
+        chunk = next;
+    }
+    
+    s_the_mempool.theheap.release(arena);
+#endif
+}
+
+
+extern eOresult_t eo_mempool_arena_Stats_Get(EOtheMemoryPool *p, eOmempool_arena_stats_t *stats)
+{
+#if defined(EOMEMPOOL_ARENA_AVAILABLE)
+    if(NULL == stats)
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    if(eo_mempool_alloc_arena != s_the_mempool.config.mode)
+    {
+        return(eores_NOK_generic);
+    }
+    
+    s_eo_mempool_arena_stats_get(stats);
+    
+    return(eores_OK);
+#else
+    return(eores_NOK_generic);
+#endif
+}
+
+
 // --------------------------------------------------------------------------------------------------------------------
 // - definition of extern hidden functions 
 // --------------------------------------------------------------------------------------------------------------------
@@ -568,6 +834,334 @@ static void * s_memrealloc(void *p, uint32_t s)
     return(realloc(p, s));
 }
 
+#if defined(EOMEMPOOL_ARENA_AVAILABLE)
+
+static eOmempool_arena_t * s_eo_mempool_arena_new(void)
+{
+    uint8_t i = 0;
+    eOmempool_arena_t *arena = (eOmempool_arena_t*) s_the_mempool.theheap.allocate(sizeof(eOmempool_arena_t));
+    
+    if(NULL == arena)
+    {
+        return(NULL);
+    }
+    
+    arena->nextorphan = NULL;
+    arena->chunks = NULL;
+    arena->bump = NULL;
+    arena->bumpend = NULL;
+    for(i=0; i<eo_mempool_arena_numberofsizeclasses; i++)
+    {
+        arena->freelist[i] = NULL;
+        atomic_init(&arena->remotelist[i], NULL);
+        atomic_init(&arena->allocated[i], 0);
+        atomic_init(&arena->released[i], 0);
+        atomic_init(&arena->remotereleased[i], 0);
+    }
+    
+    while(atomic_flag_test_and_set_explicit(&s_eo_mempool_arena_lock, memory_order_acquire))
+    {
+        ;
+    }
+    arena->next = s_eo_mempool_arena_all;
+    s_eo_mempool_arena_all = arena;
+    atomic_flag_clear_explicit(&s_eo_mempool_arena_lock, memory_order_release);
+    
+    return(arena);
+}
+
+
+static eOmempool_arena_t * s_eo_mempool_arena_current(void)
+{
+    if(NULL != s_eo_mempool_arena_selected)
+    {
+        return(s_eo_mempool_arena_selected);
+    }
+    
+    if(NULL == s_eo_mempool_arena_ofthread)
+    {   // the arena of an exited thread is reused before a new one is created
+        s_eo_mempool_arena_ofthread = s_eo_mempool_arena_adopt();
+        if(NULL == s_eo_mempool_arena_ofthread)
+        {
+            s_eo_mempool_arena_ofthread = s_eo_mempool_arena_new();
+        }
+#if defined(EOMEMPOOL_ARENA_THREADEXIT)
+        if(NULL != s_eo_mempool_arena_ofthread)
+        {
+            pthread_once(&s_eo_mempool_arena_keyonce, s_eo_mempool_arena_key_create);
+            pthread_setspecific(s_eo_mempool_arena_key, s_eo_mempool_arena_ofthread);
+        }
+#endif
+    }
+    
+    return(s_eo_mempool_arena_ofthread);
+}
+
+
+static eOmempool_arena_t * s_eo_mempool_arena_adopt(void)
+{
+    eOmempool_arena_t *arena = NULL;
+    
+    while(atomic_flag_test_and_set_explicit(&s_eo_mempool_arena_lock, memory_order_acquire))
+    {
+        ;
+    }
+    arena = s_eo_mempool_arena_orphans;
+    if(NULL != arena)
+    {
+        s_eo_mempool_arena_orphans = arena->nextorphan;
+        arena->nextorphan = NULL;
+    }
+    atomic_flag_clear_explicit(&s_eo_mempool_arena_lock, memory_order_release);
+    
+    return(arena);
+}
+
+
+EO_static_inline uint32_t s_eo_mempool_arena_sizeclass(uint32_t size)
+{
+    uint32_t sizeclass = 0;
+    uint32_t sizeofclass = EOMEMPOOL_ARENA_SMALLESTCLASS;
+    
+    while(sizeofclass < size)
+    {
+        sizeofclass <<= 1;
+        sizeclass++;
+    }
+    
+    return(sizeclass);
+}
+
+
+EO_static_inline void s_eo_mempool_arena_increment(atomic_uint_least32_t *counter)
+{   // only the thread which has selected the arena writes the counter, thus it does not need a read-modify-write
+    atomic_store_explicit(counter, atomic_load_explicit(counter, memory_order_relaxed) + 1, memory_order_relaxed);
+}
+
+
+EO_static_inline eOmempool_arena_block_t ** s_eo_mempool_arena_link(eOmempool_arena_block_t *block)
+{
+    return((eOmempool_arena_block_t**)(block+1));
+}
+
+
+static void s_eo_mempool_arena_drain(eOmempool_arena_t *arena)
+{   // it moves the blocks released by the other threads into the free lists. only the owner of the arena calls it
+    uint8_t i = 0;
+    
+    for(i=0; i<eo_mempool_arena_numberofsizeclasses; i++)
+    {
+        eOmempool_arena_block_t *list = atomic_exchange_explicit(&arena->remotelist[i], NULL, memory_order_acquire);
+        while(NULL != list)
+        {
+            eOmempool_arena_block_t *next = *s_eo_mempool_arena_link(list);
+            *s_eo_mempool_arena_link(list) = arena->freelist[i];
+            arena->freelist[i] = list;
+            list = next;
+        }
+    }
+}
+
+#if defined(EOMEMPOOL_ARENA_THREADEXIT)
+
+static void s_eo_mempool_arena_key_create(void)
+{
+    pthread_key_create(&s_eo_mempool_arena_key, s_eo_mempool_arena_threadexit);
+}
+
+
+static void s_eo_mempool_arena_threadexit(void *arena)
+{   
+    // the arena cannot be released because some of its blocks may still be used by other threads. it goes to the 
+    // orphan list, where the blocks released later wait in its remote lists until another thread adopts it.
+    eOmempool_arena_t *a = (eOmempool_arena_t*) arena;
+    
+    if(a == s_eo_mempool_arena_ofthread)
+    {
+        s_eo_mempool_arena_ofthread = NULL;
+    }
+    
+    s_eo_mempool_arena_drain(a);
+    
+    while(atomic_flag_test_and_set_explicit(&s_eo_mempool_arena_lock, memory_order_acquire))
+    {
+        ;
+    }
+    a->nextorphan = s_eo_mempool_arena_orphans;
+    s_eo_mempool_arena_orphans = a;
+    atomic_flag_clear_explicit(&s_eo_mempool_arena_lock, memory_order_release);
+}
+
+#endif
+
+
+static void * s_eo_mempool_arena_allocate(uint32_t size)
+{
+    eOmempool_arena_t *arena = NULL;
+    eOmempool_arena_block_t *block = NULL;
+    uint32_t sizeclass = 0;
+    
+    if(size > EOMEMPOOL_ARENA_BIGGESTCLASS)
+    {   // too big for the arenas: it comes from the heap
+        block = (eOmempool_arena_block_t*) s_the_mempool.theheap.allocate(sizeof(eOmempool_arena_block_t) + size);
+        if(NULL == block)
+        {
+            return(NULL);
+        }
+        block->head.arena = NULL;
+        block->head.sizeclass = eo_mempool_arena_numberofsizeclasses;
+        block->head.size = size;
+        atomic_fetch_add_explicit(&s_eo_mempool_arena_stats.allocated[eo_mempool_arena_numberofsizeclasses], 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&s_eo_mempool_arena_stats.heapbytes, size, memory_order_relaxed);
+        return(block+1);
+    }
+    
+    arena = s_eo_mempool_arena_current();
+    if(NULL == arena)
+    {
+        return(NULL);
+    }
+    
+    sizeclass = s_eo_mempool_arena_sizeclass(size);
+    
+    // at first we reuse a released block: our own ones and then the ones released by other threads
+    block = arena->freelist[sizeclass];
+    if(NULL == block)
+    {
+        block = atomic_exchange_explicit(&arena->remotelist[sizeclass], NULL, memory_order_acquire);
+    }
+    
+    if(NULL != block)
+    {
+        arena->freelist[sizeclass] = *s_eo_mempool_arena_link(block);
+        memset(block+1, 0, size);
+    }
+    else
+    {   // else we take new memory from the current chunk. the memory of a new chunk is already zeroed by the heap 
+        uint32_t required = sizeof(eOmempool_arena_block_t) + (EOMEMPOOL_ARENA_SMALLESTCLASS << sizeclass);
+        if((NULL == arena->bump) || ((uint32_t)(arena->bumpend - arena->bump) < required))
+        {
+            eOmempool_arena_chunk_t *chunk = (eOmempool_arena_chunk_t*) s_the_mempool.theheap.allocate(sizeof(eOmempool_arena_chunk_t) + EOMEMPOOL_ARENA_CHUNKSIZE);
+            if(NULL == chunk)
+            {
+                return(NULL);
+            }
+            chunk->next = arena->chunks;
+            arena->chunks = chunk;
+            arena->bump = (uint8_t*)(chunk+1);
+            arena->bumpend = arena->bump + EOMEMPOOL_ARENA_CHUNKSIZE;
+        }
+        block = (eOmempool_arena_block_t*) arena->bump;
+        arena->bump += required;
+    }
+    
+    block->head.arena = arena;
+    block->head.sizeclass = sizeclass;
+    block->head.size = size;
+    
+    s_eo_mempool_arena_increment(&arena->allocated[sizeclass]);
+    
+    return(block+1);
+}
+
+
+static void * s_eo_mempool_arena_reallocate(void *m, uint32_t size)
+{
+    eOmempool_arena_block_t *block = NULL;
+    void *ret = NULL;
+    
+    if(NULL == m)
+    {
+        return(s_eo_mempool_arena_allocate(size));
+    }
+    
+    block = ((eOmempool_arena_block_t*)m) - 1;
+    
+    if((block->head.sizeclass < eo_mempool_arena_numberofsizeclasses) && (size <= (EOMEMPOOL_ARENA_SMALLESTCLASS << block->head.sizeclass)))
+    {   // it still fits inside its size class
+        block->head.size = size;
+        return(m);
+    }
+    
+    ret = s_eo_mempool_arena_allocate(size);
+    if(NULL != ret)
+    {
+        memcpy(ret, m, (block->head.size < size) ? (block->head.size) : (size));
+        s_eo_mempool_arena_release(m);
+    }
+    
+    return(ret);
+}
+
+
+static void s_eo_mempool_arena_release(void *m)
+{
+    eOmempool_arena_block_t *block = ((eOmempool_arena_block_t*)m) - 1;
+    eOmempool_arena_t *arena = block->head.arena;
+    uint32_t sizeclass = block->head.sizeclass;
+    
+    if(NULL == arena)
+    {   // it came from the heap
+        atomic_fetch_add_explicit(&s_eo_mempool_arena_stats.released[sizeclass], 1, memory_order_relaxed);
+        atomic_fetch_sub_explicit(&s_eo_mempool_arena_stats.heapbytes, block->head.size, memory_order_relaxed);
+        s_the_mempool.theheap.release(block);
+        return;
+    }
+    
+    if(arena == ((NULL != s_eo_mempool_arena_selected) ? (s_eo_mempool_arena_selected) : (s_eo_mempool_arena_ofthread)))
+    {   // the calling thread owns the free list
+        s_eo_mempool_arena_increment(&arena->released[sizeclass]);
+        *s_eo_mempool_arena_link(block) = arena->freelist[sizeclass];
+        arena->freelist[sizeclass] = block;
+    }
+    else
+    {   // lock-free push: the thread which owns the arena takes the whole list at once, thus there is no aba problem
+        eOmempool_arena_block_t *head = atomic_load_explicit(&arena->remotelist[sizeclass], memory_order_relaxed);
+        atomic_fetch_add_explicit(&arena->remotereleased[sizeclass], 1, memory_order_relaxed);
+        do
+        {
+            *s_eo_mempool_arena_link(block) = head;
+        } while(!atomic_compare_exchange_weak_explicit(&arena->remotelist[sizeclass], &head, block, memory_order_release, memory_order_relaxed));
+    }
+}
+
+
+static void s_eo_mempool_arena_stats_get(eOmempool_arena_stats_t *stats)
+{
+    uint8_t i = 0;
+    eOmempool_arena_t *arena = NULL;
+    
+    for(i=0; i<=eo_mempool_arena_numberofsizeclasses; i++)
+    {
+        stats->sizeofclass[i] = (i < eo_mempool_arena_numberofsizeclasses) ? (EOMEMPOOL_ARENA_SMALLESTCLASS << i) : 0;
+        stats->allocated[i] = atomic_load_explicit(&s_eo_mempool_arena_stats.allocated[i], memory_order_relaxed);
+        stats->released[i] = atomic_load_explicit(&s_eo_mempool_arena_stats.released[i], memory_order_relaxed);
+    }
+    
+    while(atomic_flag_test_and_set_explicit(&s_eo_mempool_arena_lock, memory_order_acquire))
+    {
+        ;
+    }
+    for(arena = s_eo_mempool_arena_all; NULL != arena; arena = arena->next)
+    {
+        for(i=0; i<eo_mempool_arena_numberofsizeclasses; i++)
+        {
+            stats->allocated[i] += atomic_load_explicit(&arena->allocated[i], memory_order_relaxed);
+            stats->released[i] += atomic_load_explicit(&arena->released[i], memory_order_relaxed);
+            stats->released[i] += atomic_load_explicit(&arena->remotereleased[i], memory_order_relaxed);
+        }
+    }
+    atomic_flag_clear_explicit(&s_eo_mempool_arena_lock, memory_order_release);
+    
+    stats->usedbytes = atomic_load_explicit(&s_eo_mempool_arena_stats.heapbytes, memory_order_relaxed);
+    for(i=0; i<eo_mempool_arena_numberofsizeclasses; i++)
+    {
+        stats->usedbytes += (stats->allocated[i] - stats->released[i]) * stats->sizeofclass[i];
+    }
+}
+
+#endif
+
 //static size_t s_eo_mempool_heap_sizeof_allocated_pointer(void* p)
 //{   // not sure it is portable on 64 bit architectures.
 //    size_t* xx = (size_t*)p;
@@ -35,6 +35,10 @@ extern "C" {
     The EOtheMemoryPool is a memory manager for the embOBJ. It is a singleton which can be initialised to work
     with the heap (mode is eo_mempool_alloc_dynamic), with user-defined static memory (mode is eo_mempool_alloc_static),
     or with a mixture of them (mode is eo_mempool_alloc_mixed).
+    On a host the mode eo_mempool_alloc_arena gets heap memory in large chunks and serves the objects from per-thread
+    arenas organised in size classes. Memory can be released one object at a time or in bulk by releasing a whole arena.
+    On linux the arena of a thread which exits is kept with its blocks still in use and is reused by the next thread 
+    which needs an arena, so that transient threads do not leak memory. 
     If not initialised, the EOtheMemoryPool uses the heap with standard functions: calloc(), realloc(), free(). 
     If initialised to work with heap, the EOtheMemoryPool can be passed user-defined function for allocation, reallocation,
     and release of memory (e.g., the ones from OSAL).
@@ -80,7 +84,8 @@ typedef enum
 {
     eo_mempool_alloc_dynamic    = 0,
     eo_mempool_alloc_static     = 1,
-    eo_mempool_alloc_mixed      = 2
+    eo_mempool_alloc_mixed      = 2,
+    eo_mempool_alloc_arena      = 3     /**< heap memory served by arenas. it needs c11 atomics, else it behaves as eo_mempool_alloc_dynamic */
 } eOmempool_alloc_mode_t;
 
 typedef struct 
@@ -110,6 +115,28 @@ typedef struct
 } eOmempool_alloc_config_t;
 
 
+/**	@typedef    typedef struct eOmempool_arena_hid eOmempool_arena_t 
+ 	@brief      eOmempool_arena_t is an opaque handle of an arena used in mode eo_mempool_alloc_arena. 
+ **/ 
+typedef struct eOmempool_arena_hid eOmempool_arena_t;
+
+
+enum { eo_mempool_arena_numberofsizeclasses = 11 };
+
+/**	@typedef    typedef struct eOmempool_arena_stats_t 
+ 	@brief      Contains the statistics of mode eo_mempool_alloc_arena. The size classes go from 16 to 16384 bytes.
+                The entry eo_mempool_arena_numberofsizeclasses counts the bigger blocks, which are taken directly
+                from the heap.
+ **/ 
+typedef struct
+{
+    uint32_t                    sizeofclass[eo_mempool_arena_numberofsizeclasses+1];
+    uint32_t                    allocated[eo_mempool_arena_numberofsizeclasses+1];
+    uint32_t                    released[eo_mempool_arena_numberofsizeclasses+1];
+    uint32_t                    usedbytes;
+} eOmempool_arena_stats_t;
+
+
 /**	@typedef    typedef struct eOmempool_cfg_t 
  	@brief      Contains the configuration for the EOtheMemoryPool. 
  **/ 
@@ -217,6 +244,16 @@ extern uint32_t eo_mempool_SizeOfAllocated(EOtheMemoryPool *p);
 extern eOmempool_alloc_mode_t eo_mempool_alloc_mode_Get(EOtheMemoryPool *p);
 
 
+/** @fn         extern eObool_t eo_mempool_alloc_mode_IsDynamic(EOtheMemoryPool *p)
+    @brief      Tells if memory can be reallocated and released, i.e., if the mode is eo_mempool_alloc_dynamic or
+                eo_mempool_alloc_arena.
+    @param      p               The mempool singleton                
+    @return     eobool_true or eobool_false.
+ **/ 
+extern eObool_t eo_mempool_alloc_mode_IsDynamic(EOtheMemoryPool *p);
+
+
+
 /** @fn         extern void * eo_mempool_New(EOtheMemoryPool *p, uint32_t size)
     @brief      Gives back memory using heap. If the singleton handler is NULL or if it was not initialised in dynamic mode,
                 it uses the default calloc() function. 
@@ -258,6 +295,44 @@ extern void * eo_mempool_Realloc(EOtheMemoryPool *p, void *m, uint32_t size);
 extern void eo_mempool_Delete(EOtheMemoryPool *p, void *m);
 
 
+/** @fn         extern eOmempool_arena_t * eo_mempool_arena_New(EOtheMemoryPool *p)
+    @brief      Creates a new arena. Every thread already has its own arena, thus a new one is needed only to keep 
+                together objects which shall be released in bulk (e.g., all the objects of a transceiver).
+    @param      p               The mempool singleton   
+    @return     The arena or NULL if the mode is not eo_mempool_alloc_arena.
+ **/  
+extern eOmempool_arena_t * eo_mempool_arena_New(EOtheMemoryPool *p);
+
+
+/** @fn         extern eOmempool_arena_t * eo_mempool_arena_Select(EOtheMemoryPool *p, eOmempool_arena_t *arena)
+    @brief      Makes the calling thread get memory from @e arena. An arena must be selected by one thread at a time.
+                Memory can be released by any thread.
+    @param      p               The mempool singleton   
+    @param      arena           The arena. If NULL, the calling thread goes back to its own arena.
+    @return     The arena which was previously selected by the calling thread (NULL if it was its own).
+ **/  
+extern eOmempool_arena_t * eo_mempool_arena_Select(EOtheMemoryPool *p, eOmempool_arena_t *arena);
+
+
+/** @fn         extern void eo_mempool_arena_Release(EOtheMemoryPool *p, eOmempool_arena_t *arena)
+    @brief      Releases in one shot all the memory of an arena and the arena itself. The blocks bigger than the
+                biggest size class are not part of the arena and must be released with eo_mempool_Delete().
+    @param      p               The mempool singleton   
+    @param      arena           The arena.
+    @warning    The objects allocated in the arena must not be used or deleted anymore.
+ **/  
+extern void eo_mempool_arena_Release(EOtheMemoryPool *p, eOmempool_arena_t *arena);
+
+
+/** @fn         extern eOresult_t eo_mempool_arena_Stats_Get(EOtheMemoryPool *p, eOmempool_arena_stats_t *stats)
+    @brief      Retrieves the number of allocations and releases for each size class of all the arenas.
+    @param      p               The mempool singleton   
+    @param      stats           The statistics.
+    @return     eores_OK, eores_NOK_nullpointer if stats is NULL or eores_NOK_generic if the mode is not eo_mempool_alloc_arena.
+ **/  
+extern eOresult_t eo_mempool_arena_Stats_Get(EOtheMemoryPool *p, eOmempool_arena_stats_t *stats);
+
+
 
 /** @}            
     end of group eo_thememorypool  
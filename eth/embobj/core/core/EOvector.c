@@ -48,6 +48,9 @@
 
 #define EOVECTOR_DEFAULTCLEAR_DOES_NOTHING
 
+// minimum number of items allocated by a vector w/ eo_vectorcapacity_dynamic
+#define EOVECTOR_DYNAMIC_MINALLOCATED   4
+
 
 // --------------------------------------------------------------------------------------------------------------------
 // - definition (and initialisation) of extern variables, but better using _get(), _set() 
@@ -69,6 +72,11 @@
 
 static eOresult_t s_eo_vector_default_matching_rule(EOvector * vector, void *item, void *param);
 
+static void s_eo_vector_reserve(EOvector * vector, uint32_t number);
+static void s_eo_vector_shrink(EOvector * vector);
+static void s_eo_vector_linearise(EOvector * vector);
+static void s_eo_vector_reverse(uint8_t *data, uint32_t size);
+
 
 
 EO_static_inline void s_eo_vector_default_clear(void *item, EOvector* vector)
@@ -89,6 +97,17 @@ EO_static_inline void s_eo_vector_default_init(void* item,  EOvector* vector)
     memset(item, 0, vector->item_size);
 }
 
+EO_static_inline uint8_t* s_eo_vector_item(EOvector* vector, eOsizecntnr_t pos)
+{
+    // cast to uint32_t to tell the reader that index of array start[] can be bigger than max eOsizecntnr_t
+    uint32_t i = (uint32_t)vector->head + pos;
+    if(i >= vector->allocated)
+    {   // only in circular mode
+        i -= vector->allocated;
+    }
+    return(&((uint8_t*)vector->stored_items)[i * vector->item_size]);
+}
+
 //EO_static_inline void s_eo_vector_default_initall(EOvector* vector)
 //{
 //    memset(vector->stored_items, 0, vector->capacity*vector->item_size);
@@ -109,6 +128,15 @@ static const char s_eobj_ownname[] = "EOvector";
 extern EOvector* eo_vector_New(eOsizeitem_t item_size, eOsizecntnr_t capacity,
                                eOres_fp_voidp_uint32_t item_init, uint32_t init_par,  
                                eOres_fp_voidp_voidp_t item_copy, eOres_fp_voidp_t item_clear)
+{
+    return(eo_vector_NewWithLayout(item_size, capacity, item_init, init_par, item_copy, item_clear, eo_vector_layout_contiguous));
+}
+
+
+extern EOvector* eo_vector_NewWithLayout(eOsizeitem_t item_size, eOsizecntnr_t capacity,
+                                         eOres_fp_voidp_uint32_t item_init, uint32_t init_par,  
+                                         eOres_fp_voidp_voidp_t item_copy, eOres_fp_voidp_t item_clear,
+                                         eOvector_layout_t layout)
 {
     EOvector *retptr = NULL;
     uint8_t *start = NULL;
@@ -131,6 +159,9 @@ extern EOvector* eo_vector_New(eOsizeitem_t item_size, eOsizecntnr_t capacity,
     retptr->dummy               = 0;
     retptr->capacity            = capacity;
     retptr->functions           = NULL;
+    retptr->allocated           = 0;
+    retptr->head                = 0;
+    retptr->circular            = (eo_vector_layout_circular == layout) ? (1) : (0);
     if((NULL != item_init) || (NULL != item_copy) || (NULL != item_clear))
     {
         retptr->functions = (EOcontainer_functions_t*) eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_32bit, sizeof(EOcontainer_functions_t), 1);
@@ -144,7 +175,7 @@ extern EOvector* eo_vector_New(eOsizeitem_t item_size, eOsizecntnr_t capacity,
     
     if(eo_vectorcapacity_dynamic == retptr->capacity)
     {      
-        eo_errman_Assert(eo_errman_GetHandle(), (eo_mempool_alloc_dynamic == eo_mempool_alloc_mode_Get(eo_mempool_GetHandle())), "eo_vector_New(): cannot use eo_vectorcapacity_dynamic", s_eobj_ownname, &eo_errman_DescrWrongParamLocal);
+        eo_errman_Assert(eo_errman_GetHandle(), (eobool_true == eo_mempool_alloc_mode_IsDynamic(eo_mempool_GetHandle())), "eo_vector_New(): cannot use eo_vectorcapacity_dynamic", s_eobj_ownname, &eo_errman_DescrWrongParamLocal);
         retptr->stored_items = NULL;
     }
     else
@@ -172,6 +203,7 @@ extern EOvector* eo_vector_New(eOsizeitem_t item_size, eOsizecntnr_t capacity,
 
         // here is the memory from the correct memory pool (or the heap)
         retptr->stored_items  = (void*) eo_mempool_GetMemory(eo_mempool_GetHandle(), align, item_size, capacity);     
+        retptr->allocated     = capacity;
               
 
         start = (uint8_t*) (retptr->stored_items);
@@ -220,7 +252,6 @@ extern eOsizecntnr_t eo_vector_ItemSize(EOvector * vector)
 extern void eo_vector_PushBack(EOvector * vector, void *p) 
 {
     // here we require uint8_t to access stored_items because we work with bytes.
-    uint8_t *start = NULL;
     uint8_t *item = NULL;
         
     if((NULL == vector) || (NULL == p)) 
@@ -235,12 +266,10 @@ extern void eo_vector_PushBack(EOvector * vector, void *p)
     
     if(eo_vectorcapacity_dynamic == vector->capacity)
     {   // in here i dont make any control because in _New() we have already verified that mempool is dynamic 
-        vector->stored_items = eo_mempool_Realloc(eo_mempool_GetHandle(), vector->stored_items, (uint32_t)(vector->size+1) * vector->item_size);
+        s_eo_vector_reserve(vector, (uint32_t)vector->size+1);
     }
             
-    start = (uint8_t*) (vector->stored_items);
-    // cast to uint32_t to tell the reader that index of array start[] can be bigger than max eOsizecntnr_t
-    item = &start[(uint32_t)vector->size * vector->item_size]; 
+    item = s_eo_vector_item(vector, vector->size); 
     
     if((NULL != vector->functions) && (NULL != vector->functions->item_copy_fn)) 
     {
@@ -273,8 +302,7 @@ extern void * eo_vector_Back(EOvector * vector)
         return(start);     
     }
      
-    start = (uint8_t*) (vector->stored_items);
-    item = &start[(uint32_t)(vector->size-1) * vector->item_size];
+    item = s_eo_vector_item(vector, vector->size-1);
     
     return((void*) item);         
 }
@@ -283,7 +311,6 @@ extern void * eo_vector_Back(EOvector * vector)
 extern void eo_vector_PopBack(EOvector * vector) 
 {
     // here we require uint8_t to access stored_items because we work with bytes.
-    uint8_t *start = NULL;
     uint8_t *item = NULL;
     
     if(NULL == vector) 
@@ -296,8 +323,7 @@ extern void eo_vector_PopBack(EOvector * vector)
         return;     
     }
 
-    start = (uint8_t*) (vector->stored_items);
-    item = &start[(uint32_t)(vector->size - 1) * vector->item_size];            
+    item = s_eo_vector_item(vector, vector->size - 1);            
     
     if((NULL != vector->functions) && (NULL != vector->functions->item_clear_fn))
     {
@@ -311,10 +337,14 @@ extern void eo_vector_PopBack(EOvector * vector)
     
     vector->size --;
     
-    //if size is zero, eo_mempool_Realloc() calls eo_mempool_Free() and returns NULL. that is correct.
+    if(0 == vector->size)
+    {
+        vector->head = 0;
+    }
+    
     if(eo_vectorcapacity_dynamic == vector->capacity)
     {   // in here i dont make any control because in _New() we have already verified that mempool is dynamic 
-        vector->stored_items = eo_mempool_Realloc(eo_mempool_GetHandle(), vector->stored_items, (uint32_t)(vector->size) * vector->item_size);
+        s_eo_vector_shrink(vector);
     }
 }
 
@@ -340,16 +370,24 @@ extern void eo_vector_PushFront(EOvector * vector, void *p)
     // if dynamic, then we need to have one more item.
     if(eo_vectorcapacity_dynamic == vector->capacity)
     {   // in here i dont make any control because in _New() we have already verified that mempool is dynamic 
-        vector->stored_items = eo_mempool_Realloc(eo_mempool_GetHandle(), vector->stored_items, (uint32_t)(vector->size+1) * vector->item_size);
+        s_eo_vector_reserve(vector, (uint32_t)vector->size+1);
     }
     
-    start = (uint8_t*) (vector->stored_items);
-    // cast to uint32_t to tell the reader that index of array start[] can be bigger than max eOsizecntnr_t
-    item = &start[0]; 
-    second = &start[(uint32_t)1 * vector->item_size];     
-    
-    // now i must memmove from front into second   
-    memmove(second, vector->stored_items, vector->size * vector->item_size); 
+    if(1 == vector->circular)
+    {   // the head moves back by one position
+        vector->head = (0 == vector->head) ? (vector->allocated - 1) : (vector->head - 1);
+        item = s_eo_vector_item(vector, 0);
+    }
+    else
+    {
+        start = (uint8_t*) (vector->stored_items);
+        // cast to uint32_t to tell the reader that index of array start[] can be bigger than max eOsizecntnr_t
+        item = &start[0]; 
+        second = &start[(uint32_t)1 * vector->item_size];     
+        
+        // now i must memmove from front into second   
+        memmove(second, vector->stored_items, vector->size * vector->item_size); 
+    }
     
     // now we have the first position available and we can copy p into it.
     
@@ -384,8 +422,7 @@ extern void * eo_vector_Front(EOvector * vector)
         return(start);     
     }
      
-    start = (uint8_t*) (vector->stored_items);
-    item = &start[0];
+    item = s_eo_vector_item(vector, 0);
     
     return((void*) item);         
 }
@@ -407,9 +444,7 @@ extern void eo_vector_PopFront(EOvector * vector)
         return;     
     }
 
-    start = (uint8_t*) (vector->stored_items);
-    item = &start[0]; 
-    second = &start[(uint32_t)(1) * vector->item_size];    
+    item = s_eo_vector_item(vector, 0); 
     
     if((NULL != vector->functions) && (NULL != vector->functions->item_clear_fn))
     {
@@ -423,19 +458,27 @@ extern void eo_vector_PopFront(EOvector * vector)
     
     vector->size --;
     
+    if(1 == vector->circular)
+    {   // no need to move memory: the head just goes forward by one position
+        vector->head ++;
+        if((vector->head == vector->allocated) || (0 == vector->size))
+        {
+            vector->head = 0;
+        }
+    }
+    else
+    {   
+        start = (uint8_t*) (vector->stored_items);
+        second = &start[(uint32_t)(1) * vector->item_size];    
+        // now we must move memory starting from second to start for an amount of (vector->size * vector->item_size)
+        // if size is zero, the function memmove() does not copy anything 
+        memmove(vector->stored_items, second, vector->size * vector->item_size); 
+        // should clear memory that before the memmove was used by the last one ... but for now i will not do it.
+    }
     
-    // now we must move memory starting from second to start for an amount of (vector->size * vector->item_size)
-    // if size is zero, the function memmove() does not copy anything 
-    memmove(vector->stored_items, second, vector->size * vector->item_size); 
-    
-    // if size is zero, eo_mempool_Realloc() calls eo_mempool_Free() and returns NULL. that is correct.
     if(eo_vectorcapacity_dynamic == vector->capacity)
     {   // in here i dont make any control because in _New() we have already verified that mempool is dynamic 
-        vector->stored_items = eo_mempool_Realloc(eo_mempool_GetHandle(), vector->stored_items, (uint32_t)(vector->size) * vector->item_size);
-    }
-    else
-    {
-        // should clear memory that before the memmove was used by the last one ... but for now i will not do it.        
+        s_eo_vector_shrink(vector);
     }
 }
 
@@ -454,7 +497,6 @@ extern eOsizecntnr_t eo_vector_Size(EOvector * vector)
 extern void eo_vector_Clear(EOvector * vector) 
 {
     // here we require uint8_t to access stored_items because we work with bytes.
-    uint8_t *start = NULL;
     uint8_t *item = NULL;
     eOsizecntnr_t i = 0;        
     
@@ -470,11 +512,9 @@ extern void eo_vector_Clear(EOvector * vector)
     }
     
 
-    start = (uint8_t*) (vector->stored_items);
     for(i=0; i<vector->size; i++) 
     {   // i use i as index because the items in a vector are always stored from pos 0 to size-1
-        // cast to uint32_t to tell the reader that index of array start[] can be bigger than max eOsizecntnr_t
-        item = &start[(uint32_t)i * vector->item_size];
+        item = s_eo_vector_item(vector, i);
         if((NULL != vector->functions) && (NULL != vector->functions->item_clear_fn))
         {
             vector->functions->item_clear_fn(item);
@@ -487,11 +527,13 @@ extern void eo_vector_Clear(EOvector * vector)
         
     
     vector->size = 0;
+    vector->head = 0;
     
     //its ok to use realloc when size is zero because eo_mempool_Realloc() calls eo_mempool_Free() and returns NULL.
     if(eo_vectorcapacity_dynamic == vector->capacity)
     {   // in here i dont make any control because in _New() we have already verified that mempool is dynamic 
         vector->stored_items = eo_mempool_Realloc(eo_mempool_GetHandle(), vector->stored_items, (uint32_t)(vector->size) * vector->item_size);
+        vector->allocated = 0;
     }
 }
 
@@ -499,7 +541,6 @@ extern void eo_vector_Clear(EOvector * vector)
 extern void * eo_vector_At(EOvector * vector, eOsizecntnr_t pos) 
 {
     // here we require uint8_t to access stored_items because we work with bytes.
-    uint8_t *start = NULL;
     uint8_t *item = NULL;
     
     if(NULL == vector) 
@@ -513,9 +554,7 @@ extern void * eo_vector_At(EOvector * vector, eOsizecntnr_t pos)
     }
     
    
-    start = (uint8_t*) (vector->stored_items);
-    // cast to uint32_t to tell the reader that index of array start[] can be bigger than max eOsizecntnr_t
-    item = &start[(uint32_t)pos * vector->item_size];
+    item = s_eo_vector_item(vector, pos);
     
     return((void*) item);         
 }
@@ -523,7 +562,6 @@ extern void * eo_vector_At(EOvector * vector, eOsizecntnr_t pos)
 extern void eo_vector_Assign(EOvector * vector, eOsizecntnr_t pos, void *items, eOsizecntnr_t nitems)
 {
     // here we require uint8_t to access stored_items because we work with bytes.
-    uint8_t *start = NULL;
     uint8_t *p = NULL;          // external item
     uint8_t *item = NULL;       // internal item
     uint16_t i;
@@ -547,13 +585,11 @@ extern void eo_vector_Assign(EOvector * vector, eOsizecntnr_t pos, void *items,
     // now fill from pos-th position until (pos+nitems-1)-th position w/ objects pointed by items
     
     
-    start = (uint8_t*) (vector->stored_items);
-    // cast to uint32_t to tell the reader that index of array start[] can be bigger than max eOsizecntnr_t
-    item = &start[(uint32_t)pos * vector->item_size]; 
     p = (uint8_t*) items;    // first ext item of items[]
     
     for(i=0; i<nitems; i++)
     {
+        item = s_eo_vector_item(vector, pos+i);
         if((NULL != vector->functions) && (NULL != vector->functions->item_copy_fn))
         {
             vector->functions->item_copy_fn(item, p);
@@ -563,7 +599,6 @@ extern void eo_vector_Assign(EOvector * vector, eOsizecntnr_t pos, void *items,
             s_eo_vector_default_copy(item, p, vector);
         } 
         
-        item += vector->item_size;
         p += vector->item_size;
     }
     
@@ -577,6 +612,11 @@ extern void* eo_vector_storage_Get(EOvector * vector)
         return (NULL);    
     }    
     
+    if(1 == vector->circular)
+    {
+        s_eo_vector_linearise(vector);
+    }
+    
     return(vector->stored_items);   
 }
 
@@ -584,7 +624,6 @@ extern void* eo_vector_storage_Get(EOvector * vector)
 extern void eo_vector_AssignOne(EOvector * vector, eOsizecntnr_t pos, void *p) 
 {
     // here we require uint8_t to access stored_items because we work with bytes.
-    uint8_t *start = NULL;
     uint8_t *item = NULL;
         
     if((NULL == vector) || (NULL == p)) 
@@ -606,9 +645,7 @@ extern void eo_vector_AssignOne(EOvector * vector, eOsizecntnr_t pos, void *p)
     // now fill the pos-th position w/ object p
     
     
-    start = (uint8_t*) (vector->stored_items);
-    // cast to uint32_t to tell the reader that index of array start[] can be bigger than max eOsizecntnr_t
-    item = &start[(uint32_t)pos * vector->item_size]; 
+    item = s_eo_vector_item(vector, pos); 
     
     if((NULL != vector->functions) && (NULL != vector->functions->item_copy_fn))
     {
@@ -626,7 +663,6 @@ extern void eo_vector_AssignOne(EOvector * vector, eOsizecntnr_t pos, void *p)
 extern void eo_vector_Resize(EOvector * vector, eOsizecntnr_t size) 
 {
     // here we require uint8_t to access stored_items because we work with bytes.
-    uint8_t *start = NULL;
     uint8_t *item = NULL;
     eOsizecntnr_t first;
     eOsizecntnr_t last;
@@ -668,26 +704,24 @@ extern void eo_vector_Resize(EOvector * vector, eOsizecntnr_t size)
         added = 1;      
     }
     
+    // add items if dynamic mode. it must be done before the new size is assigned
+    if((1 == added) && (eo_vectorcapacity_dynamic == vector->capacity))
+    {   // i must allocate new memory
+        // in here i dont make any control because in _New() we have already verified that mempool is dynamic 
+        s_eo_vector_reserve(vector, size);
+    }
+    
     // new size
     vector->size = size;
     
     
     if(1 == added)
     {   // must create the new items
-    
-        // add items if dynamic mode
-        if(eo_vectorcapacity_dynamic == vector->capacity)
-        {   // i must allocate new memory
-            // in here i dont make any control because in _New() we have already verified that mempool is dynamic 
-            vector->stored_items = eo_mempool_Realloc(eo_mempool_GetHandle(), vector->stored_items, (uint32_t)(vector->size) * vector->item_size);
-        }
         
         // ok, now i init the new memory as if it was just created. we do it for the new items.
-        start = (uint8_t*) (vector->stored_items);
         for(i=first; i<last; i++) 
         {
-            // cast to uint32_t to tell the reader that index of array start[] can be bigger than max eOsizecntnr_t
-            item = &start[(uint32_t)i * vector->item_size];
+            item = s_eo_vector_item(vector, i);
             if((NULL != vector->functions) && (NULL != vector->functions->item_init_fn))
             {
                 vector->functions->item_init_fn(item, vector->functions->item_init_par);
@@ -702,11 +736,9 @@ extern void eo_vector_Resize(EOvector * vector, eOsizecntnr_t size)
     else
     {   // must destroy the items
     
-        start = (uint8_t*) (vector->stored_items);
         for(i=first; i<last; i++) 
         {
-            // cast to uint32_t to tell the reader that index of array start[] can be bigger than max eOsizecntnr_t
-            item = &start[(uint32_t)i * vector->item_size];
+            item = s_eo_vector_item(vector, i);
             if((NULL != vector->functions) && (NULL != vector->functions->item_clear_fn))
             {
                 vector->functions->item_clear_fn(item);
@@ -720,7 +752,7 @@ extern void eo_vector_Resize(EOvector * vector, eOsizecntnr_t size)
         // remove items if dynamic mode
         if(eo_vectorcapacity_dynamic == vector->capacity)
         {   // in here i dont make any control because in _New() we have already verified that mempool is dynamic 
-            vector->stored_items = eo_mempool_Realloc(eo_mempool_GetHandle(), vector->stored_items, (uint32_t)(vector->size) * vector->item_size);
+            s_eo_vector_shrink(vector);
         }  
         
     }
@@ -765,9 +797,10 @@ extern eObool_t eo_vector_Find(EOvector * vector, eOresult_t (matching_rule)(voi
     
 
     // loop over all items to see is any matches with external data
-    for(i=0, item = (uint8_t*) (vector->stored_items); i<vector->size; i++, item += vector->item_size)
+    for(i=0; i<vector->size; i++)
     {
         //if(0 == memcmp(param, item, vector->item_size))
+        item = s_eo_vector_item(vector, i);
         
         if(NULL != matching_rule)
         {
@@ -803,8 +836,9 @@ extern void eo_vector_Execute(EOvector *vector, void (execute)(void *item, void
     }
     
     // loop over all items to call the execute()
-    for(i=0, item = (uint8_t*) (vector->stored_items); i<vector->size; i++, item += vector->item_size)
+    for(i=0; i<vector->size; i++)
     {
+        item = s_eo_vector_item(vector, i);
         execute(item, param);
     }
     
@@ -861,6 +895,98 @@ static eOresult_t s_eo_vector_default_matching_rule(EOvector * vector, void *ite
 }
 
 
+static void s_eo_vector_reserve(EOvector * vector, uint32_t number)
+{   // for eo_vectorcapacity_dynamic only. the room grows geometrically so that n push operations cost O(n)
+    uint8_t *start = NULL;
+    uint32_t allocated = 2 * (uint32_t)vector->allocated;
+    uint32_t moved = 0;
+    
+    if(number <= vector->allocated)
+    {
+        return;
+    }
+    
+    if(allocated < number)
+    {
+        allocated = number;
+    }
+    if(allocated < EOVECTOR_DYNAMIC_MINALLOCATED)
+    {
+        allocated = EOVECTOR_DYNAMIC_MINALLOCATED;
+    }
+    if(allocated > eo_vectorcapacity_dynamic)
+    {
+        allocated = eo_vectorcapacity_dynamic;
+    }
+    
+    vector->stored_items = eo_mempool_Realloc(eo_mempool_GetHandle(), vector->stored_items, allocated * vector->item_size);
+    start = (uint8_t*) (vector->stored_items);
+    
+    if(((uint32_t)vector->head + vector->size) > vector->allocated)
+    {   // only in circular mode: the items wrap around the old end. i move those from head to the old end to the new end 
+        moved = vector->allocated - vector->head;
+        memmove(&start[(allocated - moved) * vector->item_size], &start[(uint32_t)vector->head * vector->item_size], moved * vector->item_size);
+        vector->head = (eOsizecntnr_t)(allocated - moved);
+    }
+    
+    vector->allocated = (eOsizecntnr_t)allocated;
+}
+
+
+static void s_eo_vector_shrink(EOvector * vector)
+{   // for eo_vectorcapacity_dynamic only. the room halves when only a quarter of it is used
+    uint32_t allocated = vector->allocated / 2;
+    
+    if((vector->allocated <= EOVECTOR_DYNAMIC_MINALLOCATED) || (vector->size > (vector->allocated / 4)))
+    {
+        return;
+    }
+    
+    s_eo_vector_linearise(vector);
+    vector->stored_items = eo_mempool_Realloc(eo_mempool_GetHandle(), vector->stored_items, allocated * vector->item_size);
+    vector->allocated = (eOsizecntnr_t)allocated;
+}
+
+
+static void s_eo_vector_linearise(EOvector * vector)
+{   // it moves the items so that the one in position 0 is at the start of the storage 
+    uint8_t *start = (uint8_t*) (vector->stored_items);
+    uint32_t headbytes = (uint32_t)vector->head * vector->item_size;
+    
+    if(0 == vector->head)
+    {
+        return;
+    }
+    
+    if(((uint32_t)vector->head + vector->size) <= vector->allocated)
+    {
+        memmove(start, &start[headbytes], (uint32_t)vector->size * vector->item_size);
+    }
+    else
+    {   // the items wrap around the end: i rotate the whole storage to the left by head items w/ three reversals
+        s_eo_vector_reverse(start, headbytes);
+        s_eo_vector_reverse(&start[headbytes], (uint32_t)vector->allocated * vector->item_size - headbytes);
+        s_eo_vector_reverse(start, (uint32_t)vector->allocated * vector->item_size);
+    }
+    
+    vector->head = 0;
+}
+
+
+static void s_eo_vector_reverse(uint8_t *data, uint32_t size)
+{
+    uint8_t tmp = 0;
+    uint32_t i = 0;
+    
+    for(i=0; i<size/2; i++)
+    {
+        tmp = data[i];
+        data[i] = data[size-1-i];
+        data[size-1-i] = tmp;
+    }
+}
+
+
 
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -67,6 +67,20 @@ typedef struct EOvector_hid EOvector;
 
 enum { eo_vectorcapacity_dynamic = eo_sizecntnr_dynamic };
 
+
+/** @typedef    typedef enum eOvector_layout_t
+    @brief      Tells how the items are placed inside the storage of the EOvector. With eo_vector_layout_contiguous
+                the item in position 0 is always at the start of the storage, hence eo_vector_PushFront() and 
+                eo_vector_PopFront() must move all the other items. With eo_vector_layout_circular the storage is 
+                used as a ring buffer, so that eo_vector_PushFront() and eo_vector_PopFront() are O(1) and the 
+                EOvector can be used as an efficient queue. eo_vector_At() works in the same way for both layouts. 
+ **/
+typedef enum
+{
+    eo_vector_layout_contiguous     = 0,
+    eo_vector_layout_circular       = 1
+} eOvector_layout_t;
+
     
 // - declaration of extern public variables, ... but better using use _get/_set instead -------------------------------
 // empty-section
@@ -84,7 +98,8 @@ enum { eo_vectorcapacity_dynamic = eo_sizecntnr_dynamic };
     @param      item_size       The size in bytes of the item object managed by the EOvector.
     @param      capacity        The max number of item objects stored by the EOvector. If its value is eo_vectorcapacity_dynamic
                                 then the capacity is unlimited. the container does not pre-allocates memory in here
-                                but just reallocs whet it needs at every function call.
+                                but reallocs when it needs more room, doubling the allocated items each time, and 
+                                it halves them when only a quarter is used.
     @param      item_init       Pointer to a specialised init function for the item object to be called at
                                 creation of the object for each contained item with arguments item_init(item, item_par). 
                                 If NULL, memory is just set to zero.
@@ -103,6 +118,20 @@ extern EOvector * eo_vector_New(eOsizeitem_t item_size, eOsizecntnr_t capacity,
                                 eOres_fp_voidp_voidp_t item_copy, eOres_fp_voidp_t item_clear);
 
 
+/** @fn         extern EOvector * eo_vector_NewWithLayout(eOsizeitem_t item_size, eOsizecntnr_t capacity, 
+                                             eOres_fp_voidp_uint32_t item_init, uint32_t init_par, 
+                                             eOres_fp_voidp_voidp_t item_copy, eOres_fp_voidp_t item_clear,
+                                             eOvector_layout_t layout);
+    @brief      Creates a new EOvector object as eo_vector_New() does but it also selects the layout of its storage. 
+    @param      layout          The layout. eo_vector_New() uses eo_vector_layout_contiguous.
+    @return     Pointer to the required EOvector object. The pointer is always not NULL.
+ **/
+extern EOvector * eo_vector_NewWithLayout(eOsizeitem_t item_size, eOsizecntnr_t capacity,
+                                          eOres_fp_voidp_uint32_t item_init, uint32_t init_par, 
+                                          eOres_fp_voidp_voidp_t item_copy, eOres_fp_voidp_t item_clear,
+                                          eOvector_layout_t layout);
+
+
 /** @fn         extern eOsizecntnr_t eo_vector_Capacity(EOvector * vector)
     @brief      Returns the maximum number of item objects that the EOvector is able to contain.
     @param      vector           Pointer to the EOvector object.
@@ -263,6 +292,13 @@ extern eObool_t eo_vector_Find(EOvector * vector, eOresult_t (matching_rule)(voi
 extern void eo_vector_Execute(EOvector *vector, void (execute)(void *item, void *param), void *param);
 
 
+/** @fn         extern void* eo_vector_storage_Get(EOvector * vector)
+    @brief      Gives the storage of the items, which are contiguous from position 0 to size-1. If the EOvector has 
+                eo_vector_layout_circular and its items wrap around the end of the storage, they are first moved so 
+                that they start at the beginning of it.
+    @param      vector          Pointer to the EOvector object.
+    @return     Pointer to the storage or NULL.
+ **/
 extern void* eo_vector_storage_Get(EOvector * vector);
 
 extern void eo_vector_Delete(EOvector * vector);
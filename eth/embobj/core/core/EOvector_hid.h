@@ -68,6 +68,9 @@ struct EOvector_hid
     uint16_t                    dummy;              
     void                        *stored_items;      /**< array of item object. */   
     EOcontainer_functions_t     *functions;
+    eOsizecntnr_t               allocated;          /**< number of items for which stored_items has room. it differs from capacity only if dynamic. */
+    eOsizecntnr_t               head;               /**< position inside stored_items of the item 0. it is always 0 if not circular. */
+    uint8_t                     circular;           /**< if 1 then stored_items is used as a ring buffer. */
 };
 
 
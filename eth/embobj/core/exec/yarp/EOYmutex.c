@@ -36,6 +36,17 @@
 #include <FeatureInterface.h>   // to see the acemutex_* functions
 #endif
 
+#include "EOYmutex_hid.h" 
+
+#if defined(EOYMUTEX_NATIVE)
+#include <time.h>
+#include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+
 // --------------------------------------------------------------------------------------------------------------------
 // - declaration of extern public interface
 // --------------------------------------------------------------------------------------------------------------------
@@ -46,14 +57,14 @@
 // --------------------------------------------------------------------------------------------------------------------
 // - declaration of extern hidden interface 
 // --------------------------------------------------------------------------------------------------------------------
-
-#include "EOYmutex_hid.h" 
+// included above because it tells if EOYMUTEX_NATIVE is available
 
 
 // --------------------------------------------------------------------------------------------------------------------
 // - #define with internal scope
 // --------------------------------------------------------------------------------------------------------------------
-// empty-section
+
+#define EOYMUTEX_NATIVE_DEFAULTSPINS    100
 
 // --------------------------------------------------------------------------------------------------------------------
 // - definition (and initialisation) of extern variables, but better using _get(), _set() 
@@ -79,6 +90,14 @@ static eOresult_t s_eoy_mutex_release(void *p);
 // virtual
 static eOresult_t s_eoy_mutex_delete(void *p);
 
+#if defined(EOYMUTEX_NATIVE)
+static eOresult_t s_eoy_mutex_native_take(EOYmutex *m, eOreltime_t tout);
+static eOresult_t s_eoy_mutex_native_release(EOYmutex *m);
+static eObool_t s_eoy_mutex_native_wait(EOYmutex *m, eOreltime_t tout, uint64_t start);
+static uint64_t s_eoy_mutex_native_now(void);
+static void s_eoy_mutex_native_increment(eOymutex_counter_t *c, uint64_t v);
+#endif
+
 // --------------------------------------------------------------------------------------------------------------------
 // - definition (and initialisation) of static variables
 // --------------------------------------------------------------------------------------------------------------------
@@ -96,13 +115,35 @@ extern EOYmutex* eoy_mutex_New(void)
     EOYmutex *retptr = NULL;    
 
     // i get the memory for the yarp mutex object
-    retptr = eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_32bit, sizeof(EOYmutex), 1);
+    retptr = eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_64bit, sizeof(EOYmutex), 1);
     
     // i get the base mutex
     retptr->mutex = eov_mutex_hid_New();
 
     // init its vtable
     eov_mutex_hid_SetVTABLE(retptr->mutex, s_eoy_mutex_take, s_eoy_mutex_release, s_eoy_mutex_delete); 
+    
+    retptr->backend = eoy_sys_hid_mutex_cfg_get(eoy_sys_GetHandle())->backend;
+    
+#if defined(EOYMUTEX_NATIVE)
+    if(eoy_mutex_backend_user != retptr->backend)
+    {
+        uint16_t spins = eoy_sys_hid_mutex_cfg_get(eoy_sys_GetHandle())->nativespins;
+        retptr->spins = (0 == spins) ? EOYMUTEX_NATIVE_DEFAULTSPINS : spins;
+        retptr->recursion = 0;
+        atomic_init(&retptr->word, 0);
+        atomic_init(&retptr->owner, 0);
+        atomic_init(&retptr->acquires, 0);
+        atomic_init(&retptr->contended, 0);
+        atomic_init(&retptr->waitnanosec, 0);
+        atomic_init(&retptr->timeouts, 0);
+        // the acemutex is not used, but it must be non-NULL for the checks in take() and release()
+        retptr->acemutex = retptr;
+        return(retptr);
+    }
+#else
+    retptr->backend = eoy_mutex_backend_user;
+#endif
 
     // i get a new yarp mutex
     retptr->acemutex = eoy_sys_hid_mutex_cfg_get(eoy_sys_GetHandle())->fp_new(); // guaranteed to be non-NULL fptr
@@ -126,7 +167,10 @@ extern void eoy_mutex_Delete(EOYmutex *m)
         return;
     }
     
-    eoy_sys_hid_mutex_cfg_get(eoy_sys_GetHandle())->fp_delete(m->acemutex); // guaranteed to be non-NULL fptr
+    if(eoy_mutex_backend_user == m->backend)
+    {
+        eoy_sys_hid_mutex_cfg_get(eoy_sys_GetHandle())->fp_delete(m->acemutex); // guaranteed to be non-NULL fptr
+    }
     
     eov_mutex_hid_Delete(m->mutex);
     
@@ -159,6 +203,29 @@ extern eOresult_t eoy_mutex_Release(EOYmutex *m)
 }
 
 
+extern eOresult_t eoy_mutex_GetStatistics(EOYmutex *m, eOymutex_statistics_t *stats)
+{
+    if((NULL == m) || (NULL == stats))
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    if(eoy_mutex_backend_user == m->backend)
+    {
+        return(eores_NOK_unsupported);
+    }
+    
+#if defined(EOYMUTEX_NATIVE)    
+    stats->acquires = atomic_load_explicit(&m->acquires, memory_order_relaxed);
+    stats->contended = atomic_load_explicit(&m->contended, memory_order_relaxed);
+    stats->waitnanosec = atomic_load_explicit(&m->waitnanosec, memory_order_relaxed);
+    stats->timeouts = atomic_load_explicit(&m->timeouts, memory_order_relaxed);
+#endif
+    
+    return(eores_OK);
+}
+
+
 // --------------------------------------------------------------------------------------------------------------------
 // - definition of extern hidden functions 
 // --------------------------------------------------------------------------------------------------------------------
@@ -178,6 +245,12 @@ static eOresult_t s_eoy_mutex_take(void *p, eOreltime_t tout)
     {
         return eores_NOK_nullpointer;
     }
+#if defined(EOYMUTEX_NATIVE)
+    if(eoy_mutex_backend_user != m->backend)
+    {
+        return s_eoy_mutex_native_take(m, tout);
+    }
+#endif
     return eoy_sys_hid_mutex_cfg_get(eoy_sys_GetHandle())->fp_take(m->acemutex, tout); // guaranteed to be non-NULL fptr
 }
 
@@ -190,6 +263,12 @@ static eOresult_t s_eoy_mutex_release(void *p)
     {
         return eores_NOK_nullpointer;
     }
+#if defined(EOYMUTEX_NATIVE)
+    if(eoy_mutex_backend_user != m->backend)
+    {
+        return s_eoy_mutex_native_release(m);
+    }
+#endif
     return eoy_sys_hid_mutex_cfg_get(eoy_sys_GetHandle())->fp_release(m->acemutex); // guaranteed to be non-NULL fptr
 }
 
@@ -201,6 +280,143 @@ static eOresult_t s_eoy_mutex_delete(void *p)
     return(eores_OK);
 }
 
+
+#if defined(EOYMUTEX_NATIVE)
+
+// the native mutex is the one described in "futexes are tricky" by u. drepper: the word is 0 when free, 1 when taken and 
+// 2 when taken with possible sleepers, so that an uncontended take / release is a single atomic operation w/out syscalls.
+// a contended take first spins for a while because the critical sections of embobj are short, then it sleeps on the futex.
+
+static eOresult_t s_eoy_mutex_native_take(EOYmutex *m, eOreltime_t tout)
+{
+    uintptr_t self = (uintptr_t)pthread_self();
+    int expected = 0;
+    
+    if(self == atomic_load_explicit(&m->owner, memory_order_relaxed))
+    {   // only the owner can see its own id in here
+        if(eoy_mutex_backend_native_recursive != m->backend)
+        {
+            return(eores_NOK_generic);
+        }
+        m->recursion++;
+        s_eoy_mutex_native_increment(&m->acquires, 1);
+        return(eores_OK);
+    }
+    
+    if(eobool_false == atomic_compare_exchange_strong_explicit(&m->word, &expected, 1, memory_order_acquire, memory_order_relaxed))
+    {
+        uint64_t start = 0;
+        
+        if(eok_reltimeZERO == tout)
+        {
+            atomic_fetch_add_explicit(&m->timeouts, 1, memory_order_relaxed);
+            return(eores_NOK_timeout);
+        }
+        
+        start = s_eoy_mutex_native_now();
+        if(eobool_false == s_eoy_mutex_native_wait(m, tout, start))
+        {
+            atomic_fetch_add_explicit(&m->timeouts, 1, memory_order_relaxed);
+            return(eores_NOK_timeout);
+        }
+        
+        s_eoy_mutex_native_increment(&m->contended, 1);
+        s_eoy_mutex_native_increment(&m->waitnanosec, s_eoy_mutex_native_now() - start);
+    }
+    
+    atomic_store_explicit(&m->owner, self, memory_order_relaxed);
+    m->recursion = 1;
+    s_eoy_mutex_native_increment(&m->acquires, 1);
+    
+    return(eores_OK);
+}
+
+
+static eOresult_t s_eoy_mutex_native_release(EOYmutex *m)
+{
+    if((uintptr_t)pthread_self() != atomic_load_explicit(&m->owner, memory_order_relaxed))
+    {
+        return(eores_NOK_generic);
+    }
+    
+    if(--m->recursion > 0)
+    {
+        return(eores_OK);
+    }
+    
+    atomic_store_explicit(&m->owner, 0, memory_order_relaxed);
+    
+    if(1 != atomic_fetch_sub_explicit(&m->word, 1, memory_order_release))
+    {   // there may be sleepers
+        atomic_store_explicit(&m->word, 0, memory_order_release);
+        syscall(SYS_futex, &m->word, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+    }
+    
+    return(eores_OK);
+}
+
+
+static eObool_t s_eoy_mutex_native_wait(EOYmutex *m, eOreltime_t tout, uint64_t start)
+{
+    uint16_t i = 0;
+    int c = 0;
+    
+    for(i=0; i<m->spins; i++)
+    {
+        int expected = 0;
+        if((0 == atomic_load_explicit(&m->word, memory_order_relaxed)) && 
+           (eobool_true == atomic_compare_exchange_weak_explicit(&m->word, &expected, 1, memory_order_acquire, memory_order_relaxed)))
+        {
+            return(eobool_true);
+        }
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        __asm__ __volatile__("yield");
+#endif
+    }
+    
+    // we mark the mutex as contended, so that its release will wake us up
+    while(0 != (c = atomic_exchange_explicit(&m->word, 2, memory_order_acquire)))
+    {
+        struct timespec rel;
+        struct timespec *prel = NULL;
+        
+        if(eok_reltimeINFINITE != tout)
+        {
+            uint64_t elapsed = s_eoy_mutex_native_now() - start;
+            uint64_t limit = 1000ULL * tout;
+            if(elapsed >= limit)
+            {
+                return(eobool_false);
+            }
+            rel.tv_sec = (limit - elapsed) / 1000000000ULL;
+            rel.tv_nsec = (limit - elapsed) % 1000000000ULL;
+            prel = &rel;
+        }
+        
+        syscall(SYS_futex, &m->word, FUTEX_WAIT_PRIVATE, 2, prel, NULL, 0);
+    }
+    
+    return(eobool_true);
+}
+
+
+static uint64_t s_eoy_mutex_native_now(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return(((uint64_t)t.tv_sec * 1000000000ULL) + (uint64_t)t.tv_nsec);
+}
+
+
+static void s_eoy_mutex_native_increment(eOymutex_counter_t *c, uint64_t v)
+{   // only the owner of the mutex writes, so there is no need of an atomic read-modify-write 
+    atomic_store_explicit(c, atomic_load_explicit(c, memory_order_relaxed) + v, memory_order_relaxed);
+}
+
+#endif // EOYMUTEX_NATIVE
+
 // --------------------------------------------------------------------------------------------------------------------
 // - end-of-file (leave a blank line after)
 // --------------------------------------------------------------------------------------------------------------------
@@ -61,6 +61,18 @@ extern "C" {
 typedef struct EOYmutex_hid EOYmutex;
 
 
+/** @typedef    typedef struct eOymutex_statistics_t
+    @brief      eOymutex_statistics_t contains the contention counters of a mutex with a native backend. 
+ **/  
+typedef struct
+{
+    uint64_t    acquires;           /**< number of successful takes, including the recursive ones */
+    uint64_t    contended;          /**< number of takes which found the mutex taken by another thread */
+    uint64_t    waitnanosec;        /**< total time spent waiting in the contended takes which succeeded */
+    uint64_t    timeouts;           /**< number of takes which failed on timeout */
+} eOymutex_statistics_t;
+
+
    
 // - declaration of extern public variables, ... but better using use _get/_set instead -------------------------------
 // empty-section
@@ -108,6 +120,18 @@ extern eOresult_t eoy_mutex_Take(EOYmutex *m, eOreltime_t tout);
 extern eOresult_t eoy_mutex_Release(EOYmutex *m); 
 
 
+/** @fn         extern eOresult_t eoy_mutex_GetStatistics(EOYmutex *m, eOymutex_statistics_t *stats)
+    @brief      It retrieves the contention counters of a mutex. They are kept only by the native backends selected
+                with eOysystem_mutex_cfg_t::backend at eoy_sys_Initialise(). The counters are updated by the owner of the 
+                mutex, so they can be read at any time.
+    @param      m               The mutex
+    @param      stats           The counters
+    @return     eores_OK in case of success, eores_NOK_unsupported if the mutex does not use a native backend, 
+                or eores_NOK_nullpointer if any argument is NULL.
+ **/
+extern eOresult_t eoy_mutex_GetStatistics(EOYmutex *m, eOymutex_statistics_t *stats);
+
+
 
 
 
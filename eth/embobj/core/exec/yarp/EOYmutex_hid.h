@@ -36,6 +36,10 @@ extern "C" {
 #include "EoCommon.h"
 #include "EOVmutex.h"
 
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+#endif
+
 
 
 
@@ -45,7 +49,22 @@ extern "C" {
 
 
 // - #define used with hidden struct ----------------------------------------------------------------------------------
-// empty-section
+
+// the native backend needs the linux futex and c11 atomics. elsewhere the eOysystem_mutex_cfg_t::backend 
+// is ignored and the EOYmutex always uses the fp_* functions.
+#if defined(EO_TAILOR_CODE_FOR_LINUX) && defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_ATOMICS__)
+    #define EOYMUTEX_NATIVE
+#endif
+
+#if defined(EOYMUTEX_NATIVE)
+typedef atomic_int              eOymutex_word_t;
+typedef atomic_uintptr_t        eOymutex_owner_t;
+typedef atomic_uint_least64_t   eOymutex_counter_t;
+#else
+typedef int32_t                 eOymutex_word_t;
+typedef uintptr_t               eOymutex_owner_t;
+typedef uint64_t                eOymutex_counter_t;
+#endif
 
 
 // - definition of the hidden struct implementing the object ----------------------------------------------------------
@@ -64,6 +83,17 @@ struct EOYmutex_hid
 
     // - other stuff
     void                    *acemutex;
+    
+    // - the native backend
+    uint8_t                 backend;        // a eOysystem_mutex_backend_t value
+    uint16_t                spins;
+    uint32_t                recursion;      // number of takes of the owner. written only by the owner 
+    eOymutex_word_t         word;           // 0 is free, 1 is taken, 2 is taken and somebody may sleep on the futex
+    eOymutex_owner_t        owner;          // the thread which has taken the mutex, 0 if none
+    eOymutex_counter_t      acquires;       // the counters are written only by the owner (timeouts by the waiter w/ an atomic add)
+    eOymutex_counter_t      contended;
+    eOymutex_counter_t      waitnanosec;
+    eOymutex_counter_t      timeouts;
 }; 
 
 
@@ -54,11 +54,9 @@
 
 
 
-#if     !defined(EOY_SYS_USE_FEATURE_INTERFACE)
-  #if   defined(EO_TAILOR_CODE_FOR_LINUX)
+#if   defined(EO_TAILOR_CODE_FOR_LINUX)
   #include <time.h>
   #include <sys/time.h>
-  #endif
 #endif
 
 
@@ -110,10 +108,10 @@ static void s_eoy_sys_abstime_set(eOabstime_t time);
 static eOnanotime_t s_eoy_sys_nanotime_get(void);
 static void s_eoy_sys_stop(void);
 
-#if     !defined(EOY_SYS_USE_FEATURE_INTERFACE)
+static uint64_t s_eoy_sys_monotonic_get(void);
+
 #if   defined(EO_TAILOR_CODE_FOR_LINUX)
-static int s_timeval_subtract(struct timespec *_result, struct timespec *_x, struct timespec *_y);
-#endif
+static uint64_t s_eoy_sys_linux_monotonic_get(void);
 #endif
 
 static double s_dummy_timeget() { static uint64_t t = 0; return ++t * 0.01; }
@@ -131,14 +129,18 @@ static const char s_eobj_ownname[] = "EOYtheSystem";
 
 static const eOysystem_cfg_t s_eoy_sys_defaultconfig = 
 {
-    EO_INIT(.timeget)        s_dummy_timeget,
+    EO_INIT(.timeget)        NULL,
     EO_INIT(.mutexcfg)
     {
         EO_INIT(.fp_new)        s_dummy_mtx_new,
         EO_INIT(.fp_take)       s_dummy_mtx_take,
         EO_INIT(.fp_release)    s_dummy_mtx_release,
-        EO_INIT(.fp_delete)     s_dummy_mtx_delete
-    }
+        EO_INIT(.fp_delete)     s_dummy_mtx_delete,
+        EO_INIT(.backend)       eoy_mutex_backend_user,
+        EO_INIT(.filler)        0,
+        EO_INIT(.nativespins)   0
+    },
+    EO_INIT(.nanotimeget)    NULL
 };
 
 static EOYtheSystem s_eoy_system = 
@@ -147,15 +149,10 @@ static EOYtheSystem s_eoy_system =
 
     EO_INIT(.config)            {0},
     EO_INIT(.user_init_fn)      NULL,
-    EO_INIT(.start)             0
+    EO_INIT(.start)             0,
+    EO_INIT(.startnano)         0
 };
 
-#if     !defined(EOY_SYS_USE_FEATURE_INTERFACE)
-#if   defined(EO_TAILOR_CODE_FOR_LINUX)
-static struct timespec s_eoy_sys_linux_start_time;
-#endif
-#endif
-
 // --------------------------------------------------------------------------------------------------------------------
 // - definition of extern public functions
 // --------------------------------------------------------------------------------------------------------------------
@@ -178,6 +175,20 @@ extern EOYtheSystem * eoy_sys_Initialise(const eOysystem_cfg_t *syscfg,
 
     memmove(&s_eoy_system.config, syscfg, sizeof(s_eoy_system.config));
     // check vs NULL and correct problems beforehands
+    
+#if   defined(EO_TAILOR_CODE_FOR_LINUX)
+    // CLOCK_MONOTONIC is served by the vdso, so it is as cheap as CLOCK_REALTIME but it does not jump.
+    // in feature-interface mode we use it only if the user does not give a timeget(), which may be a simulated clock.
+#if     defined(EOY_SYS_USE_FEATURE_INTERFACE)
+    if((NULL == s_eoy_system.config.nanotimeget) && (NULL == s_eoy_system.config.timeget))
+#else
+    if(NULL == s_eoy_system.config.nanotimeget)
+#endif
+    {   
+        s_eoy_system.config.nanotimeget = s_eoy_sys_linux_monotonic_get;
+    }
+#endif
+
     if(NULL == s_eoy_system.config.timeget)
     {
         s_eoy_system.config.timeget = s_dummy_timeget;
@@ -215,15 +226,14 @@ extern EOYtheSystem * eoy_sys_Initialise(const eOysystem_cfg_t *syscfg,
 
     // initialise y-environment
     
-#if     defined(EOY_SYS_USE_FEATURE_INTERFACE)
-    s_eoy_system.start = s_eoy_system.config.timeget();
-#else
-
-#if   defined(EO_TAILOR_CODE_FOR_LINUX)
-  clock_gettime(CLOCK_REALTIME, &s_eoy_sys_linux_start_time);
-#endif
-
-#endif
+    if(NULL != s_eoy_system.config.nanotimeget)
+    {
+        s_eoy_system.startnano = s_eoy_system.config.nanotimeget();
+    }
+    else
+    {
+        s_eoy_system.start = s_eoy_system.config.timeget();
+    }
 
     return(&s_eoy_system);  
 }
@@ -296,52 +306,47 @@ static EOVtaskDerived* s_eoy_sys_gettask(void)
 
 static eOabstime_t s_eoy_sys_abstime_get(void)
 {
-    eOabstime_t time = 0xEABABABABABABABF;
-
-#if     defined(EOY_SYS_USE_FEATURE_INTERFACE)
+    if(NULL != s_eoy_system.config.nanotimeget)
+    {
+        return(s_eoy_sys_monotonic_get() / 1000);
+    }
 
     double delta = s_eoy_system.config.timeget() - s_eoy_system.start;
-
     delta *= (1e6);
-    time = (eOabstime_t)floor(delta);
-
-
-#else//defined(EOY_SYS_USE_FEATURE_INTERFACE)
-
-#if   defined(EO_TAILOR_CODE_FOR_LINUX)
-    struct timespec curr_time, diff;
-    clock_gettime(CLOCK_REALTIME, &curr_time);
-    s_timeval_subtract(&diff, &curr_time, &s_eoy_sys_linux_start_time);
-    time = ((diff.tv_sec * 1000 * 1000) + (diff.tv_nsec/1000));
-#endif
-
-#endif//defined(EOY_SYS_USE_FEATURE_INTERFACE)
-
-    return(time);
+    return((delta > 0) ? (eOabstime_t)delta : 0);
 }
 
 
 static void s_eoy_sys_abstime_set(eOabstime_t time)
 {
-#if     defined(EOY_SYS_USE_FEATURE_INTERFACE)
-    s_eoy_system.start = ((double) time)/ 1e6;
-#else
-    // do nothing ...
-#endif
+    if(NULL != s_eoy_system.config.nanotimeget)
+    {   // the lifetime restarts from time
+        s_eoy_system.startnano = s_eoy_system.config.nanotimeget() - 1000*time;
+    }
+    else
+    {
+        s_eoy_system.start = ((double) time)/ 1e6;
+    }
 }
 
 
 static eOnanotime_t s_eoy_sys_nanotime_get(void)
 {
-    eOnanotime_t nanotime = 0;
+    if(NULL != s_eoy_system.config.nanotimeget)
+    {
+        return(s_eoy_sys_monotonic_get());
+    }
 
-#if     defined(EOY_SYS_USE_FEATURE_INTERFACE)
     double delta = s_eoy_system.config.timeget() - s_eoy_system.start;
     delta *= 1e9;
-    nanotime = (eOnanotime_t)floor(delta);
-#endif
+    return((delta > 0) ? (eOnanotime_t)delta : 0);
+}
 
-    return(nanotime);
+
+static uint64_t s_eoy_sys_monotonic_get(void)
+{
+    // the subtraction is modulo 2^64, so it is correct also when s_eoy_sys_abstime_set() has moved startnano before zero
+    return(s_eoy_system.config.nanotimeget() - s_eoy_system.startnano);
 }
 
 static void s_eoy_sys_stop(void)
@@ -351,45 +356,15 @@ static void s_eoy_sys_stop(void)
 
 
 
-#if     !defined(EOY_SYS_USE_FEATURE_INTERFACE)
-
 #if   defined(EO_TAILOR_CODE_FOR_LINUX)
-// risultato= stop - start, cioè _result = _x - _y
-static int s_timeval_subtract(struct timespec *_result, struct timespec *_x, struct timespec *_y)
+static uint64_t s_eoy_sys_linux_monotonic_get(void)
 {
-	//difftime();
-	/* Perform the carry for the later subtraction by updating y. */
-	static const long int MULTIPLIER = 1000 * 1000 * 1000;
-
-	if(_x->tv_nsec < _y->tv_nsec)
-	{
-		int nsec = (_y->tv_nsec - _x->tv_nsec) / MULTIPLIER + 1;
-
-		_y->tv_nsec -= MULTIPLIER * nsec;
-		_y->tv_sec += nsec;
-	}
-
-	if(_x->tv_nsec - _y->tv_nsec > MULTIPLIER)
-	{
-		int nsec = (_x->tv_nsec - _y->tv_nsec) / MULTIPLIER;
-
-		_y->tv_nsec += MULTIPLIER * nsec;
-		_y->tv_sec -= nsec;
-	}
-
-	/* Compute the time remaining to wait. tv_usec is certainly positive. */
-
-	_result->tv_sec = _x->tv_sec - _y->tv_sec;
-	_result->tv_nsec = _x->tv_nsec - _y->tv_nsec;
-
-	/* Return 1 if result is negative. */
-
-	return _x->tv_sec < _y->tv_sec;
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return(((uint64_t)t.tv_sec * 1000000000ULL) + (uint64_t)t.tv_nsec);
 }
 #endif
 
-#endif//!defined(EOY_SYS_USE_FEATURE_INTERFACE)
-
 
 // --------------------------------------------------------------------------------------------------------------------
 // - end-of-file (leave a blank line after)
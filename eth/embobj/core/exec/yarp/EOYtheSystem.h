@@ -59,12 +59,25 @@ extern "C" {
 
 // - declaration of public user-defined types -------------------------------------------------------------------------
 
+/** @typedef    typedef enum eOysystem_mutex_backend_t
+    @brief      eOysystem_mutex_backend_t tells which mechanism is used by the EOYmutex objects. 
+ **/ 
+typedef enum
+{
+    eoy_mutex_backend_user                  = 0,    /**< the fp_* functions of eOysystem_mutex_cfg_t (e.g., the ace mutex of the FeatureInterface) */
+    eoy_mutex_backend_native_recursive      = 1,    /**< a native spin-then-futex mutex which the owner may take again. on platforms w/out it, it falls back to user */
+    eoy_mutex_backend_native                = 2     /**< as eoy_mutex_backend_native_recursive but not recursive: a second take by the owner fails */
+} eOysystem_mutex_backend_t;
+
 typedef struct
 {
     eOvoidp_fp_void_t           fp_new;
     eOint8_fp_voidp_uint32_t    fp_take;
     eOint8_fp_voidp             fp_release;
     eOvoid_fp_voidp_t           fp_delete;
+    uint8_t                     backend;        /**< use eOysystem_mutex_backend_t values. with the native backends the fp_* functions are not used */
+    uint8_t                     filler;
+    uint16_t                    nativespins;    /**< number of spins on a contended native mutex before sleeping on the futex. 0 uses a default value */
 } eOysystem_mutex_cfg_t;
 
 /** @typedef    typedef struct eOysystem_cfg_t
@@ -74,6 +87,7 @@ typedef struct
 {
     eOdouble_fp_void_t      timeget;
     eOysystem_mutex_cfg_t   mutexcfg;
+    eOuint64_fp_void_t      nanotimeget;    /**< if not NULL it must return a monotonic time in nanoseconds and it is used in place of timeget or of the internal clock */
 } eOysystem_cfg_t;
 
 
@@ -65,6 +65,7 @@ struct EOYtheSystem_hid
     eOysystem_cfg_t             config;
     eOvoid_fp_void_t            user_init_fn;
     double                      start;      // using yarp time, which is storead as a double at its maximum resolution (sec and usec)
+    uint64_t                    startnano;  // using the monotonic clock in nanoseconds (nanotimeget() or CLOCK_MONOTONIC)
 }; 
 
 
@@ -71,6 +71,7 @@ typedef struct
     const uint8_t*      numberofeachentity[eoprot_endpoints_numberof];   
     void*               ramofeachendpoint[eoprot_endpoints_numberof];   
     eObool_fp_uint32_t  isvarproxied_fn[eoprot_endpoints_numberof];        
+    uint16_t            entityoffset[eoprot_endpoints_numberof][eoprot_entities_maxnumberofsupported];  // offset of each entity inside ramofeachendpoint. filled by eoprot_config_endpoint_entities()
 } eOprot_board_data_t;
 
 
@@ -463,6 +464,17 @@ extern eOresult_t eoprot_config_endpoint_entities(eOprotBRD_t brd, eOprotEndpoin
     epi = eoprot_ep_ep2index(ep);
             
     data->numberofeachentity[epi] = numberofentities;    
+    
+    if(NULL != numberofentities)
+    {   // we compute now the offset of each entity, so that s_eoprot_brdentityindex2ramoffset() does not need to loop on the previous ones
+        uint16_t offset = 0;
+        uint8_t i = 0;
+        for(i=0; i<eoprot_ep_entities_numberof[epi]; i++)
+        {
+            data->entityoffset[epi][i] = offset;
+            offset += (numberofentities[i] * eoprot_ep_entities_sizeof[epi][i]);
+        }
+    }
         
     return(res);
 }
@@ -1479,7 +1491,6 @@ static uint16_t s_eoprot_brdentityindex2ramoffset(eOprotBRD_t brd, uint8_t epi,
 {
     eOprot_board_data_t *data = s_eoprot_board_data_get(brd);
     uint16_t offset = 0;
-    uint8_t i = 0;
     
     if(NULL == data)
     {
@@ -1501,10 +1512,8 @@ static uint16_t s_eoprot_brdentityindex2ramoffset(eOprotBRD_t brd, uint8_t epi,
         return(EOK_uint16dummy);
     }
         
-    for(i=0; i<entity; i++)
-    {   // we sum the size of all the entities before the current one
-        offset += (data->numberofeachentity[epi][i] * eoprot_ep_entities_sizeof[epi][i]);
-    }
+    // the size of all the entities before the current one was computed by eoprot_config_endpoint_entities()
+    offset = data->entityoffset[epi][entity];
     // then we add the offset of the current entity
     offset += (index*eoprot_ep_entities_sizeof[epi][entity]);
 
@@ -1544,16 +1553,10 @@ static eObool_t s_eoprot_entity_tag_is_valid(uint8_t epi, eOprotEntity_t entity,
 // returns the offset of the variable with a given tag from the start of the entity
 static uint16_t s_eoprot_rom_entity_offset_of_tag(uint8_t epi, uint8_t ent, eOprotTag_t tag)
 {
-    uint32_t i, tag_aux = 0;
     uint8_t *one = NULL;
     uint8_t *two = NULL;
     int res = 0;
 
-    tag_aux = 0;
-    for(i=0; i<ent; i++)
-    {
-        tag_aux += eoprot_ep_tags_numberof[epi][i];
-    }
     // one contains the address of the default value of the entire entity (eg: &MYdefentity = 0x08001200).
     one = (uint8_t*) eoprot_ep_entities_defval[epi][ent];
     // two contains the address of the default value of the variable, but inside the default value of the entire entity (eg: &MYdefentity.var = 0x08001220)  
@@ -122,6 +122,7 @@ extern EOconfirmationManager* eo_confman_New(const eOconfman_cfg_t *cfg)
     retptr->confrequests = (0 == cfg->maxnumberofconfreqrops) ? (NULL) : (eo_vector_New(sizeof(eOropdescriptor_t), cfg->maxnumberofconfreqrops, NULL, 0, NULL, NULL));
 
     retptr->mtx = (NULL == cfg->mutex_fn_new) ? (NULL) : (cfg->mutex_fn_new());
+    eov_mutex_SetName(retptr->mtx, "EOconfirmationManager");
     
     return(retptr);
 }
@@ -34,6 +34,10 @@
 
 #include "EoProtocol.h"
 
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+#endif
+
 
 
 
@@ -77,6 +81,16 @@
 // - typedef with internal scope
 // --------------------------------------------------------------------------------------------------------------------
 
+#if defined(EONV_SEQLOCK_AVAILABLE)
+// a write section of a sequence counter which is open in the calling thread
+typedef struct
+{
+    const void*     seqlock;    // NULL if the entry is free
+    uint32_t        depth;      // the nested write sections
+} eo_nv_seqlock_held_t;
+
+enum { eo_nv_seqlock_maxheld = 4 };
+#endif
 
 // --------------------------------------------------------------------------------------------------------------------
 // - declaration of static functions
@@ -86,6 +100,14 @@ static eOresult_t s_eo_nv_SetROP(const EOnv *nv, const void *dat, void *dst, eOn
 static eOresult_t s_eo_nv_Set(const EOnv *nv, const void *dat, void *dst, eOnvUpdate_t upd);
 static void s_eo_nv_UpdateROP(const EOnv *nv, eOnvUpdate_t upd, const eOropdescriptor_t *ropdes);
 
+static void s_eo_nv_write_begin(const EOnv *nv);
+static void s_eo_nv_write_end(const EOnv *nv);
+static void s_eo_nv_read(const EOnv *nv, void *dest, uint16_t size);
+
+#if defined(EONV_SEQLOCK_AVAILABLE)
+static eo_nv_seqlock_held_t* s_eo_nv_seqlock_held_find(const void *seqlock);
+#endif
+
 
 EO_static_inline uint16_t s_eo_nv_get_size2(const EOnv *nv)
 {
@@ -99,6 +121,12 @@ EO_static_inline uint16_t s_eo_nv_get_size2(const EOnv *nv)
 
 static const char s_eobj_ownname[] = "EOnv";
 
+#if defined(EONV_SEQLOCK_AVAILABLE)
+// the write sections open in this thread. the init(), update() and onsay() callbacks run inside the write section of 
+// their NV, thus they may call eo_nv_Get() or eo_nv_Set() on it: its ram is accessed directly and not waited for.
+static _Thread_local eo_nv_seqlock_held_t s_eo_nv_seqlock_held[eo_nv_seqlock_maxheld];
+#endif
+
 
 // --------------------------------------------------------------------------------------------------------------------
 // - definition of extern public functions
@@ -123,7 +151,7 @@ extern void eo_nv_Delete(EOnv *nv)
         return;    
     }   
     
-    eo_errman_Assert(eo_errman_GetHandle(), (eo_mempool_alloc_dynamic == eo_mempool_alloc_mode_Get(eo_mempool_GetHandle())), "eo_vector_Delete(): needs eo_mempool_alloc_dynamic", s_eobj_ownname, &eo_errman_DescrWrongUsageLocal);
+    eo_errman_Assert(eo_errman_GetHandle(), (eobool_true == eo_mempool_alloc_mode_IsDynamic(eo_mempool_GetHandle())), "eo_vector_Delete(): needs eo_mempool_alloc_dynamic", s_eobj_ownname, &eo_errman_DescrWrongUsageLocal);
   
     // at first clear.
     eo_nv_Clear(nv);
@@ -147,6 +175,8 @@ extern eOresult_t eo_nv_Clear(EOnv *nv)
     nv->rom         = NULL;       
     nv->ram         = NULL;  
     nv->mtx         = NULL;
+    nv->dirty       = NULL;
+    nv->seqlock     = NULL;
       
     return(eores_OK);
 }
@@ -227,11 +257,8 @@ extern eOresult_t eo_nv_Get(const EOnv *nv, eOnvStorage_t strg, void *data, uint
     {
         case eo_nv_strg_volatile:
         {   // better to protect so that the copy is atomic and not interrupted by other tasks which write 
-            source = nv->ram;       
             *size = s_eo_nv_get_size2(nv);  
-            eov_mutex_Take(nv->mtx, eok_reltimeINFINITE);
-            memcpy(data, source, *size); 
-            eov_mutex_Release(nv->mtx);
+            s_eo_nv_read(nv, data, *size);
             res = eores_OK;
         } break;
 
@@ -265,9 +292,9 @@ extern eOresult_t eo_nv_Init(const EOnv *nv)
     // call the init function if existing
     if(NULL != nv->rom->init)
     {   // protect ...
-        eov_mutex_Take(nv->mtx, eok_reltimeINFINITE);
+        s_eo_nv_write_begin(nv);
         nv->rom->init(nv);
-        eov_mutex_Release(nv->mtx);
+        s_eo_nv_write_end(nv);
         res = eores_OK;
     }
 
@@ -353,15 +380,68 @@ extern eOresult_t eo_nv_hid_Load(EOnv *nv, eOipv4addr_t ip, eOnvBRD_t brd, eOboo
     nv->rom         = rom;
     nv->ram         = ram; 
     nv->mtx         = mtx;
+    nv->dirty       = NULL;
+    nv->seqlock     = NULL;
            
     return(eores_OK);
 }
 
+extern void eo_nv_hid_LoadDirty(EOnv *nv, void* dirty)
+{
+    nv->dirty       = dirty;
+}
+
+extern void eo_nv_hid_LoadSeqlock(EOnv *nv, void* seqlock)
+{
+    nv->seqlock     = seqlock;
+}
+
 extern void eo_nv_hid_Fast_LocalMemoryGet(EOnv *nv, void* dest)
 {
+    s_eo_nv_read(nv, dest, nv->rom->capacity);
+}
+
+extern uint16_t eo_nv_hid_Fast_LocalMemoryGetIfDirty(EOnv *nv, void* dest)
+{
+    uint16_t size = 0;
+    
+#if defined(EONV_SEQLOCK_AVAILABLE)
+    // the flag is atomically taken and cleared before the copy: a writer which changes the ram after that sets it again.
+    if((NULL != nv->dirty) && (0 == atomic_exchange_explicit((atomic_uchar*) nv->dirty, 0, memory_order_acquire)))
+    {
+        return(0);
+    }
+    s_eo_nv_read(nv, dest, nv->rom->capacity);
+    size = nv->rom->capacity;
+#else
+    // without atomics the flag is tested and cleared under the same mutex which protects the copy and the writers
     eov_mutex_Take(nv->mtx, eok_reltimeINFINITE);
-    memcpy(dest, nv->ram, nv->rom->capacity);
+    if((NULL == nv->dirty) || (0 != *((uint8_t*) nv->dirty)))
+    {
+        if(NULL != nv->dirty)
+        {
+            *((uint8_t*) nv->dirty) = 0;
+        }
+        memcpy(dest, nv->ram, nv->rom->capacity);
+        size = nv->rom->capacity;
+    }
     eov_mutex_Release(nv->mtx);    
+#endif
+    
+    return(size);
+}
+
+extern void eo_nv_hid_MarkDirty(const EOnv *nv)
+{
+    if(NULL != nv->dirty)
+    {
+#if defined(EONV_SEQLOCK_AVAILABLE)
+        // release: the reader which takes the flag also sees the ram written before it was set
+        atomic_store_explicit((atomic_uchar*) nv->dirty, 1, memory_order_release);
+#else
+        *((uint8_t*) nv->dirty) = 1;
+#endif
+    }
 }
 
 
@@ -461,10 +541,11 @@ extern eOresult_t eo_nv_hid_OnSay(const EOnv *nv, const eOropdescriptor_t* ropde
 
     // call the onsay function function if not NULL
     if(NULL != nv->onsay)
-    {             
-        eov_mutex_Take(nv->mtx, eok_reltimeINFINITE);
+    {   // onsay() may change the ram: it runs inside the write section and the nv is marked as changed     
+        s_eo_nv_write_begin(nv);
         nv->onsay(nv, ropdes);
-        eov_mutex_Release(nv->mtx);
+        eo_nv_hid_MarkDirty(nv);
+        s_eo_nv_write_end(nv);
     }
     
     return(eores_OK);
@@ -487,10 +568,11 @@ static eOresult_t s_eo_nv_SetROP(const EOnv *nv, const void *dat, void *dst, eOn
 {
     uint16_t size = s_eo_nv_get_size2(nv);
 
-    // copy data
-    eov_mutex_Take(nv->mtx, eok_reltimeINFINITE);
+    // copy data and mark it as changed
+    s_eo_nv_write_begin(nv);
     memcpy(dst, dat, size);
-    eov_mutex_Release(nv->mtx);
+    eo_nv_hid_MarkDirty(nv);
+    s_eo_nv_write_end(nv);
 
     // call the update function if necessary
     s_eo_nv_UpdateROP(nv, upd, ropdes);
@@ -506,10 +588,11 @@ static void s_eo_nv_UpdateROP(const EOnv *nv, eOnvUpdate_t upd, const eOropdescr
         if((eo_nv_upd_always == upd) || (eobool_true == eo_nv_hid_isUpdateable(nv))) 
         {
             if(NULL != nv->rom->update)
-            {
-                eov_mutex_Take(nv->mtx, eok_reltimeINFINITE);
+            {   // update() may change the ram: it runs inside the write section and the nv is marked as changed 
+                s_eo_nv_write_begin(nv);
                 nv->rom->update(nv, ropdes);
-                eov_mutex_Release(nv->mtx);
+                eo_nv_hid_MarkDirty(nv);
+                s_eo_nv_write_end(nv);
             }
         }
     }
@@ -517,6 +600,121 @@ static void s_eo_nv_UpdateROP(const EOnv *nv, eOnvUpdate_t upd, const eOropdescr
 }
 
 
+// the sequence counter is even when the ram is stable and odd while a writer is changing it.
+// a reader copies the ram between two reads of the counter and copies again if they differ or are odd.
+
+static void s_eo_nv_write_begin(const EOnv *nv)
+{
+#if defined(EONV_SEQLOCK_AVAILABLE)
+    if(NULL != nv->seqlock)
+    {
+        atomic_uint_least32_t *seq = (atomic_uint_least32_t*) nv->seqlock;
+        eo_nv_seqlock_held_t *held = s_eo_nv_seqlock_held_find(nv->seqlock);
+        uint32_t s = 0;
+        
+        if(NULL != held)
+        {   // a callback of this thread writes again the NV whose write section is open: the counter is already odd
+            held->depth ++;
+            return;
+        }
+        
+        s = atomic_load_explicit(seq, memory_order_relaxed);
+        for(;;)
+        {   // another writer may be inside: we wait for an even value and make it odd
+            if((0 == (s & 1)) && atomic_compare_exchange_weak_explicit(seq, &s, s+1, memory_order_acquire, memory_order_relaxed))
+            {
+                break;
+            }
+            s = atomic_load_explicit(seq, memory_order_relaxed);
+        }
+        // the odd value must be visible before any change of the ram
+        atomic_thread_fence(memory_order_release);
+        
+        // if this thread has too many open sections the new one is not recorded: only its nested accesses would wait
+        held = s_eo_nv_seqlock_held_find(NULL);
+        if(NULL != held)
+        {
+            held->seqlock = nv->seqlock;
+            held->depth = 1;
+        }
+        return;
+    }
+#endif
+    eov_mutex_Take(nv->mtx, eok_reltimeINFINITE);
+}
+
+static void s_eo_nv_write_end(const EOnv *nv)
+{
+#if defined(EONV_SEQLOCK_AVAILABLE)
+    if(NULL != nv->seqlock)
+    {
+        eo_nv_seqlock_held_t *held = s_eo_nv_seqlock_held_find(nv->seqlock);
+        
+        if(NULL != held)
+        {
+            if(0 != --held->depth)
+            {   // the outer write section is still open
+                return;
+            }
+            held->seqlock = NULL;
+        }
+        
+        atomic_fetch_add_explicit((atomic_uint_least32_t*) nv->seqlock, 1, memory_order_release);
+        return;
+    }
+#endif
+    eov_mutex_Release(nv->mtx);
+}
+
+static void s_eo_nv_read(const EOnv *nv, void *dest, uint16_t size)
+{
+#if defined(EONV_SEQLOCK_AVAILABLE)
+    if(NULL != nv->seqlock)
+    {
+        atomic_uint_least32_t *seq = (atomic_uint_least32_t*) nv->seqlock;
+        uint32_t s0 = 0;
+        uint32_t s1 = 0;
+        
+        if(NULL != s_eo_nv_seqlock_held_find(nv->seqlock))
+        {   // this thread is the writer: the ram cannot change during the copy
+            memcpy(dest, nv->ram, size);
+            return;
+        }
+        
+        do
+        {
+            do
+            {
+                s0 = atomic_load_explicit(seq, memory_order_acquire);
+            } while(0 != (s0 & 1));
+            memcpy(dest, nv->ram, size);
+            atomic_thread_fence(memory_order_acquire);
+            s1 = atomic_load_explicit(seq, memory_order_relaxed);
+        } while(s0 != s1);
+        return;
+    }
+#endif
+    eov_mutex_Take(nv->mtx, eok_reltimeINFINITE);
+    memcpy(dest, nv->ram, size);
+    eov_mutex_Release(nv->mtx);
+}
+
+#if defined(EONV_SEQLOCK_AVAILABLE)
+static eo_nv_seqlock_held_t* s_eo_nv_seqlock_held_find(const void *seqlock)
+{   // with seqlock = NULL it finds a free entry
+    uint8_t i = 0;
+    for(i=0; i<eo_nv_seqlock_maxheld; i++)
+    {
+        if(seqlock == s_eo_nv_seqlock_held[i].seqlock)
+        {
+            return(&s_eo_nv_seqlock_held[i]);
+        }
+    }
+    return(NULL);
+}
+#endif
+
+
 // --------------------------------------------------------------------------------------------------------------------
 // - end-of-file (leave a blank line after)
 // --------------------------------------------------------------------------------------------------------------------
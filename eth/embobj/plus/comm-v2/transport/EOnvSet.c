@@ -33,6 +33,10 @@
 
 #include "EOconstvector_hid.h"
 
+#if defined(EONV_SEQLOCK_AVAILABLE)
+#include <stdatomic.h>
+#endif
+
 
 // --------------------------------------------------------------------------------------------------------------------
 // - declaration of extern public interface
@@ -65,7 +69,10 @@ static const EOconstvector s_eonvset_constvectofEPcfgBasic =
     EO_INIT(.item_size)       sizeof(eOprot_EPcfg_t),
     EO_INIT(.dummy)           0,  
     EO_INIT(.stored_items)    (void*) &eoprot_mn_basicEPcfg,
-    EO_INIT(.functions)       NULL     
+    EO_INIT(.functions)       NULL,
+    EO_INIT(.allocated)       sizeof(eoprot_mn_basicEPcfg)/sizeof(eOprot_EPcfg_t),
+    EO_INIT(.head)            0,
+    EO_INIT(.circular)        0
 };
 
 const eOnvset_BRDcfg_t eonvset_BRDcfgBasic =
@@ -82,7 +89,10 @@ static const EOconstvector s_eonvset_constvectofEPcfgMax =
     EO_INIT(.item_size)       sizeof(eOprot_EPcfg_t),
     EO_INIT(.dummy)           0,  
     EO_INIT(.stored_items)    (void*) eoprot_arrayof_maxEPcfg,
-    EO_INIT(.functions)       NULL          
+    EO_INIT(.functions)       NULL,
+    EO_INIT(.allocated)       sizeof(eoprot_arrayof_maxEPcfg) / sizeof(eOprot_EPcfg_t),
+    EO_INIT(.head)            0,
+    EO_INIT(.circular)        0
 };
 
 const eOnvset_BRDcfg_t eonvset_BRDcfgMax =
@@ -100,7 +110,10 @@ static const EOconstvector s_eonvset_constvectofEPcfgStd =
     EO_INIT(.item_size)       sizeof(eOprot_EPcfg_t),
     EO_INIT(.dummy)           0,  
     EO_INIT(.stored_items)    (void*) eoprot_arrayof_stdEPcfg,
-    EO_INIT(.functions)       NULL          
+    EO_INIT(.functions)       NULL,
+    EO_INIT(.allocated)       sizeof(eoprot_arrayof_stdEPcfg) / sizeof(eOprot_EPcfg_t),
+    EO_INIT(.head)            0,
+    EO_INIT(.circular)        0
 };
 
 const eOnvset_BRDcfg_t eonvset_BRDcfgStd =
@@ -129,6 +142,10 @@ static eOresult_t s_eo_nvset_DeinitDEV(EOnvSet* p);
 
 static EOVmutexDerived* s_eo_nvset_get_nvmutex(EOnvSet* p, eOnvID32_t id32);
 static eOnvset_ep_t* s_eo_nvset_get_endpoint(EOnvSet* p, eOnvEP8_t ep8);
+static void s_eo_nvset_dirtyflags_create(eOnvset_ep_t* theEndpoint);
+static void* s_eo_nvset_get_dirtyflag(EOnvSet* p, eOnvID32_t id32);
+static void* s_eo_nvset_get_seqlock(EOnvSet* p, eOnvID32_t id32);
+static eObool_t s_eo_nvset_snapshot_sharedlock(const eOnvset_snapshot_item_t* a, const eOnvset_snapshot_item_t* b);
 uint16_t s_eonvset_EP2INDEX(EOnvSet* p, uint8_t ep08);
 
 
@@ -155,6 +172,17 @@ extern EOnvSet* eo_nvset_New(eOnvset_protection_t prot, eov_mutex_fn_mutexderive
     p->theboard.ipaddress       = 0;    
     p->mtxderived_new           = mtxnew; 
     p->protection               = (NULL == mtxnew) ? (eo_nvset_protection_none) : (prot); 
+    p->dirtytracking            = eobool_false;
+    
+    if(eo_nvset_protection_seqlock_per_netvar == prot)
+    {
+#if defined(EONV_SEQLOCK_AVAILABLE)
+        // the sequence counters do not need any mutex
+        p->protection           = eo_nvset_protection_seqlock_per_netvar;
+#else
+        p->protection           = (NULL == mtxnew) ? (eo_nvset_protection_none) : (eo_nvset_protection_one_per_netvar); 
+#endif
+    }
 
     return(p);
 }
@@ -408,7 +436,7 @@ static eOresult_t s_eo_nvset_NVsOfEP_Initialise(EOnvSet* p, eOnvset_ep_t* endpoi
                                 ram,
                                 mtx2use
                           );                    
-            
+            eo_nv_hid_LoadSeqlock(&thenv, s_eo_nvset_get_seqlock(p, id32));
          
             eo_nv_Init(&thenv);                             
         }
@@ -555,7 +583,193 @@ extern eOresult_t eo_nvset_NV_Get(EOnvSet* p, eOnvID32_t id32, EOnv* thenv)
                         ram,
                         mtx2use
                   );    
+    
+    if(eobool_true == p->dirtytracking)
+    {
+        eo_nv_hid_LoadDirty(thenv, s_eo_nvset_get_dirtyflag(p, id32));
+    }
+    
+    if(eo_nvset_protection_seqlock_per_netvar == p->protection)
+    {
+        eo_nv_hid_LoadSeqlock(thenv, s_eo_nvset_get_seqlock(p, id32));
+    }
+
+    return(eores_OK);
+}
+
+
+extern eOresult_t eo_nvset_DirtyTracking_Enable(EOnvSet* p)
+{
+    uint16_t i = 0;
+    uint16_t endpointsnum = 0;
+    
+    if(NULL == p)
+    {
+        return(eores_NOK_nullpointer); 
+    }
+    
+    if(eobool_true == p->dirtytracking)
+    {   // already enabled
+        return(eores_OK);
+    }
+    
+    // the endpoints loaded from now on get their flags inside eo_nvset_LoadEP(). 
+    p->dirtytracking = eobool_true;
+    
+    if(NULL == p->theboard.theendpoints)
+    {
+        return(eores_OK);
+    }
+    
+    endpointsnum = eo_vector_Size(p->theboard.theendpoints);
+    for(i=0; i<endpointsnum; i++)
+    {
+        eOnvset_ep_t **ppep = (eOnvset_ep_t **)eo_vector_At(p->theboard.theendpoints, i);
+        s_eo_nvset_dirtyflags_create(*ppep);
+    }
+    
+    return(eores_OK);
+}
+
+
+extern eOresult_t eo_nvset_NV_MarkDirty(EOnvSet* p, eOnvID32_t id32)
+{
+    void* dirty = NULL;
+    
+    if(NULL == p)
+    {
+        return(eores_NOK_nullpointer); 
+    }
+    
+    if(eobool_false == p->dirtytracking)
+    {
+        return(eores_OK);
+    }
+    
+    dirty = s_eo_nvset_get_dirtyflag(p, id32);
+    if(NULL == dirty)
+    {
+        return(eores_NOK_generic);
+    }
+    
+#if defined(EONV_SEQLOCK_AVAILABLE)
+    atomic_store_explicit((atomic_uchar*) dirty, 1, memory_order_release);
+#else
+    *((uint8_t*) dirty) = 1;
+#endif
+    
+    return(eores_OK);
+}
+
+
+extern eOnvset_snapshot_t* eo_nvset_Snapshot_New(EOnvSet* p, const eOnvID32_t* id32s, uint16_t numberof)
+{
+    eOnvset_snapshot_t* s = NULL;
+    uint16_t i = 0;
+    
+    if((NULL == p) || (NULL == id32s) || (0 == numberof))
+    {
+        return(NULL); 
+    }
+    
+    s = (eOnvset_snapshot_t*) eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_auto, sizeof(eOnvset_snapshot_t), 1);
+    s->nvset    = p;
+    s->numberof = numberof;
+    s->size     = 0;
+    s->items    = (eOnvset_snapshot_item_t*) eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_auto, sizeof(eOnvset_snapshot_item_t), numberof);
+    
+    for(i=0; i<numberof; i++)
+    {
+        eOnvset_snapshot_item_t* item = &s->items[i];
+        item->offset = s->size;
+        item->size = 0;
+        if(eores_OK == eo_nvset_NV_Get(p, id32s[i], &item->nv))
+        {
+            item->size = eo_nv_Capacity(&item->nv);
+        }
+        s->size += item->size;
+    }
+    
+    return(s);
+}
+
+
+extern void eo_nvset_Snapshot_Delete(eOnvset_snapshot_t* s)
+{
+    if(NULL == s)
+    {
+        return;
+    }
+    
+    eo_mempool_Delete(eo_mempool_GetHandle(), s->items);
+    eo_mempool_Delete(eo_mempool_GetHandle(), s);
+}
+
+
+extern uint32_t eo_nvset_Snapshot_Size(const eOnvset_snapshot_t* s)
+{
+    return((NULL == s) ? (0) : (s->size));
+}
+
 
+extern eOresult_t eo_nvset_Snapshot_Offset(const eOnvset_snapshot_t* s, uint16_t index, uint32_t* offset, uint16_t* size)
+{
+    if((NULL == s) || (NULL == offset) || (NULL == size))
+    {
+        return(eores_NOK_nullpointer); 
+    }
+    
+    if(index >= s->numberof)
+    {
+        return(eores_NOK_generic); 
+    }
+    
+    *offset = s->items[index].offset;
+    *size = s->items[index].size;
+    
+    return(eores_OK);
+}
+
+
+extern eOresult_t eo_nvset_Snapshot(EOnvSet* p, const eOnvset_snapshot_t* s, void* buffer, uint32_t capacity)
+{
+    uint8_t* data = (uint8_t*)buffer;
+    uint16_t i = 0;
+    
+    if((NULL == p) || (NULL == s) || (NULL == buffer))
+    {
+        return(eores_NOK_nullpointer); 
+    }
+    
+    if((p != s->nvset) || (capacity < s->size))
+    {
+        return(eores_NOK_generic); 
+    }
+    
+    while(i < s->numberof)
+    {
+        const eOnvset_snapshot_item_t* first = &s->items[i];
+        
+        if((0 == first->size) || (NULL != first->nv.seqlock))
+        {   // nothing to copy or a copy which does not lock
+            if(0 != first->size)
+            {
+                eo_nv_hid_Fast_LocalMemoryGet((EOnv*)&first->nv, &data[first->offset]);
+            }
+            i++;
+            continue;
+        }
+        
+        // all the following items which share the same mutex are copied in one shot. it is safe even if mtx is NULL
+        eov_mutex_Take(first->nv.mtx, eok_reltimeINFINITE);
+        do
+        {
+            memcpy(&data[s->items[i].offset], s->items[i].nv.ram, s->items[i].size);
+            i++;
+        } while((i < s->numberof) && (eobool_true == s_eo_nvset_snapshot_sharedlock(first, &s->items[i])));
+        eov_mutex_Release(first->nv.mtx);
+    }
+    
     return(eores_OK);
 }
 
@@ -592,6 +806,7 @@ static eOresult_t s_eo_nvset_InitBRD(EOnvSet* p, eOnvsetOwnership_t ownership, e
     theBoard->ownership             = ownership;
     theBoard->theendpoints          = eo_vector_New(sizeof(eOnvset_ep_t*), eo_vectorcapacity_dynamic, NULL, 0, NULL, NULL);    
     theBoard->mtx_board             = (eo_nvset_protection_one_per_board == p->protection) ? p->mtxderived_new() : NULL;
+    eov_mutex_SetName(theBoard->mtx_board, "EOnvSet.board");
     // reset the ep2indexlut to have all values EOK_uint16dummy
     {
         uint8_t i = 0;
@@ -673,6 +888,12 @@ extern eOresult_t eo_nvset_LoadEP(EOnvSet* p, eOprot_EPcfg_t *cfgofep, eObool_t
     theEndpoint->initted            = eobool_false;    
     theEndpoint->epram              = (void*) eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_auto, sizeofram, 1);
     theEndpoint->mtx_endpoint       = (eo_nvset_protection_one_per_endpoint == p->protection) ? p->mtxderived_new() : NULL;
+    eov_mutex_SetName(theEndpoint->mtx_endpoint, "EOnvSet.endpoint");
+    theEndpoint->dirtyflags         = NULL;
+    if(eobool_true == p->dirtytracking)
+    {
+        s_eo_nvset_dirtyflags_create(theEndpoint);
+    }
         
     // now we must load the ram in the endpoint
     eoprot_config_endpoint_ram(brd, theEndpoint->epcfg.endpoint, theEndpoint->epram, sizeofram);
@@ -689,6 +910,21 @@ extern eOresult_t eo_nvset_LoadEP(EOnvSet* p, eOprot_EPcfg_t *cfgofep, eObool_t
         }
     }
     
+    // or the sequence counters
+    theEndpoint->seqlocks = NULL;
+#if defined(EONV_SEQLOCK_AVAILABLE)
+    if(eo_nvset_protection_seqlock_per_netvar == p->protection)
+    {
+        uint16_t i;
+        atomic_uint_least32_t *seqlocks = (atomic_uint_least32_t*) eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_32bit, sizeof(atomic_uint_least32_t), epnvsnumberof);
+        for(i=0; i<epnvsnumberof; i++)
+        {
+            atomic_init(&seqlocks[i], 0);
+        }
+        theEndpoint->seqlocks = seqlocks;
+    }
+#endif
+    
     // now, i must update the mapping function from ep value to vector of endpoints  
     theBoard->ep2indexlut[theEndpoint->epcfg.endpoint] = eo_vector_Size(theBoard->theendpoints);
     // and only now i push back the endpoint
@@ -747,6 +983,16 @@ static eOresult_t s_eo_nvset_DeinitEPs(EOnvSet* p)
             } 
             eo_vector_Delete(theEndpoint->themtxofthenvs);
         }
+        
+        if(NULL != theEndpoint->dirtyflags)
+        {
+            eo_mempool_Delete(eo_mempool_GetHandle(), theEndpoint->dirtyflags);
+        }
+        
+        if(NULL != theEndpoint->seqlocks)
+        {
+            eo_mempool_Delete(eo_mempool_GetHandle(), theEndpoint->seqlocks);
+        }
    
         // now i erase the memory of the entire eOnvset_ep_t entry        
         eo_mempool_Delete(eo_mempool_GetHandle(), theEndpoint);       
@@ -843,6 +1089,84 @@ uint16_t s_eonvset_EP2INDEX(EOnvSet* p, uint8_t ep08)
     return(index);
 }        
 
+
+static void s_eo_nvset_dirtyflags_create(eOnvset_ep_t* theEndpoint)
+{
+    if(NULL != theEndpoint->dirtyflags)
+    {
+        return;
+    }
+    // one byte per nv rather than one bit, so that nvs protected by different mutexes never share the same memory.
+    // all flags start set, so that the first refresh takes every value.
+#if defined(EONV_SEQLOCK_AVAILABLE)
+    // the flags are atomic because the transmitter tests and clears them without the lock of the writers
+    uint16_t i;
+    atomic_uchar *dirtyflags = (atomic_uchar*) eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_auto, sizeof(atomic_uchar), theEndpoint->epnvsnumberof);
+    for(i=0; i<theEndpoint->epnvsnumberof; i++)
+    {
+        atomic_init(&dirtyflags[i], 1);
+    }
+    theEndpoint->dirtyflags = dirtyflags;
+#else
+    theEndpoint->dirtyflags = (uint8_t*) eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_auto, theEndpoint->epnvsnumberof, 1);
+    memset(theEndpoint->dirtyflags, 1, theEndpoint->epnvsnumberof);
+#endif
+}
+
+
+static void* s_eo_nvset_get_dirtyflag(EOnvSet* p, eOnvID32_t id32)
+{
+    eOnvset_ep_t* theEndpoint = s_eo_nvset_get_endpoint(p, eoprot_ID2endpoint(id32));
+    uint32_t nvprognumber = 0;
+    
+    if((NULL == theEndpoint) || (NULL == theEndpoint->dirtyflags))
+    {
+        return(NULL);
+    }
+    
+    nvprognumber = eoprot_endpoint_id2prognum(p->theboard.boardnum, id32);
+    if(nvprognumber >= theEndpoint->epnvsnumberof)
+    {
+        return(NULL);
+    }
+    
+#if defined(EONV_SEQLOCK_AVAILABLE)
+    return(&((atomic_uchar*)theEndpoint->dirtyflags)[nvprognumber]);
+#else
+    return(&((uint8_t*)theEndpoint->dirtyflags)[nvprognumber]);
+#endif
+}
+
+
+static eObool_t s_eo_nvset_snapshot_sharedlock(const eOnvset_snapshot_item_t* a, const eOnvset_snapshot_item_t* b)
+{
+    return(((0 != b->size) && (NULL == b->nv.seqlock) && (a->nv.mtx == b->nv.mtx)) ? (eobool_true) : (eobool_false));
+}
+
+
+static void* s_eo_nvset_get_seqlock(EOnvSet* p, eOnvID32_t id32)
+{
+#if defined(EONV_SEQLOCK_AVAILABLE)
+    eOnvset_ep_t* theEndpoint = s_eo_nvset_get_endpoint(p, eoprot_ID2endpoint(id32));
+    uint32_t nvprognumber = 0;
+    
+    if((NULL == theEndpoint) || (NULL == theEndpoint->seqlocks))
+    {
+        return(NULL);
+    }
+    
+    nvprognumber = eoprot_endpoint_id2prognum(p->theboard.boardnum, id32);
+    if(nvprognumber >= theEndpoint->epnvsnumberof)
+    {
+        return(NULL);
+    }
+    
+    return(&((atomic_uint_least32_t*)theEndpoint->seqlocks)[nvprognumber]);
+#else
+    return(NULL);
+#endif
+}
+
 // --------------------------------------------------------------------------------------------------------------------
 // - end-of-file (leave a blank line after)
 // --------------------------------------------------------------------------------------------------------------------
@@ -100,9 +100,22 @@ typedef enum
     eo_nvset_protection_none               = 0,    /**< we dont protect vs concurrent access at all */
     eo_nvset_protection_one_per_board      = 2,    /**< all the NVs in a booard share the same mutex */
     eo_nvset_protection_one_per_endpoint   = 3,    /**< all the NVs in an endpoint inside each board share the same mutex */
-    eo_nvset_protection_one_per_netvar     = 4     /**< every NV has its own mutex: heavy use of memory but maximum concurrency */
+    eo_nvset_protection_one_per_netvar     = 4,    /**< every NV has its own mutex: heavy use of memory but maximum concurrency */
+    eo_nvset_protection_seqlock_per_netvar = 5     /**< every NV has its own sequence counter: readers never lock and retry if a writer 
+                                                        has changed the NV meanwhile. it does not need any mutex. without c11 atomics
+                                                        it becomes eo_nvset_protection_one_per_netvar. the init(), update() and onsay() 
+                                                        callbacks run inside the write section of the NV. they may call eo_nv_Get() or 
+                                                        eo_nv_Set() on it, because the thread which holds the write section accesses the 
+                                                        ram directly */
 } eOnvset_protection_t;
 
+
+/** @typedef    typedef struct eOnvset_snapshot_hid eOnvset_snapshot_t
+    @brief      It contains a list of NVs resolved once, so that their values can be copied in a single pass 
+                with eo_nvset_Snapshot(). 
+ **/ 
+typedef struct eOnvset_snapshot_hid eOnvset_snapshot_t;
+
     
 // - declaration of extern public variables, ... but better using use _get/_set instead -------------------------------
 
@@ -144,6 +157,33 @@ extern void* eo_nvset_RAMofEntity_Get(EOnvSet* p, eOnvEP8_t ep8, eOnvENT_t ent,
 
 extern void* eo_nvset_RAMofVariable_Get(EOnvSet* p, eOnvID32_t id32);
 
+// when dirty tracking is enabled, the NVs retrieved with eo_nvset_NV_Get() flag any change done by eo_nv_Set() and 
+// by the protocol parser, so that the EOtransmitter refreshes the regular rops only when their value has changed. 
+// it can be enabled at any time but it cannot be disabled. 
+extern eOresult_t eo_nvset_DirtyTracking_Enable(EOnvSet* p);
+
+// code which writes the ram of a variable directly (e.g., by means of eo_nvset_RAMofVariable_Get()) must call it 
+// after the write if dirty tracking is enabled. else, the new value may not be transmitted. 
+extern eOresult_t eo_nvset_NV_MarkDirty(EOnvSet* p, eOnvID32_t id32);
+
+// it resolves the id32s once into their ram, size and protection. the values are packed in the order of the list 
+// without padding. an id32 not valid in the EOnvSet keeps its place in the list but has size 0.
+// the snapshot must be deleted before the endpoints of the EOnvSet are deinitialised.
+extern eOnvset_snapshot_t* eo_nvset_Snapshot_New(EOnvSet* p, const eOnvID32_t* id32s, uint16_t numberof);
+
+extern void eo_nvset_Snapshot_Delete(eOnvset_snapshot_t* s);
+
+// the number of bytes required by eo_nvset_Snapshot() 
+extern uint32_t eo_nvset_Snapshot_Size(const eOnvset_snapshot_t* s);
+
+// the position inside the buffer of eo_nvset_Snapshot() of the value of the index-th id32 of the list
+extern eOresult_t eo_nvset_Snapshot_Offset(const eOnvset_snapshot_t* s, uint16_t index, uint32_t* offset, uint16_t* size);
+
+// it copies all the values into buffer. consecutive NVs which share the same mutex (e.g., with protection
+// eo_nvset_protection_one_per_board or one_per_endpoint) are copied with a single take of the mutex, thus they are
+// consistent amongst themselves. with eo_nvset_protection_seqlock_per_netvar every NV is copied without locking. 
+extern eOresult_t eo_nvset_Snapshot(EOnvSet* p, const eOnvset_snapshot_t* s, void* buffer, uint32_t capacity);
+
 
 /** @}            
     end of group eo_nvset 
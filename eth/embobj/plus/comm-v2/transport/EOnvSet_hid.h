@@ -58,6 +58,8 @@ typedef struct
     void*                               epram;    
     EOVmutexDerived*                    mtx_endpoint;    
     EOvector*                           themtxofthenvs;    
+    void*                               dirtyflags;         // one per nv, indexed by its progressive number. NULL if dirty tracking is disabled. atomic if EONV_SEQLOCK_AVAILABLE
+    void*                               seqlocks;           // one atomic sequence counter per nv, indexed by its progressive number. used by eo_nvset_protection_seqlock_per_netvar
 } eOnvset_ep_t;
 
 
@@ -74,6 +76,23 @@ typedef struct
 
 
 
+typedef struct
+{
+    EOnv                            nv;
+    uint32_t                        offset;     // of the value inside the buffer of eo_nvset_Snapshot()
+    uint16_t                        size;       // 0 if the id32 is not valid
+} eOnvset_snapshot_item_t;
+
+
+struct eOnvset_snapshot_hid
+{
+    EOnvSet*                        nvset;
+    uint16_t                        numberof;
+    uint32_t                        size;
+    eOnvset_snapshot_item_t*        items;
+};
+
+
 /** @struct     EOnvSet_hid
     @brief      Hidden definition. Implements private data used only internally by the 
                 public or private (static) functions of the object and protected data
@@ -84,6 +103,7 @@ struct EOnvSet_hid
     eOnvset_brd_t                   theboard;
     eOnvset_protection_t            protection;
     eov_mutex_fn_mutexderived_new   mtxderived_new;
+    eObool_t                        dirtytracking;
 };   
  
 
@@ -44,7 +44,11 @@ extern "C" {
 
 
 // - #define used with hidden struct ----------------------------------------------------------------------------------
-// empty-section
+
+// the sequence counters of eo_nvset_protection_seqlock_per_netvar and the dirty flags need c11 atomics
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_ATOMICS__)
+    #define EONV_SEQLOCK_AVAILABLE
+#endif
 
 
 // - definition of the hidden struct implementing the object ----------------------------------------------------------
@@ -73,6 +77,8 @@ struct EOnv_hid                    // 28 bytes ...
     EOnv_rom_t*                     rom;        // pointer to the constant part common to every device which uses this nv
     void*                           ram;        // the ram which keeps the LOCAL value of nv 
     EOVmutexDerived*                mtx;        // the mutex which protects concurrent access to the ram of this nv 
+    void*                           dirty;      // if not NULL, the flag inside the EOnvSet which tells that ram has changed since last read by the transmitter. atomic if EONV_SEQLOCK_AVAILABLE
+    void*                           seqlock;    // if not NULL, the atomic sequence counter inside the EOnvSet which is used instead of mtx
 };  //EO_VERIFYsizeof(EOnv, 28)   
 
 
@@ -89,8 +95,21 @@ struct EOnv_hid                    // 28 bytes ...
 
 extern eOresult_t eo_nv_hid_Load(EOnv *nv, eOipv4addr_t ip, eOnvBRD_t brd, eObool_t proxied, eOnvID32_t id32, eOvoid_fp_cnvp_cropdesp_t onsay, EOnv_rom_t* rom, void* ram, EOVmutexDerived* mtx);
 
+extern void eo_nv_hid_LoadDirty(EOnv *nv, void* dirty);
+
+// with a sequence counter the readers of the ram never lock: they copy again if a writer has changed the ram
+// in the meantime. the writers are serialised amongst themselves by the counter.
+extern void eo_nv_hid_LoadSeqlock(EOnv *nv, void* seqlock);
+
 extern void eo_nv_hid_Fast_LocalMemoryGet(EOnv *nv, void* dest);
 
+// it copies the ram only if it was marked dirty (or if the nv does not have dirty tracking) and clears the mark.
+// the mark is cleared before the copy, so that a write which lands in the meantime marks the nv again.
+// it returns the number of copied bytes. 
+extern uint16_t eo_nv_hid_Fast_LocalMemoryGetIfDirty(EOnv *nv, void* dest);
+
+extern void eo_nv_hid_MarkDirty(const EOnv *nv);
+
 extern eObool_t eo_nv_hid_isWritable(const EOnv *netvar);
 extern eObool_t eo_nv_hid_isLocal(const EOnv *netvar);
 extern eObool_t eo_nv_hid_isUpdateable(const EOnv *netvar);
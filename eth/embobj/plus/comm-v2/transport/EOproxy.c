@@ -153,6 +153,7 @@ extern EOproxy* eo_proxy_New(const eOproxy_cfg_t *cfg)
     if(NULL != cfg->mutex_fn_new)
     {
         retptr->mtx = cfg->mutex_fn_new();
+        eov_mutex_SetName(retptr->mtx, "EOproxy");
     }
            
     return(retptr);       
@@ -24,8 +24,10 @@
 #include "EoCommon.h"
 #include "string.h"
 #include "EOtheMemoryPool.h"
+#include "EOtheErrorManager.h"
 #include "EOtheParser.h"
 #include "EOtheFormer.h"
+#include "EOropframe_hid.h"
 
 
 
@@ -71,12 +73,20 @@ static void s_eo_receiver_on_error_invalidframe(EOreceiver* p);
 
 static void s_eo_receiver_on_error_seqnumber(EOreceiver* p);
 
+static void s_eo_receiver_on_error_rop(eOparserResult_t parsres);
+
+static eOresult_t s_eo_receiver_rop_process(EOreceiver *p, eOipv4addr_t remipv4addr, eOreceiver_void_fp_obj_voidp_t onreplyfull, void *param);
+
+static uint16_t s_eo_receiver_delta_process(EOreceiver *p, const uint8_t *ropstream, uint16_t unparsed, eOipv4addr_t remipv4addr, eOreceiver_void_fp_obj_voidp_t onreplyfull, void *param, uint16_t *numofprocessedrops);
+
+static void s_eo_receiver_delta_deinit(EOreceiver *p);
+
 
 // --------------------------------------------------------------------------------------------------------------------
 // - definition (and initialisation) of static variables
 // --------------------------------------------------------------------------------------------------------------------
 
-//static const char s_eobj_ownname[] = "EOreceiver";
+static const char s_eobj_ownname[] = "EOreceiver";
 
 const eOreceiver_cfg_t eo_receiver_cfg_default = 
 {
@@ -127,6 +137,9 @@ extern EOreceiver* eo_receiver_New(const eOreceiver_cfg_t *cfg)
     memset(&retptr->error_invalidframe, 0, sizeof(retptr->error_invalidframe)); // even if it is already zero. 
     retptr->on_error_seqnumber  = cfg->extfn.onerrorseqnumber;
     retptr->on_error_invalidframe = cfg->extfn.onerrorinvalidframe;
+    memset(&retptr->delta, 0, sizeof(retptr->delta));
+    retptr->ropoffsets          = NULL;
+    retptr->capacityofropoffsets = 0;
     // now we need to allocate the buffer for the ropframereply
 
 #if defined(USE_DEBUG_EORECEIVER)    
@@ -152,6 +165,11 @@ extern void eo_receiver_Delete(EOreceiver *p)
         return;
     }
     
+    s_eo_receiver_delta_deinit(p);
+    if(NULL != p->ropoffsets)
+    {
+        eo_mempool_Delete(eo_mempool_GetHandle(), p->ropoffsets);
+    }
     eo_mempool_Delete(eo_mempool_GetHandle(), p->bufferropframereply);
     eo_rop_Delete(p->ropreply);
     eo_rop_Delete(p->ropinput);
@@ -168,14 +186,97 @@ extern void eo_receiver_Delete(EOreceiver *p)
 
 extern eOresult_t eo_receiver_Process(EOreceiver *p, EOpacket *packet, uint16_t *numberofrops, eObool_t *thereisareply, eOabstime_t *transmittedtime)
 {
-    uint16_t rxremainingbytes = 0;
-    uint16_t txremainingbytes = 0;
+    eOresult_t res;
+    
+    if((NULL == p) || (NULL == packet)) 
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    // clear the ropframereply w/ eo_ropframe_Clear(). the clear operation also makes it safe to manipulate p->ropframereplay with *_quickversion
+    
+    eo_ropframe_Clear(p->ropframereply);
+    
+    res = eo_receiver_ProcessAppend(p, packet, numberofrops, NULL, transmittedtime, NULL, NULL);
+    
+    // if any rop inside ropframereply w/ eo_ropframe_ROP_NumberOf() then sets thereisareply  
+    if(NULL != thereisareply)
+    {
+        *thereisareply = (0 == eo_ropframe_ROP_NumberOf(p->ropframereply)) ? (eobool_false) : (eobool_true);
+        // dont use the quickversion because it may be that ropframereply is dummy
+        //*thereisareply = (0 == eo_ropframe_ROP_NumberOf_quickversion(p->ropframereply)) ? (eobool_false) : (eobool_true);
+    } 
+    
+    return(res);
+}
+
+
+extern eOresult_t eo_receiver_ClearReply(EOreceiver *p)
+{
+    if(NULL == p) 
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    return(eo_ropframe_Clear(p->ropframereply));
+}
+
+
+extern eOresult_t eo_receiver_Delta_Set(EOreceiver *p, uint16_t capacity)
+{
+    uint8_t i = 0;
+    
+    if(NULL == p)
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    s_eo_receiver_delta_deinit(p);
+    
+    if(0 == capacity)
+    {
+        return(eores_OK);
+    }
+    
+    for(i=0; i<eo_receiver_delta_slots; i++)
+    {
+        p->delta.references[i].rops = (uint8_t*) eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_32bit, capacity, 1);
+        p->delta.references[i].size = 0;
+        p->delta.references[i].progressive = 0;
+    }
+    memset(&p->delta.statistics, 0, sizeof(p->delta.statistics));
+    p->delta.capacity = capacity;
+    
+    return(eores_OK);
+}
+
+
+extern eOresult_t eo_receiver_Delta_GetStatistics(EOreceiver *p, eOreceiver_deltastatistics_t *stats)
+{
+    if((NULL == p) || (NULL == stats))
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    *stats = p->delta.statistics;
+    
+    return(eores_OK);
+}
+
+
+extern eOresult_t eo_receiver_ProcessAppend(EOreceiver *p, EOpacket *packet, uint16_t *numberofrops, eObool_t *seqnumerror, eOabstime_t *transmittedtime, eOreceiver_void_fp_obj_voidp_t onreplyfull, void *param)
+{
     uint8_t* payload;
+    const uint8_t* rops = NULL;
+    const uint8_t* ropstream = NULL;
     uint16_t size;
     uint16_t capacity;
-    uint16_t nrops;
+    uint16_t nrops = 0;
+    uint16_t sizeofrops = 0;
+    uint16_t offset = 0;
+    uint16_t consumedbytes = 0;
     uint16_t i;
-    eOresult_t res;
+    eOparserResult_t parsres = eo_parser_res_ok;
     eOipv4addr_t remipv4addr;
     eOipv4port_t remipv4port;
     uint64_t rec_seqnum;
@@ -188,10 +289,10 @@ extern eOresult_t eo_receiver_Process(EOreceiver *p, EOpacket *packet, uint16_t
         return(eores_NOK_nullpointer);
     }
     
-    
-    // clear the ropframereply w/ eo_ropframe_Clear(). the clear operation also makes it safe to manipulate p->ropframereplay with *_quickversion
-    
-    eo_ropframe_Clear(p->ropframereply);
+    if(NULL != seqnumerror)
+    {
+        *seqnumerror = eobool_false;
+    }
     
     
     // we get the ip address and port of the incoming packet.
@@ -208,8 +309,16 @@ extern eOresult_t eo_receiver_Process(EOreceiver *p, EOpacket *packet, uint16_t
     eo_packet_Capacity_Get(packet, &capacity);
     eo_ropframe_Load(p->ropframeinput, payload, size, capacity);
     
-    // verify if the ropframeinput is valid w/ eo_ropframe_IsValid()
-    if(eobool_false == eo_ropframe_IsValid(p->ropframeinput))
+    // the offsets of the rops are allocated only once, for as many rops of the smallest size as the first packet can hold
+    if((NULL == p->ropoffsets) && (capacity > eo_ropframe_sizeforZEROrops))
+    {
+        p->capacityofropoffsets = (capacity - eo_ropframe_sizeforZEROrops) / sizeof(eOrophead_t);
+        p->ropoffsets = (uint16_t*) eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_16bit, sizeof(uint16_t), p->capacityofropoffsets);
+    }
+    
+    // verify if the ropframeinput is valid w/ eo_ropframe_Scan(). it checks every rop head, so that a malformed ropframe 
+    // is refused as a whole before any of its rops is processed, and it gives the offset of every rop
+    if(eores_OK != eo_ropframe_Scan(payload, size, p->ropoffsets, p->capacityofropoffsets, &nrops))
     {
 #if defined(USE_DEBUG_EORECEIVER)         
         {   // DEBUG
@@ -220,10 +329,6 @@ extern eOresult_t eo_receiver_Process(EOreceiver *p, EOpacket *packet, uint16_t
         p->error_invalidframe.ropframe = p->ropframeinput;
         s_eo_receiver_on_error_invalidframe(p);
         
-        if(NULL != thereisareply)
-        {
-            *thereisareply = eobool_false;
-        }
         return(eores_NOK_generic);
     }
     
@@ -256,54 +361,50 @@ extern eOresult_t eo_receiver_Process(EOreceiver *p, EOpacket *packet, uint16_t
             p->error_seqnumber.timeoftxofprevious = p->tx_ageofframe;
             
             s_eo_receiver_on_error_seqnumber(p);
+            
+            if(NULL != seqnumerror)
+            {
+                *seqnumerror = eobool_true;
+            }
         }
         p->rx_seqnum = rec_seqnum;
         p->tx_ageofframe = rec_ageoframe;
     }
     
 
-    nrops = eo_ropframe_ROP_NumberOf_quickversion(p->ropframeinput);
+    // the rops start just after the header, as the ropframeinput was just loaded
+    rops = eo_ropframe_hid_rops_next(p->ropframeinput, &sizeofrops);
     
     for(i=0; i<nrops; i++)
     {
-        // - get the rop w/ eo_ropframe_ROP_Parse()
-              
-        // if we have a valid ropinput the following eo_ropframe_ROP_Parse() returns OK. 
-        // in all cases rxremainingbytes contains the number of bytes we still need to parse. in case of 
-        // unrecoverable error in the ropframe res is NOK and rxremainingbytes is 0.
+        // the scan has already validated the rop heads: every rop is reached with its offset. if a packet bigger than 
+        // the first one has more rops than the offsets, the ones in excess are reached by their size
+        if(i < p->capacityofropoffsets)
+        {
+            offset = p->ropoffsets[i];
+        }
+        else if(offset >= sizeofrops)
+        {
+            break;
+        }
         
-        res = eo_ropframe_ROP_Parse(p->ropframeinput, p->ropinput, &rxremainingbytes);
-                
-        if(eores_OK == res)
+        ropstream = &rops[offset];
+        
+        if((0 != p->delta.capacity) && (eo_rop_version_delta == ((const eOrophead_t*)ropstream)->ctrl.version))
+        {   // - a delta rop carries many rops: they are decoded and processed one after another
+            consumedbytes = s_eo_receiver_delta_process(p, ropstream, sizeofrops - offset, remipv4addr, onreplyfull, param, &numofprocessedrops);
+        }
+        else if(eores_OK == eo_parser_GetROP(eo_parser_GetHandle(), ropstream, sizeofrops - offset, p->ropinput, &consumedbytes, &parsres))
         {   // we have a valid ropinput
-            
             numofprocessedrops++;
-
-            // - use the agent w/ eo_agent_InpROPprocess() and retrieve the ropreply.      
-            eo_agent_InpROPprocess(p->agent, p->ropinput, remipv4addr, p->ropreply);
-            
-            // - if ropreply is ok w/ eo_rop_GetROPcode() then add it to ropframereply w/ eo_ropframe_ROP_Add()           
-            if(eo_ropcode_none != eo_rop_GetROPcode(p->ropreply))
-            {
-                res = eo_ropframe_ROP_Add(p->ropframereply, p->ropreply, NULL, NULL, &txremainingbytes);
-                
-                #if defined(USE_DEBUG_EORECEIVER)             
-                {   // DEBUG
-                    if(eores_OK != res)
-                    {
-                        p->debug.lostreplies ++;
-                    }
-                }
-                #endif            
-            }
-        
+            s_eo_receiver_rop_process(p, remipv4addr, onreplyfull, param);
+        }
+        else
+        {   // the rop is legal but it cannot be handled: a delta rop when the decoding is disabled, or a rop bigger than ropinput
+            s_eo_receiver_on_error_rop(parsres);
         }
         
-        // we stop the decoding if rxremainingbytes has reached zero 
-        if(0 == rxremainingbytes)
-        {
-            break;
-        }        
+        offset += consumedbytes;
     }
 
     
@@ -311,14 +412,6 @@ extern eOresult_t eo_receiver_Process(EOreceiver *p, EOpacket *packet, uint16_t
     {
         *numberofrops = numofprocessedrops;
     }
-
-    // if any rop inside ropframereply w/ eo_ropframe_ROP_NumberOf() then sets thereisareply  
-    if(NULL != thereisareply)
-    {
-        *thereisareply = (0 == eo_ropframe_ROP_NumberOf(p->ropframereply)) ? (eobool_false) : (eobool_true);
-        // dont use the quickversion because it may be that ropframereply is dummy
-        //*thereisareply = (0 == eo_ropframe_ROP_NumberOf_quickversion(p->ropframereply)) ? (eobool_false) : (eobool_true);
-    } 
     
     if(NULL != transmittedtime)
     {
@@ -347,6 +440,19 @@ static void s_eo_receiver_on_error_seqnumber(EOreceiver* p)
 }
 
 
+static void s_eo_receiver_on_error_rop(eOparserResult_t parsres)
+{   // as eo_ropframe_ROP_Parse() does
+    eOerrmanDescriptor_t errdes = {0};
+    
+    errdes.code             = eo_errman_code_sys_ropparsingerror;
+    errdes.par16            = parsres;
+    errdes.sourcedevice     = eo_errman_sourcedevice_localboard;
+    errdes.sourceaddress    = 0;
+    
+    eo_errman_Error(eo_errman_GetHandle(), eo_errortype_error, "eo_receiver_ProcessAppend(): eo_parser_GetROP() had problems", s_eobj_ownname, &errdes);
+}
+
+
 extern eOresult_t eo_receiver_GetReply(EOreceiver *p, EOropframe **ropframereply)
 {
     if((NULL == p) || (NULL == ropframereply)) 
@@ -410,7 +516,120 @@ extern const eOreceiver_invalidframe_error_t * eo_receiver_GetInvalidFrameError(
 // --------------------------------------------------------------------------------------------------------------------
 // - definition of static functions 
 // --------------------------------------------------------------------------------------------------------------------
-// empty-section
+
+static eOresult_t s_eo_receiver_rop_process(EOreceiver *p, eOipv4addr_t remipv4addr, eOreceiver_void_fp_obj_voidp_t onreplyfull, void *param)
+{   // processes p->ropinput
+    uint16_t txremainingbytes = 0;
+    eOresult_t res = eores_OK;
+    
+    // - use the agent w/ eo_agent_InpROPprocess() and retrieve the ropreply.      
+    eo_agent_InpROPprocess(p->agent, p->ropinput, remipv4addr, p->ropreply);
+    
+    // - if ropreply is ok w/ eo_rop_GetROPcode() then add it to ropframereply w/ eo_ropframe_ROP_Add()           
+    if(eo_ropcode_none != eo_rop_GetROPcode(p->ropreply))
+    {
+        res = eo_ropframe_ROP_Add(p->ropframereply, p->ropreply, NULL, NULL, &txremainingbytes);
+        
+        if((eores_OK != res) && (NULL != onreplyfull) && (0 != eo_ropframe_ROP_NumberOf(p->ropframereply)))
+        {   // the reply frame is full of replies to previous rops. we ask to empty it and we try again
+            onreplyfull(p, param);
+            res = eo_ropframe_ROP_Add(p->ropframereply, p->ropreply, NULL, NULL, &txremainingbytes);
+        }
+        
+        #if defined(USE_DEBUG_EORECEIVER)             
+        {   // DEBUG
+            if(eores_OK != res)
+            {
+                p->debug.lostreplies ++;
+            }
+        }
+        #endif            
+    }
+    
+    return(res);
+}
+
+
+static uint16_t s_eo_receiver_delta_process(EOreceiver *p, const uint8_t *ropstream, uint16_t unparsed, eOipv4addr_t remipv4addr, eOreceiver_void_fp_obj_voidp_t onreplyfull, void *param, uint16_t *numofprocessedrops)
+{   // it returns the size of the delta rop
+    const eOropdeltahead_t *deltahead = (const eOropdeltahead_t*)ropstream;
+    eo_receiver_delta_reference_t *reference = NULL;
+    uint8_t slot = 0;
+    uint16_t deltasize = 0;
+    uint16_t consumedbytes = 0;
+    uint16_t offset = 0;
+    eOparserResult_t result = eo_parser_res_ok;
+    
+    if(unparsed < sizeof(eOropdeltahead_t))
+    {
+        p->delta.statistics.discarded ++;
+        return(unparsed);
+    }
+    
+    slot = deltahead->slot & ~eo_rop_delta_keyframe;
+    reference = (slot < eo_receiver_delta_slots) ? (&p->delta.references[slot]) : (NULL);
+    
+    // a delta which is not a key frame can be decoded only over the rops of the previous delta of its slot
+    if((NULL == reference) || 
+       ((eo_rop_delta_keyframe != (deltahead->slot & eo_rop_delta_keyframe)) && 
+        ((reference->size != deltahead->decodedsize) || ((uint8_t)(reference->progressive + 1) != deltahead->progressive))))
+    {
+        p->delta.statistics.discarded ++;
+        if(NULL != reference)
+        {
+            reference->size = 0;
+        }
+        deltasize = sizeof(eOropdeltahead_t) + eo_rop_datafield_effective_size(deltahead->dsiz);
+        return((deltasize < unparsed) ? (deltasize) : (unparsed));
+    }
+    
+    if(eores_OK != eo_parser_GetDeltaROPs(eo_parser_GetHandle(), ropstream, unparsed, reference->rops, p->delta.capacity, &deltasize, &result))
+    {   // the reference is lost until next key frame
+        p->delta.statistics.discarded ++;
+        reference->size = 0;
+        return(deltasize);
+    }
+    
+    p->delta.statistics.decoded ++;
+    reference->size = deltahead->decodedsize;
+    reference->progressive = deltahead->progressive;
+    
+    // the decoded rops are parsed and processed as they were inside the ropframe
+    while(offset < reference->size)
+    {
+        if(eores_OK == eo_parser_GetROP(eo_parser_GetHandle(), &reference->rops[offset], reference->size - offset, p->ropinput, &consumedbytes, &result))
+        {
+            (*numofprocessedrops)++;
+            s_eo_receiver_rop_process(p, remipv4addr, onreplyfull, param);
+        }
+        
+        if(0 == consumedbytes)
+        {
+            break;
+        }
+        offset += consumedbytes;
+    }
+    
+    return(deltasize);
+}
+
+
+static void s_eo_receiver_delta_deinit(EOreceiver *p)
+{
+    uint8_t i = 0;
+    
+    if(0 != p->delta.capacity)
+    {
+        for(i=0; i<eo_receiver_delta_slots; i++)
+        {
+            eo_mempool_Delete(eo_mempool_GetHandle(), p->delta.references[i].rops);
+            p->delta.references[i].rops = NULL;
+            p->delta.references[i].size = 0;
+        }
+    }
+    
+    p->delta.capacity = 0;
+}
 
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -91,6 +91,9 @@ typedef struct
 
 typedef void (*eOreceiver_void_fp_obj_t) (EOreceiver *);
 
+// it must empty the reply ropframe (e.g., by moving its rops elsewhere and by calling eo_receiver_ClearReply()) 
+typedef void (*eOreceiver_void_fp_obj_voidp_t) (EOreceiver *, void *);
+
 typedef struct
 {
     eOreceiver_void_fp_obj_t    onerrorseqnumber;       // argument is: EOreceiver*  
@@ -105,6 +108,13 @@ typedef struct
 } eOreceiver_cfg_t;
 
 
+typedef struct
+{
+    uint32_t        decoded;        // the delta rops which were decoded
+    uint32_t        discarded;      // the delta rops which were not decoded because their reference was missing or they were illegal
+} eOreceiver_deltastatistics_t;
+
+
     
 // - declaration of extern public variables, ... but better using use _get/_set instead -------------------------------
 
@@ -154,6 +164,46 @@ extern eOresult_t eo_receiver_Process(EOreceiver *p, EOpacket *packet, uint16_t
  **/
 extern eOresult_t eo_receiver_GetReply(EOreceiver *p, EOropframe **ropframereply);
 
+
+/** @fn         extern eOresult_t eo_receiver_ProcessAppend(EOreceiver *p, EOpacket *packet, uint16_t *numberofrops, eObool_t *seqnumerror, eOabstime_t *transmittedtime, eOreceiver_void_fp_obj_voidp_t onreplyfull, void *param)
+    @brief      Same as eo_receiver_Process() but the reply ROPs are appended to those already inside the reply frame, so that
+                the replies to many packets can be retrieved at once with eo_receiver_GetReply(). If a reply ROP does not fit
+                inside a non-empty reply frame, then onreplyfull(p, param) is called so that it empties the frame.
+    @param      p               the object.
+    @param      packet          the received packet
+    @param      numberofrops    if not NULL it contains the number of processed ROPs
+    @param      seqnumerror     if not NULL it tells if the packet had a sequence number error
+    @param      transmittedtime if not NULL it contains the age of the received frame
+    @param      onreplyfull     it can be NULL. in such a case the reply ROPs which do not fit are lost.
+    @param      param           the second argument of onreplyfull 
+    @return     eores_OK only if the packet is valid and contains a valid ropframe, even if empty. eores_NOK_nullpointer or
+                eores_NOK_generic in case of errors.
+ **/
+extern eOresult_t eo_receiver_ProcessAppend(EOreceiver *p, EOpacket *packet, uint16_t *numberofrops, eObool_t *seqnumerror, eOabstime_t *transmittedtime, eOreceiver_void_fp_obj_voidp_t onreplyfull, void *param);
+
+
+/** @fn         extern eOresult_t eo_receiver_Delta_Set(EOreceiver *p, uint16_t capacity)
+    @brief      Enables the decoding of the delta rops sent by a remote transmitter which uses eo_transmitter_regular_rops_Delta_Set().
+                The rops carried by a delta rop are processed as if they were inside the ropframe in its place. A delta rop 
+                whose reference was lost, for instance because a packet was lost, is discarded until the next key frame.
+    @param      p               the object.
+    @param      capacity        the max size of the rops carried by a delta rop, for instance the capacity of the remote 
+                                transmitter packet. if 0, the decoding is disabled and the delta rops are refused.
+    @return     eores_OK or eores_NOK_nullpointer
+ **/
+extern eOresult_t eo_receiver_Delta_Set(EOreceiver *p, uint16_t capacity);
+
+
+extern eOresult_t eo_receiver_Delta_GetStatistics(EOreceiver *p, eOreceiver_deltastatistics_t *stats);
+
+
+/** @fn         extern eOresult_t eo_receiver_ClearReply(EOreceiver *p)
+    @brief      removes all the ROPs from the reply frame.
+    @param      p               the object.
+    @return     eores_OK or eores_NOK_nullpointer.
+ **/
+extern eOresult_t eo_receiver_ClearReply(EOreceiver *p);
+
 extern const eOreceiver_seqnum_error_t * eo_receiver_GetSequenceNumberError(EOreceiver *p);
 
 extern const eOreceiver_invalidframe_error_t * eo_receiver_GetInvalidFrameError(EOreceiver *p);
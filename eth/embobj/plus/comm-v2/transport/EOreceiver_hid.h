@@ -54,6 +54,25 @@ extern "C" {
 // - definition of the hidden struct implementing the object ----------------------------------------------------------
 
 
+enum { eo_receiver_delta_slots = 3 };
+
+
+typedef struct
+{
+    uint8_t*    rops;           // the rops decoded from the last delta rop of the slot
+    uint16_t    size;           // 0 if they are not valid
+    uint8_t     progressive;
+} eo_receiver_delta_reference_t;
+
+
+typedef struct
+{
+    uint16_t                        capacity;   // 0 if the decoding is disabled
+    eo_receiver_delta_reference_t   references[eo_receiver_delta_slots];
+    eOreceiver_deltastatistics_t    statistics;
+} eo_receiver_delta_t;
+
+
 typedef struct
 {
     uint32_t    rxinvalidropframes; 
@@ -83,6 +102,9 @@ struct EOreceiver_hid
     eOreceiver_invalidframe_error_t error_invalidframe;
     eOreceiver_void_fp_obj_t    on_error_seqnumber;    
     eOreceiver_void_fp_obj_t    on_error_invalidframe;
+    eo_receiver_delta_t         delta;
+    uint16_t*                   ropoffsets;             // the offsets of the rops of ropframeinput given by eo_ropframe_Scan()
+    uint16_t                    capacityofropoffsets;   // it is set by the capacity of the first received packet
 #if defined(USE_DEBUG_EORECEIVER)      
     EOreceiverDEBUG_t           debug;
 #endif    
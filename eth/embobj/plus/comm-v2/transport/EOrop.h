@@ -142,6 +142,30 @@ typedef struct
 } eOrophead_t;      EO_VERIFYsizeof(eOrophead_t, 8)
 
 
+/** @typedef struct eOropdeltahead_t
+    @brief      contains the head of a delta rop, which carries some regular rops encoded as a delta against the ones carried
+                by the previous delta rop with the same slot. it has the same size of eOrophead_t, it has ropc = eo_ropcode_sig 
+                and dsiz in the same position, so that its size is computed as for any other rop. it has ctrl.version equal to
+                eo_rop_version_delta, so that a receiver which does not manage the delta encoding refuses it. the data is formed 
+                by eo_former_GetDeltaStream() and is decoded by eo_parser_GetDeltaROPs().
+ **/
+typedef struct
+{
+    eOropctrl_t     ctrl;
+    eOropcode_t     ropc;
+    uint16_t        dsiz;           // the size of the encoded data
+    uint16_t        decodedsize;    // the size of the regular rops after decoding
+    uint8_t         slot;           // bits 0-6: the slot of the reference. bit 7: eo_rop_delta_keyframe
+    uint8_t         progressive;    // it is incremented at every delta rop of the same slot
+} eOropdeltahead_t;     EO_VERIFYsizeof(eOropdeltahead_t, 8)
+
+
+enum { eo_rop_version_delta = 1 };
+
+// if set inside eOropdeltahead_t::slot the delta is computed against zero bytes, so that it does not need a reference
+enum { eo_rop_delta_keyframe = 0x80 };
+
+
 
 
 // the minimum size is just an header (e.g., the ask command)
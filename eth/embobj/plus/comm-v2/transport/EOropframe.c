@@ -343,6 +343,101 @@ extern eObool_t eo_ropframe_IsValid(EOropframe *p)
     return(eobool_true);
 }
 
+extern eOresult_t eo_ropframe_Scan(const uint8_t *framedata, uint16_t framesize, uint16_t *ropoffsets, uint16_t capacity, uint16_t *numberofrops)
+{
+    const EOropframeHeader_t *header = (const EOropframeHeader_t*)framedata;
+    const uint8_t *rops = NULL;
+    uint32_t endoframe = 0;
+    uint32_t word = 0;
+    uint32_t sizeofrops = 0;
+    uint32_t offset = 0;
+    uint32_t ropsize = 0;
+    uint16_t dsiz = 0;
+    uint16_t n = 0;
+    uint8_t ctrlbyte = 0;
+    eOropctrl_t ctrl = {0};
+    eOropcode_t ropc = eo_ropcode_none;
+    
+    if(NULL == framedata)
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    if((framesize < eo_ropframe_sizeforZEROrops) || (EOFRAME_START != header->startofframe))
+    {
+        return(eores_NOK_generic);
+    }
+    
+    sizeofrops = header->ropssizeof;
+    
+    if((eo_ropframe_sizeforZEROrops + sizeofrops) > framesize)
+    {
+        return(eores_NOK_generic);
+    }
+    
+    rops = &framedata[sizeof(EOropframeHeader_t)];
+    memcpy(&endoframe, &rops[sizeofrops], sizeof(endoframe));
+    if(EOFRAME_END != endoframe)
+    {
+        return(eores_NOK_generic);
+    }
+    
+    while(offset < sizeofrops)
+    {
+        if((sizeofrops - offset) < sizeof(eOrophead_t))
+        {
+            return(eores_NOK_generic);
+        }
+        
+        // ctrl, ropc and dsiz are the first word of the head: we load them at once. the rops are little endian
+        memcpy(&word, &rops[offset], sizeof(word));
+        ctrlbyte = (uint8_t)(word & 0xff);
+        memcpy(&ctrl, &ctrlbyte, sizeof(ctrl));
+        ropc = (eOropcode_t)((word >> 8) & 0xff);
+        dsiz = (uint16_t)(word >> 16);
+        
+        if((ctrl.version > eo_rop_version_delta) || (eobool_false == eo_rop_ropcode_is_valid(ropc)))
+        {
+            return(eores_NOK_generic);
+        }
+        
+        // as in eo_parser_GetROP(): a rop which requires the data field must have it
+        if((0 == dsiz) && (eo_ropconf_none == ctrl.confinfo) && (eobool_true == eo_rop_ropcode_has_data(ropc)))
+        {
+            return(eores_NOK_generic);
+        }
+        
+        // in 32 bits, so that a dsiz close to 64k cannot wrap around
+        ropsize = sizeof(eOrophead_t) + (((uint32_t)dsiz + 3) & ~3u) + ((1 == ctrl.plussign) ? (4) : (0)) + ((1 == ctrl.plustime) ? (8) : (0));
+        
+        if(ropsize > (sizeofrops - offset))
+        {
+            return(eores_NOK_generic);
+        }
+        
+        if((NULL != ropoffsets) && (n < capacity))
+        {
+            ropoffsets[n] = (uint16_t)offset;
+        }
+        
+        n++;
+        offset += ropsize;
+    }
+    
+    if(n != header->ropsnumberof)
+    {
+        return(eores_NOK_generic);
+    }
+    
+    if(NULL != numberofrops)
+    {
+        *numberofrops = n;
+    }
+    
+    return(eores_OK);
+}
+
+
 extern uint16_t eo_ropframe_ROP_NumberOf(EOropframe *p)
 {
     if(eobool_false == eo_ropframe_IsValid(p))
@@ -763,6 +858,141 @@ uint8_t* eo_ropframe_hid_get_pointer_offset(EOropframe *p, uint16_t offset)
 }
 
 
+uint16_t eo_ropframe_hid_ropsize(const uint8_t *rop)
+{
+    const eOrophead_t *head = (const eOrophead_t*)rop;
+    uint16_t ropsize = sizeof(eOrophead_t);
+    
+    if(eobool_true == eo_rop_datafield_is_present(head))
+    {
+        ropsize += eo_rop_datafield_effective_size(head->dsiz);
+    }
+    if(1 == head->ctrl.plussign)
+    {
+        ropsize += 4;
+    }
+    if(1 == head->ctrl.plustime)
+    {
+        ropsize += 8;
+    }
+    
+    return(ropsize);
+}
+
+
+uint16_t eo_ropframe_hid_rops_fit(EOropframe *p, uint16_t maxbytes, uint16_t *numberofrops, uint16_t *sizeofnext)
+{
+    const uint8_t *rops = s_eo_ropframe_rops_get(p);
+    uint16_t sizeofrops = s_eo_ropframe_sizeofrops_get(p);
+    uint16_t size = 0;
+    uint16_t n = 0;
+    
+    *sizeofnext = 0;
+    
+    while(size < sizeofrops)
+    {   // the rops inside a ropframe are legal, as they were formed by the EOtheFormer: we dont check them again
+        uint16_t ropsize = eo_ropframe_hid_ropsize(&rops[size]);
+        
+        if((size + ropsize) > maxbytes)
+        {
+            *sizeofnext = ropsize;
+            break;
+        }
+        
+        size += ropsize;
+        n++;
+    }
+    
+    *numberofrops = n;
+    
+    return(size);
+}
+
+
+eOresult_t eo_ropframe_hid_rops_append(EOropframe *p, const uint8_t *rops, uint16_t numberofrops, uint16_t sizeofrops)
+{
+    uint16_t p_sizeofrops = s_eo_ropframe_sizeofrops_get(p);
+    
+    if(0 == sizeofrops)
+    {
+        return(eores_OK);
+    }
+    
+    if(p->capacity < (eo_ropframe_sizeforZEROrops+p_sizeofrops+sizeofrops))
+    {
+        return(eores_NOK_generic);
+    }
+    
+    memcpy(s_eo_ropframe_rops_get(p)+p_sizeofrops, rops, sizeofrops);
+    p->size += sizeofrops;
+    s_eo_ropframe_header_addrops(p, numberofrops, sizeofrops);
+    s_eo_ropframe_footer_adjust(p);
+    
+    return(eores_OK);
+}
+
+
+eOresult_t eo_ropframe_hid_rops_removehead(EOropframe *p, uint16_t numberofrops, uint16_t sizeofrops)
+{
+    EOropframeHeader_t* header = s_eo_ropframe_header_get(p);
+    uint16_t remaining = s_eo_ropframe_sizeofrops_get(p) - sizeofrops;
+    
+    if(0 == sizeofrops)
+    {
+        return(eores_OK);
+    }
+    
+    memmove(s_eo_ropframe_rops_get(p), s_eo_ropframe_rops_get(p)+sizeofrops, remaining);
+    p->size -= sizeofrops;
+    header->ropssizeof -= sizeofrops;
+    header->ropsnumberof -= numberofrops;
+    s_eo_ropframe_footer_adjust(p);
+    
+    return(eores_OK);
+}
+
+
+eOresult_t eo_ropframe_hid_rops_removetail(EOropframe *p, uint16_t numberofrops, uint16_t sizeofrops)
+{
+    EOropframeHeader_t* header = s_eo_ropframe_header_get(p);
+    
+    if(0 == sizeofrops)
+    {
+        return(eores_OK);
+    }
+    
+    if(sizeofrops > header->ropssizeof)
+    {
+        return(eores_NOK_generic);
+    }
+    
+    p->size -= sizeofrops;
+    header->ropssizeof -= sizeofrops;
+    header->ropsnumberof -= numberofrops;
+    s_eo_ropframe_footer_adjust(p);
+    
+    return(eores_OK);
+}
+
+
+uint8_t* eo_ropframe_hid_rops_next(EOropframe *p, uint16_t *unparsedbytes)
+{
+    uint16_t unparsed = s_eo_ropframe_sizeofrops_get(p) - p->index2nextrop2beparsed;
+    
+    *unparsedbytes = unparsed;
+    
+    return((0 == unparsed) ? (NULL) : (s_eo_ropframe_rops_get(p) + p->index2nextrop2beparsed));
+}
+
+
+uint16_t eo_ropframe_hid_rops_skip(EOropframe *p, uint16_t consumedbytes)
+{
+    p->index2nextrop2beparsed += consumedbytes;
+    
+    return(s_eo_ropframe_sizeofrops_get(p) - p->index2nextrop2beparsed);
+}
+
+
 
 
 
@@ -105,6 +105,21 @@ extern eOresult_t eo_ropframe_Append(EOropframe *p, EOropframe *rfr, uint16_t *r
 
 extern eObool_t eo_ropframe_IsValid(EOropframe *p);
 
+/** @fn         extern eOresult_t eo_ropframe_Scan(const uint8_t *framedata, uint16_t framesize, uint16_t *ropoffsets, uint16_t capacity, uint16_t *numberofrops)
+    @brief      validates a received ropframe in a single pass without copying any rop: the start and end codes, a 
+                legal head for every rop (version, ropcode, data field), the sum of the sizes of the rops against the 
+                size in the header and inside framesize, the number of rops against the number in the header.
+                if ropoffsets is not NULL it gets the offset of each rop from the beginning of the rops, so that 
+                the rops can be reached directly. only the first capacity offsets are written.
+    @param      framedata       the ropframe, for instance the payload of a received packet
+    @param      framesize       the size of framedata
+    @param      ropoffsets      it can be NULL
+    @param      capacity        the number of items of ropoffsets
+    @param      numberofrops    if not NULL, in output it contains the number of rops
+    @return     eores_OK if the ropframe is valid, eores_NOK_generic if not, eores_NOK_nullpointer if framedata is NULL.
+ **/
+extern eOresult_t eo_ropframe_Scan(const uint8_t *framedata, uint16_t framesize, uint16_t *ropoffsets, uint16_t capacity, uint16_t *numberofrops);
+
 extern uint16_t eo_ropframe_ROP_NumberOf(EOropframe *p);
 
 // does not check anything about p safety
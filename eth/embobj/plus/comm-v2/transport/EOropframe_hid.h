@@ -117,6 +117,28 @@ struct EOropframe_hid
 
 uint8_t* eo_ropframe_hid_get_pointer_offset(EOropframe *p, uint16_t offset);
 
+// returns the size of the rop which starts at rop, as the EOtheFormer has formed it
+uint16_t eo_ropframe_hid_ropsize(const uint8_t *rop);
+
+// returns the size of the first rops of the ropframe which fit inside maxbytes. their number is in numberofrops and 
+// the size of the rop which follows them is in sizeofnext (0 if all the rops fit).
+uint16_t eo_ropframe_hid_rops_fit(EOropframe *p, uint16_t maxbytes, uint16_t *numberofrops, uint16_t *sizeofnext);
+
+// appends a stream of whole rops, such as the first rops of another ropframe
+eOresult_t eo_ropframe_hid_rops_append(EOropframe *p, const uint8_t *rops, uint16_t numberofrops, uint16_t sizeofrops);
+
+// removes the first rops of the ropframe. use eo_ropframe_hid_rops_fit() to get numberofrops and sizeofrops
+eOresult_t eo_ropframe_hid_rops_removehead(EOropframe *p, uint16_t numberofrops, uint16_t sizeofrops);
+
+// removes the last rops of the ropframe, such as the ones just added with eo_ropframe_hid_rops_append()
+eOresult_t eo_ropframe_hid_rops_removetail(EOropframe *p, uint16_t numberofrops, uint16_t sizeofrops);
+
+// returns the next rop which eo_ropframe_ROP_Parse() would parse and the bytes still to be parsed, or NULL if there are none
+uint8_t* eo_ropframe_hid_rops_next(EOropframe *p, uint16_t *unparsedbytes);
+
+// moves the parsing beyond consumedbytes, as eo_ropframe_ROP_Parse() does. it returns the bytes still to be parsed
+uint16_t eo_ropframe_hid_rops_skip(EOropframe *p, uint16_t consumedbytes);
+
 
 
 #ifdef __cplusplus
@@ -66,6 +66,7 @@
 // - declaration of static functions
 // --------------------------------------------------------------------------------------------------------------------
 
+static uint8_t s_eo_former_delta_get(const uint8_t *rops, const uint8_t *reference, eObool_t keyframe, uint16_t i);
 
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -179,6 +180,90 @@ extern eOresult_t eo_former_GetStream(EOtheFormer *p, const EOrop *rop, const ui
 }
 
 
+extern eOresult_t eo_former_GetDeltaStream(EOtheFormer *p, const eOropdeltahead_t *head, const uint8_t *rops, const uint8_t *reference, const uint16_t streamcapacity, uint8_t *streamdata, uint16_t *streamsize)
+{
+    eOropdeltahead_t *deltahead = (eOropdeltahead_t*)streamdata;
+    uint8_t *encoded = &streamdata[sizeof(eOropdeltahead_t)];
+    uint16_t size = 0;
+    uint16_t i = 0;
+    uint16_t n = 0;
+    eObool_t keyframe = eobool_false;
+
+    if((NULL == p) || (NULL == head) || (NULL == rops) || (NULL == streamdata) || (NULL == streamsize))
+    {    
+        return(eores_NOK_nullpointer);
+    }
+    
+    keyframe = (eo_rop_delta_keyframe == (head->slot & eo_rop_delta_keyframe)) ? (eobool_true) : (eobool_false);
+    
+    if((eobool_false == keyframe) && (NULL == reference))
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    if(streamcapacity < sizeof(eOropdeltahead_t))
+    {
+        return(eores_NOK_generic);
+    }
+    
+    while(i < head->decodedsize)
+    {
+        // n counts the unchanged bytes which start in i
+        for(n=0; ((i+n) < head->decodedsize) && (n < 128) && (s_eo_former_delta_get(rops, reference, keyframe, i+n) == 0); n++);
+        
+        if(0 != n)
+        {
+            if((sizeof(eOropdeltahead_t) + size + 1) > streamcapacity)
+            {
+                return(eores_NOK_generic);
+            }
+            encoded[size++] = (uint8_t)(n - 1);
+            i += n;
+            continue;
+        }
+        
+        // n counts the changed bytes which start in i. a single unchanged byte stays inside them, as it costs less than a run
+        for(n=1; ((i+n) < head->decodedsize) && (n < 128); n++)
+        {
+            if((0 == s_eo_former_delta_get(rops, reference, keyframe, i+n)) && 
+               (((i+n+1) == head->decodedsize) || (0 == s_eo_former_delta_get(rops, reference, keyframe, i+n+1))))
+            {
+                break;
+            }
+        }
+        
+        if((sizeof(eOropdeltahead_t) + size + 1 + n) > streamcapacity)
+        {
+            return(eores_NOK_generic);
+        }
+        encoded[size++] = (uint8_t)(0x80 | (n - 1));
+        for(; n>0; n--, i++)
+        {
+            encoded[size++] = s_eo_former_delta_get(rops, reference, keyframe, i);
+        }
+    }
+    
+    // the data field is padded to a multiple of four as in any other rop
+    if((sizeof(eOropdeltahead_t) + eo_rop_datafield_effective_size(size)) > streamcapacity)
+    {
+        return(eores_NOK_generic);
+    }
+    memset(&encoded[size], 0, eo_rop_datafield_effective_size(size) - size);
+    
+    memcpy(deltahead, &eok_ropctrl_basic, sizeof(eOropctrl_t));
+    deltahead->ctrl.version = eo_rop_version_delta;
+    deltahead->ropc = eo_ropcode_sig;
+    deltahead->dsiz = size;
+    deltahead->decodedsize = head->decodedsize;
+    deltahead->slot = head->slot;
+    deltahead->progressive = head->progressive;
+    
+    *streamsize = sizeof(eOropdeltahead_t) + eo_rop_datafield_effective_size(size);
+    
+    return(eores_OK);
+}
+
+
 // --------------------------------------------------------------------------------------------------------------------
 // - definition of extern hidden functions 
 // --------------------------------------------------------------------------------------------------------------------
@@ -189,7 +274,11 @@ extern eOresult_t eo_former_GetStream(EOtheFormer *p, const EOrop *rop, const ui
 // --------------------------------------------------------------------------------------------------------------------
 // - definition of static functions 
 // --------------------------------------------------------------------------------------------------------------------
-// empty-section
+
+static uint8_t s_eo_former_delta_get(const uint8_t *rops, const uint8_t *reference, eObool_t keyframe, uint16_t i)
+{
+    return((eobool_true == keyframe) ? (rops[i]) : (rops[i] ^ reference[i]));
+}
 
 
 
@@ -104,6 +104,22 @@ extern EOtheFormer * eo_former_GetHandle(void);
 extern eOresult_t eo_former_GetStream(EOtheFormer *p, const EOrop *rop, const uint16_t streamcapacity, uint8_t *streamdata, uint16_t *streamsize);
 
 
+/** @fn         extern eOresult_t eo_former_GetDeltaStream(EOtheFormer *p, const eOropdeltahead_t *head, const uint8_t *rops, const uint8_t *reference, const uint16_t streamcapacity, uint8_t *streamdata, uint16_t *streamsize)
+    @brief      Builds a delta rop which carries head->decodedsize bytes of rops. the data of the delta rop is the XOR of rops 
+                with reference (or with zero bytes for a key frame) encoded in runs: a byte 0x00-0x7F is followed by nothing 
+                and tells that the next 1-128 bytes are unchanged, a byte 0x80-0xFF is followed by the 1-128 XOR bytes it counts.
+    @param      p               The former.
+    @param      head            The head of the delta rop. only its fields decodedsize, slot and progressive are used.
+    @param      rops            The rops to encode.
+    @param      reference       The rops that the receiver already has, of the same size. it is not used for a key frame.
+    @param      streamcapacity  The capacity of the streamdata array (its allocated size)
+    @param      streamdata      The stream of the delta rop
+    @param      streamsize      The size of the stream
+    @return     Normally eores_OK, eores_NOK_generic if the delta rop does not fit inside streamcapacity.
+ **/
+extern eOresult_t eo_former_GetDeltaStream(EOtheFormer *p, const eOropdeltahead_t *head, const uint8_t *rops, const uint8_t *reference, const uint16_t streamcapacity, uint8_t *streamdata, uint16_t *streamsize);
+
+
 
 
 /** @}            
@@ -270,6 +270,96 @@ extern eOresult_t eo_parser_GetROP(EOtheParser *p, const uint8_t *streamdata, co
 }
 
 
+extern eOresult_t eo_parser_GetDeltaROPs(EOtheParser *p, const uint8_t *streamdata, const uint16_t streamsize, uint8_t *reference, const uint16_t referencecapacity, uint16_t *consumedbytes, eOparserResult_t *result)
+{
+    const eOropdeltahead_t *deltahead = (const eOropdeltahead_t*)streamdata;
+    const uint8_t *encoded = &streamdata[sizeof(eOropdeltahead_t)];
+    uint16_t parsedropsize = 0;
+    uint16_t i = 0;
+    uint16_t size = 0;
+    uint16_t n = 0;
+
+    if((NULL == p) || (NULL == streamdata) || (NULL == reference) || (NULL == consumedbytes) || (NULL == result))
+    {
+        if(NULL != result)
+        {
+            *result = eo_parser_res_nok_fatal;
+        }
+        return(eores_NOK_nullpointer);
+    }
+    
+    *consumedbytes = streamsize;
+    *result = eo_parser_res_nok_ropisillegal;
+    
+    if(streamsize < sizeof(eOropdeltahead_t))
+    {
+        *result = eo_parser_res_nok_nostreamdata;
+        return(eores_NOK_generic);
+    }
+    
+    if((eo_rop_version_delta != deltahead->ctrl.version) || (eo_ropcode_sig != deltahead->ropc) || 
+       (1 == deltahead->ctrl.plussign) || (1 == deltahead->ctrl.plustime))
+    {
+        return(eores_NOK_generic);
+    }
+    
+    parsedropsize = sizeof(eOropdeltahead_t) + eo_rop_datafield_effective_size(deltahead->dsiz);
+    
+    if(streamsize < parsedropsize)
+    {
+        return(eores_NOK_generic);
+    }
+    
+    // from now on a failure concerns only this rop
+    *consumedbytes = parsedropsize;
+    
+    if(referencecapacity < deltahead->decodedsize)
+    {
+        *result = eo_parser_res_nok_ropistoobig;
+        return(eores_NOK_generic);
+    }
+    
+    if(eo_rop_delta_keyframe == (deltahead->slot & eo_rop_delta_keyframe))
+    {
+        memset(reference, 0, deltahead->decodedsize);
+    }
+    
+    while(size < deltahead->dsiz)
+    {
+        n = (encoded[size] & 0x7f) + 1;
+        
+        if((i + n) > deltahead->decodedsize)
+        {
+            return(eores_NOK_generic);
+        }
+        
+        if(0 == (encoded[size++] & 0x80))
+        {   // unchanged bytes
+            i += n;
+            continue;
+        }
+        
+        if((size + n) > deltahead->dsiz)
+        {
+            return(eores_NOK_generic);
+        }
+        
+        for(; n>0; n--)
+        {
+            reference[i++] ^= encoded[size++];
+        }
+    }
+    
+    if(i != deltahead->decodedsize)
+    {
+        return(eores_NOK_generic);
+    }
+    
+    *result = eo_parser_res_ok;
+    return(eores_OK);
+}
+
+
 
 
 
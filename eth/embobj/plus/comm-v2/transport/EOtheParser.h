@@ -107,6 +107,22 @@ extern EOtheParser * eo_parser_GetHandle(void);
 extern eOresult_t eo_parser_GetROP(EOtheParser *p, const uint8_t *streamdata, const uint16_t streamsize, EOrop *rop, uint16_t *consumedbytes, eOparserResult_t *result);
 
 
+/** @fn         extern eOresult_t eo_parser_GetDeltaROPs(EOtheParser *p, const uint8_t *streamdata, const uint16_t streamsize, uint8_t *reference, const uint16_t referencecapacity, uint16_t *consumedbytes, eOparserResult_t *result)
+    @brief      Decodes a delta rop formed by eo_former_GetDeltaStream(). the caller must verify with the eOropdeltahead_t at the 
+                beginning of streamdata that reference contains the rops of the previous delta rop of the same slot, unless 
+                the delta rop is a key frame. 
+    @param      streamdata          The input data, which starts with a eOropdeltahead_t
+    @param      streamsize          The size of the input data
+    @param      reference           The rops of the previous delta rop of the same slot. they are changed in the decoded rops,
+                                    which are eOropdeltahead_t::decodedsize bytes. in case of failure they are lost.
+    @param      referencecapacity   The capacity of reference
+    @param      consumedbytes       The number of bytes used by the delta rop.
+    @return     eores_OK if reference contains the decoded rops, eores_NOK_generic if the delta rop is not valid, 
+                eores_NOK_nullpointer if any is a NULL pointer.
+ **/
+extern eOresult_t eo_parser_GetDeltaROPs(EOtheParser *p, const uint8_t *streamdata, const uint16_t streamsize, uint8_t *reference, const uint16_t referencecapacity, uint16_t *consumedbytes, eOparserResult_t *result);
+
+
 
 
 
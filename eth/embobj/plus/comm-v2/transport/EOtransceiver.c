@@ -69,7 +69,8 @@
 // --------------------------------------------------------------------------------------------------------------------
 // - declaration of static functions
 // --------------------------------------------------------------------------------------------------------------------
-// empty-section    
+
+static void s_eo_transceiver_onreplyfull(EOreceiver *receiver, void *param);
 
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -354,6 +355,62 @@ extern eOresult_t eo_transceiver_Receive(EOtransceiver *p, EOpacket *pkt, uint16
     return(res);
 }
 
+extern eOresult_t eo_transceiver_ReceiveBatch(EOtransceiver *p, eOtransceiver_rxitem_t *items, uint16_t numberofitems, uint16_t *numberofrops)
+{
+    eOresult_t res = eores_OK;
+    eOipv4addr_t remaddr;
+    eOipv4port_t remport;
+    uint16_t totalrops = 0;
+    uint16_t i = 0;
+    
+    if((NULL == p) || (NULL == items))
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    // we tick the proxy only once for the whole batch
+    eo_proxy_Tick(p->proxy);
+    
+    // the reply frame of the receiver is not cleared for each packet, so that it collects the replies of all packets
+    eo_receiver_ClearReply(p->receiver);
+    
+    for(i=0; i<numberofitems; i++)
+    {
+        eOtransceiver_rxitem_t *item = &items[i];
+        
+        item->numberofrops = 0;
+        item->seqnumerror = eobool_false;
+        item->txtime = 0;
+        
+        if(NULL == item->packet)
+        {
+            item->result = eores_NOK_nullpointer;
+            res = eores_NOK_generic;
+            continue;
+        }
+        
+        eo_packet_Addressing_Get(item->packet, &remaddr, &remport);
+        eo_transmitter_outpacket_SetRemoteAddress(p->transmitter, remaddr,  remport);
+        
+        item->result = eo_receiver_ProcessAppend(p->receiver, item->packet, &item->numberofrops, &item->seqnumerror, &item->txtime, s_eo_transceiver_onreplyfull, p);
+        if(eores_OK != item->result)
+        {
+            res = eores_NOK_generic;
+        }
+        totalrops += item->numberofrops;
+    }
+    
+    // and now we give all the replies to the transmitter
+    s_eo_transceiver_onreplyfull(p->receiver, p);
+    
+    if(NULL != numberofrops)
+    {
+        *numberofrops = totalrops;
+    }
+    
+    return(res);
+}
+
 extern eOresult_t eo_transceiver_NumberofOutROPs(EOtransceiver *p, uint16_t *numberofreplies, uint16_t *numberofoccasionals, uint16_t *numberofregulars)
 {
     if(NULL == p)
@@ -399,6 +456,35 @@ extern eOresult_t eo_transceiver_outpacket_Get(EOtransceiver *p, EOpacket **pkt)
 }
 
 
+extern eOresult_t eo_transceiver_outpacket_PrepareGather(EOtransceiver *p, uint16_t *numberofrops, eOtransmitter_ropsnumber_t *ropsnum)
+{  
+    eOresult_t res = eores_NOK_generic;
+    
+    if((NULL == p) || (NULL == numberofrops))
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    res = eo_transmitter_outpacket_PrepareGather(p->transmitter, numberofrops, ropsnum);
+    
+    // as in eo_transceiver_outpacket_Prepare() we tick the proxy
+    eo_proxy_Tick(p->proxy);
+       
+    return(res);
+}
+
+
+extern eOresult_t eo_transceiver_outpacket_GetGather(EOtransceiver *p, eOtransmitter_gather_t *gather)
+{    
+    if(NULL == p) 
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    return(eo_transmitter_outpacket_GetGather(p->transmitter, gather)); 
+}
+
+
 extern eOresult_t eo_transceiver_RegularROPs_Clear(EOtransceiver *p)
 {
     eOresult_t res;
@@ -602,7 +688,30 @@ extern eOresult_t eo_transceiver_LoadReplyInProxy(EOtransceiver *p, eOnvID32_t i
 // --------------------------------------------------------------------------------------------------------------------
 // - definition of static functions 
 // --------------------------------------------------------------------------------------------------------------------
-// empty-section
+
+
+static void s_eo_transceiver_onreplyfull(EOreceiver *receiver, void *param)
+{
+    EOtransceiver *p = (EOtransceiver*)param;
+    EOropframe* ropframereply = NULL;
+    eOresult_t res = eores_OK;
+    
+    if(eores_OK == eo_receiver_GetReply(receiver, &ropframereply))
+    {   // there are replies. we move them into the transmitter and we empty the reply frame for the next ones
+        res = eo_transmitter_reply_ropframe_Load(p->transmitter, ropframereply);
+        
+#if defined(USE_DEBUG_EOTRANSCEIVER) 
+        {   // DEBUG
+            if(eores_OK != res)
+            {
+                p->debug.failuresinloadofreplyropframe ++;
+            }
+        }
+#endif  
+        
+        eo_receiver_ClearReply(receiver);
+    }
+}
 
 
 
@@ -91,6 +91,19 @@ typedef struct
     eOreceiver_void_fp_obj_t    onerrorinvalidframe;    
 } eOtransceiver_extfn_t;
 
+/** @typedef    typedef struct eOtransceiver_rxitem_t
+    @brief      a packet to be processed by eo_transceiver_ReceiveBatch() and the results of its processing. 
+ **/ 
+typedef struct
+{
+    EOpacket*                       packet;         /**< in: the received packet */
+    eOresult_t                      result;         /**< out: the same value that eo_transceiver_Receive() would return */
+    uint16_t                        numberofrops;   /**< out: the number of processed rops */
+    eObool_t                        seqnumerror;    /**< out: eobool_true if the sequence number was not the expected one */
+    eOabstime_t                     txtime;         /**< out: the age of the received ropframe */
+} eOtransceiver_rxitem_t;
+
+
 typedef struct
 {
     eOtransceiver_sizes_t           sizes;
@@ -133,6 +146,19 @@ extern EOreceiver * eo_transceiver_GetReceiver(EOtransceiver *p);
 
 extern eOresult_t eo_transceiver_Receive(EOtransceiver *p, EOpacket *pkt, uint16_t *numberofrops, eOabstime_t* txtime); 
 
+/** @fn         extern eOresult_t eo_transceiver_ReceiveBatch(EOtransceiver *p, eOtransceiver_rxitem_t *items, uint16_t numberofitems, uint16_t *numberofrops)
+    @brief      processes in order many packets, as eo_transceiver_Receive() does for each of them, but it ticks the proxy once
+                and it loads the replies of all the packets inside the transmitter with a single reply frame, unless they 
+                do not fit inside it. the results of each packet are inside its item. 
+    @param      p               pointer to transceiver        
+    @param      items           array of numberofitems items, each with a received packet
+    @param      numberofitems   the number of items
+    @param      numberofrops    if not NULL it contains the total number of processed rops
+    @return     eores_OK if every packet was processed with success, eores_NOK_generic if at least one had an error, 
+                eores_NOK_nullpointer for NULL pointer errors.
+ **/
+extern eOresult_t eo_transceiver_ReceiveBatch(EOtransceiver *p, eOtransceiver_rxitem_t *items, uint16_t numberofitems, uint16_t *numberofrops);
+
 extern eOresult_t eo_transceiver_NumberofOutROPs(EOtransceiver *p, uint16_t *numberofreplies, uint16_t *numberofoccasionals, uint16_t *numberofregulars);
 
 /** @fn         extern eOresult_t eo_transceiver_outpacket_Prepare(EOtransceiver *p, uint16_t *numberofrops)
@@ -153,6 +179,25 @@ extern eOresult_t eo_transceiver_outpacket_Prepare(EOtransceiver *p, uint16_t *n
  **/
 extern eOresult_t eo_transceiver_outpacket_Get(EOtransceiver *p, EOpacket **pkt);
 
+
+/** @fn         extern eOresult_t eo_transceiver_outpacket_PrepareGather(EOtransceiver *p, uint16_t *numberofrops, eOtransmitter_ropsnumber_t *ropsnum)
+    @brief      prepares out packet to send in scatter-gather mode. see eo_transmitter_outpacket_PrepareGather()   
+    @param      p               pointer to transceiver        
+    @param      numberofrops     the number of rops contained in the out packet
+    @return     eores_OK or eores_NOK_nullpointer
+ **/
+extern eOresult_t eo_transceiver_outpacket_PrepareGather(EOtransceiver *p, uint16_t *numberofrops, eOtransmitter_ropsnumber_t *ropsnum);
+
+
+/** @fn         extern eOresult_t eo_transceiver_outpacket_GetGather(EOtransceiver *p, eOtransmitter_gather_t *gather)
+    @brief      returns the segments of the out packet. they are well formed only if eo_transceiver_outpacket_PrepareGather() 
+                is called before and they stay valid until its next call.  
+    @param      p               pointer to transceiver        
+    @param      gather          it contains the segments of the outpacket and its destination
+    @return     eores_OK or eores_NOK_nullpointer
+ **/
+extern eOresult_t eo_transceiver_outpacket_GetGather(EOtransceiver *p, eOtransmitter_gather_t *gather);
+
 extern eOresult_t eo_transceiver_lasterror_tx_Get(EOtransceiver *p, int32_t *err, int32_t *info0, int32_t *info1, int32_t *info2);
     
 // if the variable is local then it is used the ram of the netvar. if it is remote, the ropdescr must contain data and size
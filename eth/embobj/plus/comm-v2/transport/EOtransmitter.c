@@ -64,6 +64,18 @@
     #define eov_mutex_Release(a)
 #endif
 
+// the staging mode of occasionals and replies needs c11 atomics and thread-local storage. without them 
+// eo_transmitter_Staging_Set() returns eores_NOK_unsupported and the rops always go through the mutexes.
+#if defined(EOTRANSMITTER_ATOMICS)
+    #define EOTRANSMITTER_STAGING
+#endif
+
+// with pthreads a thread which exits gives its producers back, so that other threads can take them
+#if defined(EOTRANSMITTER_STAGING) && defined(EO_TAILOR_CODE_FOR_LINUX)
+    #define EOTRANSMITTER_STAGING_THREADEXIT
+    #include <pthread.h>
+#endif
+
 
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -76,7 +88,41 @@
 // --------------------------------------------------------------------------------------------------------------------
 // - typedef with internal scope
 // --------------------------------------------------------------------------------------------------------------------
-// empty-section
+
+typedef enum
+{
+    eo_transm_staging_occasionals   = 0,
+    eo_transm_staging_replies       = 1
+} eo_transm_stagingcategory_t;
+
+#if defined(EOTRANSMITTER_STAGING)
+
+typedef struct
+{   // a ring of records made of a 4-byte header with the size of the rop followed by the rop stream. a record is never 
+    // split at the end of the ring: the producer places a record of size zero and restarts from the beginning.
+    uint8_t*                data;
+    uint32_t                capacity;   // a power of two
+    atomic_uint_least32_t   head;       // free running. written only by the producer
+    atomic_uint_least32_t   tail;       // free running. written only by the thread which drains
+} eo_transm_staging_queue_t;
+
+typedef struct
+{
+    atomic_uintptr_t            owner;      // the thread which owns the queues. 0 marks a free producer
+    EOrop*                      rop;        // used only by the owner to form its rops, thus without p->mtx_roptmp
+    eo_transm_staging_queue_t   queues[2];  // use eo_transm_stagingcategory_t as index
+} eo_transm_staging_producer_t;
+
+struct eo_transm_staging_t
+{
+    eo_transm_staging_t*            next;       // in the list of all the staging transmitters, used at the exit of a thread
+    eo_transm_staging_producer_t*   producers;
+    uint8_t                         numberofproducers;
+    uint8_t                         first;      // the producer drained first. it rotates so that a full ropframe does not starve the others
+    atomic_uint_least32_t           fallbacks;  // the rops loaded through the mutexes because no producer was free
+};
+
+#endif
 
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -85,15 +131,13 @@
 
 //static eOresult_t s_eo_transmitter_listmatching_rule(void *item, void *param);
 
-static eOresult_t s_eo_transmitter_entitymatchingrule_rule(void *item, void *param);
-
-static eOresult_t s_eo_transmitter_ropmatchingrule_rule(void *item, void *param);
-
 static void s_eo_transmitter_list_updaterop_in_ropframe(void *item, void *param);
 
 static void s_eo_transmitter_list_shiftdownropinfo(void *item, void *param);
 
-static eOresult_t s_eo_transmitter_rops_Load(EOtransmitter *p, eOropdescriptor_t* ropdesc, EOropframe* intoropframe, EOVmutexDerived *mtx);
+static void s_eo_transmitter_list_loaddirty(void *item, void *param);
+
+static eOresult_t s_eo_transmitter_rops_Load(EOtransmitter *p, eOropdescriptor_t* ropdesc, EOropframe* intoropframe, EOVmutexDerived *mtx, eo_transm_stagingcategory_t stagingcategory);
 
 static EOropframe * s_eo_transmitter_id32_to_typeofregulars(EOtransmitter* p, eOprotID32_t id32, eo_transm_regropframe_t *ropframetype);
 
@@ -108,6 +152,70 @@ static void s_eo_transmitter_regulars_reset_sizes(EOtransmitter *p);
 
 static void s_eo_transmitter_regulars_update_sizes(EOtransmitter *p, eo_transm_regropframe_t type, int16_t ropbytes);
 
+static void s_eo_transmitter_regulars_remove(EOtransmitter *p, EOlistIter *li);
+
+static void s_eo_transmitter_regropindex_init(EOtransmitter *p, uint16_t maxnumberofregularrops);
+
+static void s_eo_transmitter_regropindex_deinit(EOtransmitter *p);
+
+static void s_eo_transmitter_regropindex_clear(EOtransmitter *p);
+
+static EOlistIter * s_eo_transmitter_regropindex_find(EOtransmitter *p, eOnvID32_t id32);
+
+static void s_eo_transmitter_regropindex_insert(EOtransmitter *p, eOnvID32_t id32, EOlistIter *li);
+
+static void s_eo_transmitter_regropindex_remove(EOtransmitter *p, eOnvID32_t id32);
+
+static void s_eo_transmitter_occropindex_deinit(EOtransmitter *p);
+
+static void s_eo_transmitter_occropindex_rebuild(EOtransmitter *p);
+
+static eObool_t s_eo_transmitter_occropindex_coalesce(EOtransmitter *p, uint16_t addedinpos, uint16_t ropsize, eObool_t coalesce);
+
+static uint16_t s_eo_transmitter_regulars_append(EOtransmitter *p, uint16_t maxbytes, uint16_t *usedbytes);
+
+static uint16_t s_eo_transmitter_delta_encode(EOtransmitter *p, uint8_t slot, uint16_t nrops, uint16_t maxbytes, uint16_t *usedbytes);
+
+static void s_eo_transmitter_delta_deinit(EOtransmitter *p);
+
+static uint16_t s_eo_transmitter_gather_detach(EOropframe *ropframe, uint8_t **buffer, uint8_t **spare);
+
+static uint16_t s_eo_transmitter_packing_maxbytes(EOtransmitter *p, eOtransmitter_category_t category, uint16_t available);
+
+static uint16_t s_eo_transmitter_packing_regulars(EOtransmitter *p, EOropframe *ropframe, uint16_t nrops, uint16_t maxbytes, uint16_t *usedbytes);
+
+static uint16_t s_eo_transmitter_packing_append(EOtransmitter *p, eOtransmitter_category_t category, EOropframe *ropframe, uint16_t maxbytes, uint16_t *usedbytes);
+
+static uint16_t s_eo_transmitter_packing_detach(EOtransmitter *p, eOtransmitter_category_t category, EOropframe *ropframe, uint8_t **buffer, uint8_t **spare, uint16_t maxbytes, uint16_t *usedbytes, eOtransmitter_segment_t *segment);
+
+static uint16_t s_eo_transmitter_packing_carryover(EOtransmitter *p, eOtransmitter_category_t category, EOropframe *ropframe, const uint8_t *rops, uint16_t nrops, uint16_t sizeofrops, uint16_t sizeoffirst);
+
+static void s_eo_transmitter_adaptive_update(EOtransmitter *p, uint16_t usedbytes, uint16_t capacity);
+
+static uint64_t s_eo_transmitter_adaptive_overflowbytes(EOtransmitter *p);
+
+static uint32_t s_eo_transmitter_adaptive_sequenceerrors(EOtransmitter *p);
+
+static void s_eo_transmitter_staging_deinit(EOtransmitter *p);
+
+static void s_eo_transmitter_staging_drain(EOtransmitter *p, eo_transm_stagingcategory_t stagingcategory, EOropframe *ropframe);
+
+#if defined(EOTRANSMITTER_STAGING)
+
+static eo_transm_staging_producer_t * s_eo_transmitter_staging_producer_get(EOtransmitter *p);
+
+static eOresult_t s_eo_transmitter_staging_push(EOtransmitter *p, eo_transm_staging_queue_t *queue, EOrop *rop);
+
+static void s_eo_transmitter_staging_register(eo_transm_staging_t *staging, eObool_t add);
+
+#if defined(EOTRANSMITTER_STAGING_THREADEXIT)
+static void s_eo_transmitter_staging_key_create(void);
+
+static void s_eo_transmitter_staging_threadexit(void *self);
+#endif
+
+#endif
+
 
 // --------------------------------------------------------------------------------------------------------------------
 // - definition (and initialisation) of static variables
@@ -115,6 +223,20 @@ static void s_eo_transmitter_regulars_update_sizes(EOtransmitter *p, eo_transm_r
 
 static const char s_eobj_ownname[] = "EOtransmitter";
 
+static const uint32_t s_eo_transmitter_gather_footer = EOFRAME_END;
+
+#if defined(EOTRANSMITTER_STAGING)
+// its address tells the threads apart, so that each producer finds its own queues
+static _Thread_local uint8_t s_eo_transmitter_staging_thread = 0;
+static eo_transm_staging_t * s_eo_transmitter_staging_all = NULL;
+static atomic_flag s_eo_transmitter_staging_lock = ATOMIC_FLAG_INIT;   // protects s_eo_transmitter_staging_all
+#endif
+
+#if defined(EOTRANSMITTER_STAGING_THREADEXIT)
+static pthread_once_t s_eo_transmitter_staging_keyonce = PTHREAD_ONCE_INIT;
+static pthread_key_t s_eo_transmitter_staging_key;                  // its destructor runs at the exit of a thread which owns producers
+#endif
+
 const eOtransmitter_cfg_t eo_transmitter_cfg_default = 
 {
     EO_INIT(.sizes)
@@ -133,6 +255,24 @@ const eOtransmitter_cfg_t eo_transmitter_cfg_default =
     EO_INIT(.agent)                         NULL
 };
 
+const eOtransmitter_packing_t eo_transmitter_packing_default =
+{
+    EO_INIT(.priority)      { eo_transmitter_category_regulars, eo_transmitter_category_occasionals, eo_transmitter_category_replies },
+    EO_INIT(.carryover)     eobool_true,
+    EO_INIT(.budget)        { 0, 0, 0 }
+};
+
+const eOtransmitter_adaptive_cfg_t eo_transmitter_adaptive_cfg_default =
+{
+    EO_INIT(.minregularsdecimation)     1,
+    EO_INIT(.maxregularsdecimation)     4,
+    EO_INIT(.maxcycleddecimation)       2,
+    EO_INIT(.highfill)                  90,
+    EO_INIT(.lowfill)                   50,
+    EO_INIT(.filler)                    0,
+    EO_INIT(.window)                    100
+};
+
 
 // --------------------------------------------------------------------------------------------------------------------
 // - definition of extern public functions
@@ -197,7 +337,12 @@ extern EOtransmitter* eo_transmitter_New(const eOtransmitter_cfg_t *cfg)
     // TAG(*1234*) : end
     retptr->bufferropframeoccasionals = (0 == cfg->sizes.capacityofropframeoccasionals) ? (NULL) : ((uint8_t*)eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_32bit, cfg->sizes.capacityofropframeoccasionals, 1));
     retptr->bufferropframereplies   = (0 == cfg->sizes.capacityofropframereplies) ? (NULL) : ((uint8_t*)eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_32bit, cfg->sizes.capacityofropframereplies, 1));
+    // the spare buffers are allocated only at first use of the scatter-gather mode
+    retptr->spareropframeoccasionals = NULL;
+    retptr->spareropframereplies    = NULL;
+    memset(&retptr->gather, 0, sizeof(retptr->gather));
     retptr->listofregropinfo        = (0 == cfg->sizes.maxnumberofregularrops) ? (NULL) : (eo_list_New(sizeof(eo_transm_regrop_info_t), cfg->sizes.maxnumberofregularrops, NULL, 0, NULL, NULL));
+    s_eo_transmitter_regropindex_init(retptr, cfg->sizes.maxnumberofregularrops);
     retptr->currenttime             = 0;
     retptr->tx_seqnum               = 0;
 
@@ -241,6 +386,11 @@ extern EOtransmitter* eo_transmitter_New(const eOtransmitter_cfg_t *cfg)
         retptr->mtx_regulars    = cfg->mutex_fn_new();
         retptr->mtx_occasionals = cfg->mutex_fn_new(); 
         retptr->mtx_roptmp      = cfg->mutex_fn_new();
+        // the names are used only by the lock-contention profiler of EOVmutex
+        eov_mutex_SetName(retptr->mtx_replies, "EOtransmitter.replies");
+        eov_mutex_SetName(retptr->mtx_regulars, "EOtransmitter.regulars");
+        eov_mutex_SetName(retptr->mtx_occasionals, "EOtransmitter.occasionals");
+        eov_mutex_SetName(retptr->mtx_roptmp, "EOtransmitter.roptmp");
     }
     else
     {
@@ -269,6 +419,15 @@ extern EOtransmitter* eo_transmitter_New(const eOtransmitter_cfg_t *cfg)
     
     retptr->effectivecapacityofregulars = eo_ropframe_capacity2effectivecapacity(cfg->sizes.capacityofropframeregulars);
     retptr->txregularsprogressive = 0;
+    retptr->refreshmode = eo_transmitter_refresh_all;
+    retptr->refreshedbytes = 0;
+    retptr->staging = NULL;
+    retptr->packing = eo_transmitter_packing_default;
+    memset(&retptr->packingstatistics, 0, sizeof(retptr->packingstatistics));
+    retptr->txdecimationcycled = 1;
+    memset(&retptr->adaptive, 0, sizeof(retptr->adaptive));
+    memset(&retptr->occropindex, 0, sizeof(retptr->occropindex));
+    memset(&retptr->delta, 0, sizeof(retptr->delta));
     
     return(retptr);
 }
@@ -307,6 +466,10 @@ extern void eo_transmitter_Delete(EOtransmitter *p)
     {
         eo_list_Delete(p->listofregropinfo);
     }     
+    s_eo_transmitter_regropindex_deinit(p);
+    s_eo_transmitter_staging_deinit(p);
+    s_eo_transmitter_occropindex_deinit(p);
+    s_eo_transmitter_delta_deinit(p);
     if(NULL != p->bufferropframeregulars_standard)
     {
         eo_mempool_Delete(eo_mempool_GetHandle(), p->bufferropframeregulars_standard);
@@ -332,6 +495,16 @@ extern void eo_transmitter_Delete(EOtransmitter *p)
         eo_mempool_Delete(eo_mempool_GetHandle(),  p->bufferropframereplies);
         p->bufferropframereplies = NULL;
     }  
+    if(NULL != p->spareropframeoccasionals)
+    {
+        eo_mempool_Delete(eo_mempool_GetHandle(),  p->spareropframeoccasionals);
+        p->spareropframeoccasionals = NULL;
+    }
+    if(NULL != p->spareropframereplies)
+    {
+        eo_mempool_Delete(eo_mempool_GetHandle(),  p->spareropframereplies);
+        p->spareropframereplies = NULL;
+    }
     
     eo_rop_Delete(p->roptmp);
     
@@ -608,13 +781,8 @@ extern eOresult_t eo_transmitter_regular_rops_Load(EOtransmitter *p, eOropdescri
     }
     
 
-    // for searching inside listofregropinfo we need only those three fields: ropcode, id, ep
-    ropdescriptor.ropcode   = ropdesc->ropcode;
-    ropdescriptor.id32      = ropdesc->id32;
-
-    
-    // search for ropcode+ep+id. if found, then ... return a non NULL iterator and dont do anything because it means that the rop is already inside
-    if(NULL != eo_list_Find(p->listofregropinfo, s_eo_transmitter_ropmatchingrule_rule, &ropdescriptor))
+    // search for the id32 inside the index of listofregropinfo. if found, then dont do anything because it means that the rop is already inside
+    if(NULL != s_eo_transmitter_regropindex_find(p, ropdesc->id32))
     {   // it is already inside ...
         eov_mutex_Release(p->mtx_regulars);
         return(eores_OK);
@@ -727,8 +895,9 @@ extern eOresult_t eo_transmitter_regular_rops_Load(EOtransmitter *p, eOropdescri
     memcpy(&regropinfo.thenv, tmpnvptr, sizeof(EOnv));
 
 
-    // push back regropinfo inside the list.
+    // push back regropinfo inside the list and keep track of its iterator inside the index
     eo_list_PushBack(p->listofregropinfo, &regropinfo);
+    s_eo_transmitter_regropindex_insert(p, regropinfo.thenv.id32, eo_list_Last(p->listofregropinfo));
     
     // increment size of the relevant regular ropframe
     s_eo_transmitter_regulars_update_sizes(p, regropframe2use_type, +regropinfo.ropsize); // with a + we increment
@@ -742,8 +911,6 @@ extern eOresult_t eo_transmitter_regular_rops_Load(EOtransmitter *p, eOropdescri
 
 extern eOresult_t eo_transmitter_regular_rops_Unload(EOtransmitter *p, eOropdescriptor_t* ropdesc)//eOropcode_t ropcode, eOnvEP_t nvep, eOnvID_t nvid)
 {
-    eo_transm_regrop_info_t regropinfo;
-    eOropdescriptor_t ropdescriptor;
     EOlistIter *li = NULL;
 
     if(NULL == p) 
@@ -767,38 +934,15 @@ extern eOresult_t eo_transmitter_regular_rops_Unload(EOtransmitter *p, eOropdesc
         return(eores_NOK_generic);
     }
     
-    // need only ropcode, ep and id to search for inside the list listofregropinfo
-    ropdescriptor.ropcode       = ropdesc->ropcode;
-    ropdescriptor.id32          = ropdesc->id32;
-
-      
-    // search for ropcode+nvep+nvid. if not found, then ... return OK and dont do anything.
-    li = eo_list_Find(p->listofregropinfo, s_eo_transmitter_ropmatchingrule_rule, &ropdescriptor);
+    // search for the id32 inside the index of listofregropinfo. if not found, then ... return NOK and dont do anything.
+    li = s_eo_transmitter_regropindex_find(p, ropdesc->id32);
     if(NULL == li)
     {   // it is not inside ...
         eov_mutex_Release(p->mtx_regulars);
         return(eores_NOK_generic);
     }
     
-    // copy what is inside the list into a temporary variable
-    memcpy(&regropinfo, eo_list_At(p->listofregropinfo, li), sizeof(eo_transm_regrop_info_t));
-    
-    // for each element after li: (name is afterli) retrieve it and modify its content so that ropstarthere is decremented by regropinfo.ropsize ...
-    // but only if ... the element is inside the same regropframe. that is done in function s_eo_transmitter_list_shiftdownropinfo()
-    eo_list_ExecuteFromIter(p->listofregropinfo, s_eo_transmitter_list_shiftdownropinfo, &regropinfo, eo_list_Next(p->listofregropinfo, li));
-    
-    // remove the element indexedby li
-    eo_list_Erase(p->listofregropinfo, li);
-    
-    // inside the p->ropframeregulars: remove a rop of regropinfo.ropsize which starts at regropinfo.ropstartshere. use a _friend method in here defined.
-    //                                 you must: decrement the nrops by 1, decrement the size by regropinfo.ropsize, ... else in header and private variable ...
-    //                                           and finally make a memmove down by regropinfo.ropsize.
-    
-
-    eo_ropframe_ROP_Rem(regropinfo.ropframe, regropinfo.ropstarthere, regropinfo.ropsize);
-    
-    // decrement the size of relevant ropframe
-    s_eo_transmitter_regulars_update_sizes(p, (eo_transm_regropframe_t)regropinfo.regropframetype, -regropinfo.ropsize); // with a -regropinfo.ropsize we decrement
+    s_eo_transmitter_regulars_remove(p, li);
 
     eov_mutex_Release(p->mtx_regulars);
     
@@ -808,11 +952,9 @@ extern eOresult_t eo_transmitter_regular_rops_Unload(EOtransmitter *p, eOropdesc
 
 extern eOresult_t eo_transmitter_regular_rops_entity_Unload(EOtransmitter *p, eOnvEP8_t ep8, eOnvENT_t ent)
 {
-    eo_transm_regrop_info_t regropinfo;
     EOlistIter *li = NULL;
+    EOlistIter *next = NULL;
     uint32_t id32 = 0;
-    uint8_t size = 0;
-    uint8_t i = 0;
 
     if(NULL == p) 
     {
@@ -835,39 +977,22 @@ extern eOresult_t eo_transmitter_regular_rops_entity_Unload(EOtransmitter *p, eO
         return(eores_NOK_generic);
     }
     
-    // need only ropcode, ep and id to search for inside the list listofregropinfo
+    // we match only ep and entity of the id32 of the items inside the list listofregropinfo
     id32 = ((uint32_t)ep8 << 24) | ((uint32_t)ent << 16);
 
-      
-    size = eo_list_Size(p->listofregropinfo);
-    for(i=0; i<size; i++)
+    // a single pass on the list: we get the next iterator before we remove the current one
+    li = eo_list_Begin(p->listofregropinfo);
+    while(NULL != li)
     {
-        // search for ropcode+nvep+nvid. if not found, then ... break.
-        li = eo_list_Find(p->listofregropinfo, s_eo_transmitter_entitymatchingrule_rule, &id32);
-        if(NULL == li)
-        {   // it is not inside ...
-            break;
-        }
-        
-        // copy what is inside the list into a temporary variable
-        memcpy(&regropinfo, eo_list_At(p->listofregropinfo, li), sizeof(eo_transm_regrop_info_t));
-        
-        // for each element after li: (name is afterli) retrieve it and modify its content so that ropstarthere is decremented by regropinfo.ropsize ...
-        // but only if ... the element is inside the same regropframe. that is done in function s_eo_transmitter_list_shiftdownropinfo()
-        eo_list_ExecuteFromIter(p->listofregropinfo, s_eo_transmitter_list_shiftdownropinfo, &regropinfo, eo_list_Next(p->listofregropinfo, li));
-        
-        // remove the element indexedby li
-        eo_list_Erase(p->listofregropinfo, li);
-        
-        // inside the p->ropframeregulars: remove a rop of regropinfo.ropsize which starts at regropinfo.ropstartshere. use a _friend method in here defined.
-        //                                 you must: decrement the nrops by 1, decrement the size by regropinfo.ropsize, ... else in header and private variable ...
-        //                                           and finally make a memmove down by regropinfo.ropsize.
+        eo_transm_regrop_info_t *item = (eo_transm_regrop_info_t*) eo_list_At(p->listofregropinfo, li);
+        next = eo_list_Next(p->listofregropinfo, li);
         
-
-        eo_ropframe_ROP_Rem(regropinfo.ropframe, regropinfo.ropstarthere, regropinfo.ropsize);
+        if(id32 == (item->thenv.id32 & 0xffff0000))
+        {
+            s_eo_transmitter_regulars_remove(p, li);
+        }
         
-        // decrement the size of relevant ropframe
-        s_eo_transmitter_regulars_update_sizes(p, (eo_transm_regropframe_t)regropinfo.regropframetype, -regropinfo.ropsize); // with a -regropinfo.ropsize we decrement    
+        li = next;
     }
 
     eov_mutex_Release(p->mtx_regulars);
@@ -897,6 +1022,7 @@ extern eOresult_t eo_transmitter_regular_rops_Clear(EOtransmitter *p)
     } 
     
     eo_list_Clear(p->listofregropinfo);
+    s_eo_transmitter_regropindex_clear(p);
     
     eo_ropframe_Clear(p->ropframeregulars_standard);
     eo_ropframe_Clear(p->ropframeregulars_cycle0of);
@@ -924,6 +1050,8 @@ extern eOresult_t eo_transmitter_regular_rops_Refresh(EOtransmitter *p)
     
     eov_mutex_Take(p->mtx_regulars, eok_reltimeINFINITE);
     
+    p->refreshedbytes = 0;
+    
     if(eobool_true == eo_list_Empty(p->listofregropinfo))
     {
         eov_mutex_Release(p->mtx_regulars);
@@ -941,6 +1069,96 @@ extern eOresult_t eo_transmitter_regular_rops_Refresh(EOtransmitter *p)
 }
 
 
+extern eOresult_t eo_transmitter_regular_rops_RefreshMode_Set(EOtransmitter *p, eOtransmitter_refreshmode_t mode)
+{
+    if(NULL == p) 
+    {
+        return(eores_NOK_nullpointer);
+    }  
+    
+    if(eo_transmitter_refresh_dirtyonly == mode)
+    {
+        if(eores_OK != eo_nvset_DirtyTracking_Enable(p->nvset))
+        {
+            return(eores_NOK_generic);
+        }
+    }
+    
+    eov_mutex_Take(p->mtx_regulars, eok_reltimeINFINITE);
+    
+    p->refreshmode = mode;
+    
+    // the regular rops already loaded hold a copy of their EOnv taken without the dirty flag. 
+    if((eo_transmitter_refresh_dirtyonly == mode) && (NULL != p->listofregropinfo))
+    {
+        eo_list_Execute(p->listofregropinfo, s_eo_transmitter_list_loaddirty, p);
+    }
+    
+    eov_mutex_Release(p->mtx_regulars);
+    
+    return(eores_OK);   
+}
+
+
+extern uint32_t eo_transmitter_regular_rops_RefreshedBytes_Get(EOtransmitter *p)
+{
+    if(NULL == p) 
+    {
+        return(0);
+    } 
+    
+    return(p->refreshedbytes);
+}
+
+
+extern eOresult_t eo_transmitter_regular_rops_Delta_Set(EOtransmitter *p, uint16_t keyframeperiod)
+{
+    uint8_t i = 0;
+    
+    if(NULL == p) 
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    if(0 == keyframeperiod)
+    {
+        s_eo_transmitter_delta_deinit(p);
+        return(eores_OK);
+    }
+    
+    if(NULL == p->delta.stream)
+    {   // the regulars and their delta rop are never bigger than the rops of the packet
+        eo_ropframe_EffectiveCapacity_Get(p->ropframereadytotx, &p->delta.capacity);
+        p->delta.stream = (uint8_t*) eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_32bit, p->delta.capacity, 1);
+        for(i=0; i<eo_transm_delta_slots; i++)
+        {
+            p->delta.references[i].rops = (uint8_t*) eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_32bit, p->delta.capacity, 1);
+            p->delta.references[i].size = 0;
+            p->delta.references[i].sincekeyframe = 0;
+            p->delta.references[i].progressive = 0;
+        }
+        memset(&p->delta.statistics, 0, sizeof(p->delta.statistics));
+    }
+    
+    p->delta.keyframeperiod = keyframeperiod;
+    
+    return(eores_OK);
+}
+
+
+extern eOresult_t eo_transmitter_regular_rops_Delta_GetStatistics(EOtransmitter *p, eOtransmitter_deltastatistics_t *stats)
+{
+    if((NULL == p) || (NULL == stats)) 
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    *stats = p->delta.statistics;
+    
+    return(eores_OK);
+}
+
+
 extern eOresult_t eo_transmitter_NumberofOutROPs(EOtransmitter *p, uint16_t *numberofreplies, uint16_t *numberofoccasionals, uint16_t *numberofregulars)
 {
     if(NULL == p)
@@ -953,6 +1171,7 @@ extern eOresult_t eo_transmitter_NumberofOutROPs(EOtransmitter *p, uint16_t *num
         if(0 == (p->txdecimationprogressive % p->txdecimationreplies))
         {
             eov_mutex_Take(p->mtx_replies, eok_reltimeINFINITE);
+            s_eo_transmitter_staging_drain(p, eo_transm_staging_replies, p->ropframereplies);
             *numberofreplies = eo_ropframe_ROP_NumberOf(p->ropframereplies);
             eov_mutex_Release(p->mtx_replies);
         }
@@ -967,6 +1186,7 @@ extern eOresult_t eo_transmitter_NumberofOutROPs(EOtransmitter *p, uint16_t *num
         if(0 == (p->txdecimationprogressive % p->txdecimationoccasionals))
         {
             eov_mutex_Take(p->mtx_occasionals, eok_reltimeINFINITE);
+            s_eo_transmitter_staging_drain(p, eo_transm_staging_occasionals, p->ropframeoccasionals);
             *numberofoccasionals = eo_ropframe_ROP_NumberOf(p->ropframeoccasionals);
             eov_mutex_Release(p->mtx_occasionals);
         }
@@ -1002,7 +1222,10 @@ extern eOresult_t eo_transmitter_NumberofOutROPs(EOtransmitter *p, uint16_t *num
 
 extern eOresult_t eo_transmitter_outpacket_Prepare(EOtransmitter *p, uint16_t *numberofrops, eOtransmitter_ropsnumber_t *ropsnum)
 {
-    uint16_t remainingbytes;
+    eOtransmitter_ropsnumber_t rn = {0};
+    uint16_t capacity = 0;
+    uint16_t available = 0;
+    uint8_t i = 0;
 
     if(NULL == p) 
     {
@@ -1079,67 +1302,61 @@ extern eOresult_t eo_transmitter_outpacket_Prepare(EOtransmitter *p, uint16_t *n
 //    }
 
 
-    // add to it the ropframe of regulars. keep it afterwards. dont clear it !!!
-    if(0 == (p->txdecimationprogressive % p->txdecimationregulars))
-    {
-        EOropframe* cycledregulars = NULL;
-        uint16_t nregularscycled = 0;
-        uint16_t nregulars = 0;
+    eo_ropframe_EffectiveCapacity_Get(p->ropframereadytotx, &capacity);
+    available = capacity;
 
-        // refresh all regulars ...    
-        eo_transmitter_regular_rops_Refresh(p);
-        
-        // then copy regulars into the ropframe ready to be transmitted
-        
-        eov_mutex_Take(p->mtx_regulars, eok_reltimeINFINITE);
-        
-        // at first the standard regulars which are always transmitted
-        eo_ropframe_Append(p->ropframereadytotx, p->ropframeregulars_standard, &remainingbytes);
-        nregulars += eo_ropframe_ROP_NumberOf(p->ropframeregulars_standard);
-        
-        // then add the cycled one, if there are any
-        cycledregulars = s_eo_transmitter_get_cycled_regropframe(p, &nregularscycled);
-        if(NULL != cycledregulars)
-        {
-            eo_ropframe_Append(p->ropframereadytotx, cycledregulars, &remainingbytes);
-            nregulars += nregularscycled;
-        }
-                
-        eov_mutex_Release(p->mtx_regulars);
+    // the categories are packed in order of priority. each one gets at most its budget of the bytes left by the others.
+    // the regulars are kept afterwards. the occasionals and replies which were packed are removed from their ropframe.
+    for(i=0; i<eo_transmitter_categories_numberof; i++)
+    {
+        eOtransmitter_category_t category = (eOtransmitter_category_t)p->packing.priority[i];
+        uint16_t maxbytes = s_eo_transmitter_packing_maxbytes(p, category, available);
+        uint16_t usedbytes = 0;
         
-        if(NULL != ropsnum)
+        switch(category)
         {
-            ropsnum->numberofregulars = nregulars;
+            case eo_transmitter_category_regulars:
+            {
+                if(0 == (p->txdecimationprogressive % p->txdecimationregulars))
+                {
+                    rn.numberofregulars = s_eo_transmitter_regulars_append(p, maxbytes, &usedbytes);
+                }
+            } break;
+            
+            case eo_transmitter_category_occasionals:
+            {
+                if(0 == (p->txdecimationprogressive % p->txdecimationoccasionals))
+                {
+                    eov_mutex_Take(p->mtx_occasionals, eok_reltimeINFINITE);
+                    s_eo_transmitter_staging_drain(p, eo_transm_staging_occasionals, p->ropframeoccasionals);
+                    rn.numberofoccasionals = s_eo_transmitter_packing_append(p, category, p->ropframeoccasionals, maxbytes, &usedbytes);
+                    s_eo_transmitter_occropindex_rebuild(p);
+                    eov_mutex_Release(p->mtx_occasionals);
+                }
+            } break;
+            
+            case eo_transmitter_category_replies:
+            {
+                if(0 == (p->txdecimationprogressive % p->txdecimationreplies))
+                {
+                    eov_mutex_Take(p->mtx_replies, eok_reltimeINFINITE);
+                    s_eo_transmitter_staging_drain(p, eo_transm_staging_replies, p->ropframereplies);
+                    rn.numberofreplies = s_eo_transmitter_packing_append(p, category, p->ropframereplies, maxbytes, &usedbytes);
+                    eov_mutex_Release(p->mtx_replies);
+                }
+            } break;
+            
+            default:
+            {
+            } break;
         }
         
-        // very important: increment the regulars progressive number. it is used to decide which cycling regular to get
-        p->txregularsprogressive ++;
-    }
-
-    // add the ropframe of occasionals ... and then clear it
-    if(0 == (p->txdecimationprogressive % p->txdecimationoccasionals))
-    {
-        eov_mutex_Take(p->mtx_occasionals, eok_reltimeINFINITE);
-        if(NULL != ropsnum)
-        {
-            ropsnum->numberofoccasionals = eo_ropframe_ROP_NumberOf(p->ropframeoccasionals);
-        }
-        eo_ropframe_Append(p->ropframereadytotx, p->ropframeoccasionals, &remainingbytes);
-        eo_ropframe_Clear(p->ropframeoccasionals);
-        eov_mutex_Release(p->mtx_occasionals);
+        available -= usedbytes;
     }
-
-    // add the ropframe of replies ... and then clear it
-    if(0 == (p->txdecimationprogressive % p->txdecimationreplies))
+    
+    if(NULL != ropsnum)
     {
-        eov_mutex_Take(p->mtx_replies, eok_reltimeINFINITE);
-        if(NULL != ropsnum)
-        {
-            ropsnum->numberofreplies = eo_ropframe_ROP_NumberOf(p->ropframereplies);
-        }        
-        eo_ropframe_Append(p->ropframereadytotx, p->ropframereplies, &remainingbytes);
-        eo_ropframe_Clear(p->ropframereplies);
-        eov_mutex_Release(p->mtx_replies);
+        *ropsnum = rn;
     }
 
 
@@ -1150,6 +1367,8 @@ extern eOresult_t eo_transmitter_outpacket_Prepare(EOtransmitter *p, uint16_t *n
         *numberofrops = eo_ropframe_ROP_NumberOf(p->ropframereadytotx);   
     }
     
+    s_eo_transmitter_adaptive_update(p, capacity - available, capacity);
+    
     // finally we must increment the txdecimationprogressive
     p->txdecimationprogressive ++;
     
@@ -1157,6 +1376,124 @@ extern eOresult_t eo_transmitter_outpacket_Prepare(EOtransmitter *p, uint16_t *n
 }
 
 
+extern eOresult_t eo_transmitter_outpacket_PrepareGather(EOtransmitter *p, uint16_t *numberofrops, eOtransmitter_ropsnumber_t *ropsnum)
+{
+    EOropframeHeader_t *header = NULL;
+    uint16_t capacity = 0;
+    uint16_t available = 0;
+    uint16_t ropssizeof = 0;
+    uint16_t ropsnumberof = 0;
+    uint16_t nregulars = 0;
+    uint16_t noccasionals = 0;
+    uint16_t nreplies = 0;
+    eOtransmitter_segment_t *segment = NULL;
+    uint8_t i = 0;
+
+    if(NULL == p) 
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    // the regulars are copied as in eo_transmitter_outpacket_Prepare() because they can change at any time. 
+    // the first segment is made of the header and of the regulars, the footer is the last segment.
+    eo_ropframe_Clear(p->ropframereadytotx);
+    eo_ropframe_EffectiveCapacity_Get(p->ropframereadytotx, &capacity);
+    available = capacity;
+    
+    // the occasionals and the replies are not copied. their ropframes get a spare buffer and we keep the filled one 
+    // untouched until next call, so that the segments point at it. the categories are packed in order of priority
+    // as in eo_transmitter_outpacket_Prepare(). only the size of the first segment depends on the order.
+    segment = &p->gather.segments[1];
+    
+    for(i=0; i<eo_transmitter_categories_numberof; i++)
+    {
+        eOtransmitter_category_t category = (eOtransmitter_category_t)p->packing.priority[i];
+        uint16_t maxbytes = s_eo_transmitter_packing_maxbytes(p, category, available);
+        uint16_t usedbytes = 0;
+        
+        switch(category)
+        {
+            case eo_transmitter_category_regulars:
+            {
+                if(0 == (p->txdecimationprogressive % p->txdecimationregulars))
+                {
+                    nregulars = s_eo_transmitter_regulars_append(p, maxbytes, &usedbytes);
+                }
+            } break;
+            
+            case eo_transmitter_category_occasionals:
+            {
+                if(0 == (p->txdecimationprogressive % p->txdecimationoccasionals))
+                {
+                    eov_mutex_Take(p->mtx_occasionals, eok_reltimeINFINITE);
+                    s_eo_transmitter_staging_drain(p, eo_transm_staging_occasionals, p->ropframeoccasionals);
+                    noccasionals = s_eo_transmitter_packing_detach(p, category, p->ropframeoccasionals, &p->bufferropframeoccasionals, &p->spareropframeoccasionals, maxbytes, &usedbytes, segment);
+                    s_eo_transmitter_occropindex_rebuild(p);
+                    eov_mutex_Release(p->mtx_occasionals);
+                }
+            } break;
+            
+            case eo_transmitter_category_replies:
+            {
+                if(0 == (p->txdecimationprogressive % p->txdecimationreplies))
+                {
+                    eov_mutex_Take(p->mtx_replies, eok_reltimeINFINITE);
+                    s_eo_transmitter_staging_drain(p, eo_transm_staging_replies, p->ropframereplies);
+                    nreplies = s_eo_transmitter_packing_detach(p, category, p->ropframereplies, &p->bufferropframereplies, &p->spareropframereplies, maxbytes, &usedbytes, segment);
+                    eov_mutex_Release(p->mtx_replies);
+                }
+            } break;
+            
+            default:
+            {
+            } break;
+        }
+        
+        if((eo_transmitter_category_regulars != category) && (0 != usedbytes))
+        {
+            segment++;
+        }
+        ropssizeof += usedbytes;
+        available -= usedbytes;
+    }
+    
+    header = &p->ropframereadytotx->framedata->header;
+    ropsnumberof = nregulars + noccasionals + nreplies;
+    
+    p->gather.segments[0].data = (const uint8_t*)p->ropframereadytotx->framedata;
+    p->gather.segments[0].size = sizeof(EOropframeHeader_t) + header->ropssizeof;
+    
+    segment->data = (const uint8_t*)&s_eo_transmitter_gather_footer;
+    segment->size = sizeof(EOropframeFooter_t);
+    segment++;
+    
+    p->gather.numberofsegments = segment - &p->gather.segments[0];
+    p->gather.totalsize = eo_ropframe_sizeforZEROrops + ropssizeof;
+    
+    // the header describes the whole ropframe, thus also the rops which are not inside the first segment
+    header->ropssizeof = ropssizeof;
+    header->ropsnumberof = ropsnumberof;
+    
+    if(NULL != ropsnum)
+    {
+        ropsnum->numberofregulars = nregulars;
+        ropsnum->numberofoccasionals = noccasionals;
+        ropsnum->numberofreplies = nreplies;
+    }
+    
+    if(NULL != numberofrops)
+    {
+        *numberofrops = ropsnumberof;
+    }
+    
+    s_eo_transmitter_adaptive_update(p, ropssizeof, capacity);
+    
+    p->txdecimationprogressive ++;
+    
+    return(eores_OK); 
+}
+
+
 extern eOresult_t eo_transmitter_TXdecimation_Set(EOtransmitter *p, uint8_t repliesTXdecimation, uint8_t regularsTXdecimation, uint8_t occasionalsTXdecimation)
 {
     if(NULL == p) 
@@ -1178,13 +1515,155 @@ extern eOresult_t eo_transmitter_TXdecimation_Set(EOtransmitter *p, uint8_t repl
     }
     
     p->txdecimationreplies      = repliesTXdecimation;
-    p->txdecimationregulars     = regularsTXdecimation;
     p->txdecimationoccasionals  = occasionalsTXdecimation;
+    if(eobool_true == p->adaptive.enabled)
+    {   // the adaptive mode owns the decimation of the regulars: we keep the value for when it is disabled
+        p->adaptive.staticregularsdecimation = regularsTXdecimation;
+    }
+    else
+    {
+        p->txdecimationregulars = regularsTXdecimation;
+    }
+    
     
-    
     return(eores_NOK_nullpointer);       
 }
 
+
+extern eOresult_t eo_transmitter_Packing_Set(EOtransmitter *p, const eOtransmitter_packing_t *packing)
+{
+    uint8_t found = 0;
+    uint8_t i = 0;
+    
+    if(NULL == p) 
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    if(NULL == packing)
+    {
+        packing = &eo_transmitter_packing_default;
+    }
+    
+    // every category must appear once inside the priorities
+    for(i=0; i<eo_transmitter_categories_numberof; i++)
+    {
+        if(packing->priority[i] >= eo_transmitter_categories_numberof)
+        {
+            return(eores_NOK_generic);
+        }
+        found |= (1 << packing->priority[i]);
+    }
+    
+    if(((1 << eo_transmitter_categories_numberof) - 1) != found)
+    {
+        return(eores_NOK_generic);
+    }
+    
+    p->packing = *packing;
+    
+    return(eores_OK);
+}
+
+
+extern eOresult_t eo_transmitter_Packing_GetStatistics(EOtransmitter *p, eOtransmitter_packingstatistics_t *stats)
+{
+    if((NULL == p) || (NULL == stats)) 
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    *stats = p->packingstatistics;
+    
+    return(eores_OK);
+}
+
+
+extern eOresult_t eo_transmitter_TXadaptive_Set(EOtransmitter *p, const eOtransmitter_adaptive_cfg_t *cfg)
+{
+    if(NULL == p) 
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    if(NULL == cfg)
+    {   // we go back to the decimation of eo_transmitter_TXdecimation_Set()
+        if(eobool_true == p->adaptive.enabled)
+        {
+            p->txdecimationregulars = p->adaptive.staticregularsdecimation;
+        }
+        p->adaptive.enabled = eobool_false;
+        p->txdecimationcycled = 1;
+        return(eores_OK);
+    }
+    
+    if( (0 == cfg->minregularsdecimation) || (cfg->minregularsdecimation > cfg->maxregularsdecimation) || 
+        (0 == cfg->maxcycleddecimation) || (cfg->lowfill >= cfg->highfill) || (0 == cfg->window) )
+    {
+        return(eores_NOK_generic);
+    }
+    
+    p->adaptive.cfg = *cfg;
+    
+    if(eobool_false == p->adaptive.enabled)
+    {   // if it is already enabled, txdecimationregulars is the adaptive one
+        p->adaptive.staticregularsdecimation = p->txdecimationregulars;
+    }
+    
+    // we start from the least decimation and we restart the window
+    p->txdecimationregulars = cfg->minregularsdecimation;
+    p->txdecimationcycled = 1;
+    
+    memset(&p->adaptive.state, 0, sizeof(p->adaptive.state));
+    p->adaptive.state.regularsdecimation = p->txdecimationregulars;
+    p->adaptive.state.cycleddecimation = p->txdecimationcycled;
+    p->adaptive.packets = 0;
+    p->adaptive.usedbytes = 0;
+    p->adaptive.capacitybytes = 0;
+    p->adaptive.overflowbytes = s_eo_transmitter_adaptive_overflowbytes(p);
+    p->adaptive.sequenceerrorsseen = s_eo_transmitter_adaptive_sequenceerrors(p);
+    p->adaptive.enabled = eobool_true;
+    
+    return(eores_OK);
+}
+
+
+extern eOresult_t eo_transmitter_TXadaptive_ReportSequenceErrors(EOtransmitter *p, uint32_t errors)
+{
+    if(NULL == p) 
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+#if defined(EOTRANSMITTER_ATOMICS)
+    atomic_fetch_add_explicit(&p->adaptive.sequenceerrors, errors, memory_order_relaxed);
+#else
+    eov_mutex_Take(p->mtx_regulars, eok_reltimeINFINITE);
+    p->adaptive.sequenceerrors += errors;
+    eov_mutex_Release(p->mtx_regulars);
+#endif
+    
+    return(eores_OK);
+}
+
+
+extern eOresult_t eo_transmitter_TXadaptive_Get(EOtransmitter *p, eOtransmitter_adaptive_state_t *state)
+{
+    if((NULL == p) || (NULL == state)) 
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    if(eobool_false == p->adaptive.enabled)
+    {
+        return(eores_NOK_generic);
+    }
+    
+    *state = p->adaptive.state;
+    
+    return(eores_OK);
+}
+
 extern eOresult_t eo_transmitter_outpacket_SetRemoteAddress(EOtransmitter *p, eOipv4addr_t remaddr, eOipv4port_t remport)
 {
     if(NULL == p) 
@@ -1250,6 +1729,32 @@ extern eOresult_t eo_transmitter_outpacket_Get(EOtransmitter *p, EOpacket **outp
     return(eores_OK);   
 }
 
+extern eOresult_t eo_transmitter_outpacket_GetGather(EOtransmitter *p, eOtransmitter_gather_t *gather)
+{
+    if((NULL == p) || (NULL == gather)) 
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    // the header is inside the first segment, thus we can patch it in place
+    eo_ropframe_age_Set(p->ropframereadytotx, eov_sys_LifeTimeGet(eov_sys_GetHandle()));
+    p->tx_seqnum++;
+    eo_ropframe_seqnum_Set(p->ropframereadytotx, p->tx_seqnum);
+    
+    p->gather.remaddr = p->ipv4addr;
+    p->gather.remport = p->ipv4port;
+    
+    memcpy(gather, &p->gather, sizeof(eOtransmitter_gather_t));
+    
+    // if the confirmation manager is active .. call it
+    if(NULL != p->confmanager)
+    {
+        eo_confman_ConfirmationRequests_Process(p->confmanager, p->ipv4addr);
+    }
+    
+    return(eores_OK);
+}
+
 extern eOresult_t eo_transmitter_lasterror_Get(EOtransmitter *p, int32_t *err, int32_t *info0, int32_t *info1, int32_t *info2)
 {
 //    eOresult_t res;
@@ -1275,13 +1780,13 @@ extern eOresult_t eo_transmitter_lasterror_Get(EOtransmitter *p, int32_t *err, i
 
 extern eOresult_t eo_transmitter_occasional_rops_Load(EOtransmitter *p, eOropdescriptor_t* ropdesc)
 {   // we dont care about p->ropframeoccasionals being invalid because all controls are inside s_eo_transmitter_rops_Load().
-    return(s_eo_transmitter_rops_Load(p, ropdesc, p->ropframeoccasionals, p->mtx_occasionals));
+    return(s_eo_transmitter_rops_Load(p, ropdesc, p->ropframeoccasionals, p->mtx_occasionals, eo_transm_staging_occasionals));
 }
 
 
 extern eOresult_t eo_transmitter_reply_rops_Load(EOtransmitter *p, eOropdescriptor_t* ropdesc)
 {   // we dont care about p->ropframereplies being invalid because all controls are inside s_eo_transmitter_rops_Load().
-    return(s_eo_transmitter_rops_Load(p, ropdesc, p->ropframereplies, p->mtx_replies));
+    return(s_eo_transmitter_rops_Load(p, ropdesc, p->ropframereplies, p->mtx_replies, eo_transm_staging_replies));
 }
 
 
@@ -1308,56 +1813,197 @@ extern eOresult_t eo_transmitter_reply_ropframe_Load(EOtransmitter *p, EOropfram
 extern eOresult_t eo_transmitter_occasional_rops_LoadStream(EOtransmitter *p, uint8_t *stream, uint16_t size)
 {    
     eOresult_t res;
+    uint16_t offset = 0;
+    uint16_t ropsinstream = 0;
+    
+    if(NULL == p) 
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    eov_mutex_Take(p->mtx_occasionals, eok_reltimeINFINITE);
+    
+    offset = p->ropframeoccasionals->framedata->header.ropssizeof;
     res = eo_ropframe_ROPdata_Add(p->ropframeoccasionals, stream, size, NULL);
+    
+    // the rops of the stream are indexed one by one. a coalesced rop is removed, so the next one takes its offset
+    while((eores_OK == res) && (offset < p->ropframeoccasionals->framedata->header.ropssizeof))
+    {
+        uint16_t ropsize = eo_ropframe_hid_ropsize(eo_ropframe_hid_get_pointer_offset(p->ropframeoccasionals, offset));
+        if(0 != ropsinstream++)
+        {   // eo_ropframe_ROPdata_Add() counts the whole stream as a single rop
+            p->ropframeoccasionals->framedata->header.ropsnumberof ++;
+        }
+        if(eobool_false == s_eo_transmitter_occropindex_coalesce(p, offset, ropsize, eobool_true))
+        {
+            offset += ropsize;
+        }
+    }
+    
+    eov_mutex_Release(p->mtx_occasionals);
+    
     return(res);
 }
 
 
-// --------------------------------------------------------------------------------------------------------------------
-// - definition of extern hidden functions 
-// --------------------------------------------------------------------------------------------------------------------
-// empty-section
+extern eOresult_t eo_transmitter_occasional_rops_Coalescing_Set(EOtransmitter *p, eObool_t enable)
+{
+    uint16_t capacity = 0;
+    uint32_t slots = 1;
+    uint8_t log2slots = 0;
+    
+    if(NULL == p) 
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    eov_mutex_Take(p->mtx_occasionals, eok_reltimeINFINITE);
+    
+    if(eobool_false == enable)
+    {
+        s_eo_transmitter_occropindex_deinit(p);
+    }
+    else if(NULL == p->occropindex.slots)
+    {
+        // the smallest rop is made of its head only
+        eo_ropframe_EffectiveCapacity_Get(p->ropframeoccasionals, &capacity);
+        while(slots < (2*((uint32_t)capacity/sizeof(eOrophead_t) + 1)))
+        {
+            slots <<= 1;
+            log2slots ++;
+        }
+        
+        p->occropindex.slots = (eo_transm_occrop_slot_t*) eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_auto, sizeof(eo_transm_occrop_slot_t), slots);
+        memset(p->occropindex.slots, 0, slots*sizeof(eo_transm_occrop_slot_t));
+        p->occropindex.capacity = slots;
+        p->occropindex.shift = 32 - log2slots;
+        p->occropindex.generation = 0;
+        
+        // the rops already waiting can be coalesced as well
+        s_eo_transmitter_occropindex_rebuild(p);
+    }
+    
+    eov_mutex_Release(p->mtx_occasionals);
+    
+    return(eores_OK);
+}
 
 
-// --------------------------------------------------------------------------------------------------------------------
-// - definition of static functions 
-// --------------------------------------------------------------------------------------------------------------------
+extern uint32_t eo_transmitter_occasional_rops_Coalesced_Get(EOtransmitter *p)
+{
+    if(NULL == p) 
+    {
+        return(0);
+    }
+    
+    return(p->occropindex.coalesced);
+}
 
 
-static eOresult_t s_eo_transmitter_ropmatchingrule_rule(void *item, void *param)
+extern eOresult_t eo_transmitter_Staging_Set(EOtransmitter *p, uint8_t numberofproducers, uint16_t capacityofqueue)
 {
-    eo_transm_regrop_info_t *inside = (eo_transm_regrop_info_t*)item;
-    eOropdescriptor_t *targetrop = (eOropdescriptor_t*)param;
-
-//    if((inside->thenv.id32 == targetrop->id32) && (inside->ropcode == targetrop->ropcode))
-    if(inside->thenv.id32 == targetrop->id32)
+#if defined(EOTRANSMITTER_STAGING)
+    eo_transm_staging_t *staging = NULL;
+    uint32_t capacity = 4;
+    uint32_t minimum = 0;
+    uint8_t i = 0;
+    uint8_t q = 0;
+    
+    if(NULL == p) 
     {
-        return(eores_OK);
+        return(eores_NOK_nullpointer);
     }
-    else
+    
+    if((NULL != atomic_load_explicit(&p->staging, memory_order_relaxed)) || (0 == numberofproducers))
     {
         return(eores_NOK_generic);
     }
+    
+    // a queue must contain at least two rops of max size: head + data + sign + time, each one with its 4-byte record header
+    minimum = 2 * (4 + sizeof(eOrophead_t) + eo_rop_datafield_effective_size(p->roptmp->stream.capacity) + 4 + 8);
+    if(capacityofqueue > minimum)
+    {
+        minimum = capacityofqueue;
+    }
+    while(capacity < minimum)
+    {
+        capacity <<= 1;
+    }
+    
+    staging = (eo_transm_staging_t*) eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_64bit, sizeof(eo_transm_staging_t), 1);
+    staging->producers = (eo_transm_staging_producer_t*) eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_64bit, sizeof(eo_transm_staging_producer_t), numberofproducers);
+    staging->next = NULL;
+    staging->numberofproducers = numberofproducers;
+    staging->first = 0;
+    atomic_init(&staging->fallbacks, 0);
+    
+    // the producers form their streams concurrently: the former must not be initialised lazily by one of them
+    eo_former_GetHandle();
+    
+    for(i=0; i<numberofproducers; i++)
+    {
+        eo_transm_staging_producer_t *producer = &staging->producers[i];
+        atomic_init(&producer->owner, 0);
+        producer->rop = eo_rop_New(p->roptmp->stream.capacity);
+        // a queue gets memory only if the transmitter has a ropframe where to drain it
+        producer->queues[eo_transm_staging_occasionals].capacity = (NULL == p->bufferropframeoccasionals) ? (0) : (capacity);
+        producer->queues[eo_transm_staging_replies].capacity = (NULL == p->bufferropframereplies) ? (0) : (capacity);
+        for(q=0; q<2; q++)
+        {
+            eo_transm_staging_queue_t *queue = &producer->queues[q];
+            queue->data = (0 == queue->capacity) ? (NULL) : ((uint8_t*)eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_32bit, queue->capacity, 1));
+            atomic_init(&queue->head, 0);
+            atomic_init(&queue->tail, 0);
+        }
+    }
+    
+    s_eo_transmitter_staging_register(staging, eobool_true);
+    
+    // release: a producer which sees the pointer also sees the producers initialised above
+    atomic_store_explicit(&p->staging, staging, memory_order_release);
+    
+    return(eores_OK);
+#else
+    if(NULL == p) 
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    return(eores_NOK_unsupported);
+#endif
 }
 
-static eOresult_t s_eo_transmitter_entitymatchingrule_rule(void *item, void *param)
-{
-    eo_transm_regrop_info_t *inside = (eo_transm_regrop_info_t*)item;
-    uint32_t *id32 = (uint32_t*)param;
 
-    uint32_t id32_inside_masked = inside->thenv.id32 & 0xffff0000;
-    uint32_t id32_target_masked = *id32 & 0xffff0000; 
-    if(id32_inside_masked == id32_target_masked)
-    {
-        return(eores_OK);
-    }
-    else
+extern uint32_t eo_transmitter_Staging_Fallbacks_Get(EOtransmitter *p)
+{
+#if defined(EOTRANSMITTER_STAGING)
+    eo_transm_staging_t *staging = NULL;
+    
+    if(NULL == p) 
     {
-        return(eores_NOK_generic);
+        return(0);
     }
+    
+    staging = atomic_load_explicit(&p->staging, memory_order_acquire);
+    
+    return((NULL == staging) ? (0) : (atomic_load_explicit(&staging->fallbacks, memory_order_relaxed)));
+#else
+    return(0);
+#endif
 }
 
 
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of extern hidden functions 
+// --------------------------------------------------------------------------------------------------------------------
+// empty-section
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of static functions 
+// --------------------------------------------------------------------------------------------------------------------
+
+
 static void s_eo_transmitter_list_updaterop_in_ropframe(void *item, void *param)
 {
     eo_transm_regrop_info_t *inside = (eo_transm_regrop_info_t*)item;
@@ -1376,7 +2022,15 @@ static void s_eo_transmitter_list_updaterop_in_ropframe(void *item, void *param)
         // by using eo_nv_hid_Fast_LocalMemoryGet() we use the protection which is configured
         // by the EOnvscfg object, and the concurrent access to the netvar is managed
         // internally the nv object.
-        eo_nv_hid_Fast_LocalMemoryGet(&inside->thenv, dest);
+        if(eo_transmitter_refresh_dirtyonly == p->refreshmode)
+        {
+            p->refreshedbytes += eo_nv_hid_Fast_LocalMemoryGetIfDirty(&inside->thenv, dest);
+        }
+        else
+        {
+            eo_nv_hid_Fast_LocalMemoryGet(&inside->thenv, dest);
+            p->refreshedbytes += inside->thenv.rom->capacity;
+        }
         
         // with memcpy the copy from local buffer to dest is not protected, thus data format may be corrupt
         // in case any concurrent task is in the process of writing the local buffer.
@@ -1416,15 +2070,33 @@ static void s_eo_transmitter_list_shiftdownropinfo(void *item, void *param)
 }
 
 
-static eOresult_t s_eo_transmitter_rops_Load(EOtransmitter *p, eOropdescriptor_t* ropdesc, EOropframe* intoropframe, EOVmutexDerived* mtx)
+static void s_eo_transmitter_list_loaddirty(void *item, void *param)
+{
+    eo_transm_regrop_info_t *inside = (eo_transm_regrop_info_t*)item;
+    EOtransmitter *p = (EOtransmitter*)param;
+    EOnv nv;
+    
+    // we only need the dirty flag, which the nvset places in the EOnv it returns
+    if(eores_OK == eo_nvset_NV_Get(p->nvset, inside->thenv.id32, &nv))
+    {
+        eo_nv_hid_LoadDirty(&inside->thenv, nv.dirty);
+    }
+}
+
+
+static eOresult_t s_eo_transmitter_rops_Load(EOtransmitter *p, eOropdescriptor_t* ropdesc, EOropframe* intoropframe, EOVmutexDerived* mtx, eo_transm_stagingcategory_t stagingcategory)
 {
     // marco.accame on 23oct14: mtx protects the occasional or replies ropframe. p->mtx_roptmp protects the use of tmprop
     eOresult_t res;
     uint16_t usedbytes;
     uint16_t ropsize;
     uint16_t remainingbytes;   
+    uint16_t addedinpos = 0;
     EOnv nv;
-    eObool_t boolres = eobool_false;
+    eObool_t boolres = eobool_true;
+#if defined(EOTRANSMITTER_STAGING)
+    eo_transm_staging_producer_t *producer = NULL;
+#endif
     
     if((NULL == p) || (NULL == ropdesc)) 
     {
@@ -1435,12 +2107,19 @@ static eOresult_t s_eo_transmitter_rops_Load(EOtransmitter *p, eOropdescriptor_t
         return(eores_NOK_nullpointer);
     } 
     
-    // marco.accame on 23oct14
-    // must protect the reading of the ropframe. it has happened that boolres is false even for a good ropframe. 
-    // reason is concurrent tx of the packet and call of this function
-    eov_mutex_Take(mtx, eok_reltimeINFINITE);
-    boolres = eo_ropframe_IsValid(intoropframe);
-    eov_mutex_Release(mtx);
+#if defined(EOTRANSMITTER_STAGING)
+    // in staging mode the thread which owns a producer never touches the ropframe: its queue is checked later on
+    producer = s_eo_transmitter_staging_producer_get(p);
+    if(NULL == producer)
+#endif
+    {
+        // marco.accame on 23oct14
+        // must protect the reading of the ropframe. it has happened that boolres is false even for a good ropframe. 
+        // reason is concurrent tx of the packet and call of this function
+        eov_mutex_Take(mtx, eok_reltimeINFINITE);
+        boolres = eo_ropframe_IsValid(intoropframe);
+        eov_mutex_Release(mtx);
+    }
     
     if(eobool_false == boolres)
     {   // marco.accame: i added it on 15 may 2014 to exit from function if the ropframe does not have any data
@@ -1488,34 +2167,55 @@ static eOresult_t s_eo_transmitter_rops_Load(EOtransmitter *p, eOropdescriptor_t
     }
 
 
-    // we begin the use in rw of p->tmprop: take its mutex ... we must avoid that a concurrent thread use it at the same time.
-    eov_mutex_Take(p->mtx_roptmp, eok_reltimeINFINITE);
-           
-    res = eo_agent_OutROPprepare(p->agent, &nv, ropdesc, p->roptmp, &usedbytes);    
-    
-    if(eores_OK != res)
-    {
-        p->lasterror = 4;
-        eov_mutex_Release(p->mtx_roptmp);
-        return(res);
+#if defined(EOTRANSMITTER_STAGING)
+    if(NULL != producer)
+    {   // the rop is formed inside the rop of the producer and its stream goes into the queue. no mutex at all
+        res = eo_agent_OutROPprepare(p->agent, &nv, ropdesc, producer->rop, &usedbytes);
+        
+        if(eores_OK != res)
+        {
+            p->lasterror = 4;
+            return(res);
+        }
+        
+        res = s_eo_transmitter_staging_push(p, &producer->queues[stagingcategory], producer->rop);
     }
-
-    // put the rop inside the ropframe: protec ropframe vs concurrent use
-    eov_mutex_Take(mtx, eok_reltimeINFINITE);
-    res = eo_ropframe_ROP_Add(intoropframe, p->roptmp, NULL, &ropsize, &remainingbytes);
-    eov_mutex_Release(mtx);
-    
-    // we dont use p->tmprop anymore: release its mutex
-    eov_mutex_Release(p->mtx_roptmp);
-    
-    if(eores_OK != res)
+    else
+#endif
     {
-        uint16_t ss = 0;
-        p->lasterror_info0 = ropsize;
-        p->lasterror_info1 = remainingbytes;
-        eo_ropframe_EffectiveCapacity_Get(intoropframe, &ss); // no need to protect using mutex as we read its capacity which stays constant all over the time
-        p->lasterror_info2  = ss;
-        p->lasterror = 5;
+        // we begin the use in rw of p->tmprop: take its mutex ... we must avoid that a concurrent thread use it at the same time.
+        eov_mutex_Take(p->mtx_roptmp, eok_reltimeINFINITE);
+               
+        res = eo_agent_OutROPprepare(p->agent, &nv, ropdesc, p->roptmp, &usedbytes);    
+        
+        if(eores_OK != res)
+        {
+            p->lasterror = 4;
+            eov_mutex_Release(p->mtx_roptmp);
+            return(res);
+        }
+
+        // put the rop inside the ropframe: protec ropframe vs concurrent use
+        eov_mutex_Take(mtx, eok_reltimeINFINITE);
+        res = eo_ropframe_ROP_Add(intoropframe, p->roptmp, &addedinpos, &ropsize, &remainingbytes);
+        if((eores_OK == res) && (eo_transm_staging_occasionals == stagingcategory))
+        {
+            s_eo_transmitter_occropindex_coalesce(p, addedinpos, ropsize, eobool_true);
+        }
+        eov_mutex_Release(mtx);
+        
+        // we dont use p->tmprop anymore: release its mutex
+        eov_mutex_Release(p->mtx_roptmp);
+        
+        if(eores_OK != res)
+        {
+            uint16_t ss = 0;
+            p->lasterror_info0 = ropsize;
+            p->lasterror_info1 = remainingbytes;
+            eo_ropframe_EffectiveCapacity_Get(intoropframe, &ss); // no need to protect using mutex as we read its capacity which stays constant all over the time
+            p->lasterror_info2  = ss;
+            p->lasterror = 5;
+        }
     }
     
     
@@ -1569,8 +2269,14 @@ static EOropframe * s_eo_transmitter_get_cycled_regropframe(EOtransmitter* p, ui
     EOropframe* ret = NULL;
     uint16_t s0 = eo_ropframe_ROP_NumberOf(p->ropframeregulars_cycle0of);
     uint16_t s1 = eo_ropframe_ROP_NumberOf(p->ropframeregulars_cycle1of);
+    uint64_t cycle = p->txregularsprogressive / p->txdecimationcycled;
     
-    if(0 == (s0+s1))
+    if(0 != (p->txregularsprogressive % p->txdecimationcycled))
+    {   // the cycled regulars are decimated and this is not their turn
+        ret = NULL;
+        *ropsinside = 0;
+    }
+    else if(0 == (s0+s1))
     {   // we dont have any
         ret = NULL;
         *ropsinside = 0;
@@ -1587,7 +2293,7 @@ static EOropframe * s_eo_transmitter_get_cycled_regropframe(EOtransmitter* p, ui
     }
     else
     {   // we have both. i must alternate
-        if(0 == (p->txregularsprogressive % 2))
+        if(0 == (cycle % 2))
         {   // we chose cycle0
             ret = p->ropframeregulars_cycle0of;
             *ropsinside = s0;
@@ -1672,6 +2378,949 @@ static void s_eo_transmitter_regulars_update_sizes(EOtransmitter *p, eo_transm_r
     p->maxsizeofregulars = s_eo_transmitter_get_maxsizeof_regularsropframe(p);
 }
 
+
+static void s_eo_transmitter_regulars_remove(EOtransmitter *p, EOlistIter *li)
+{
+    eo_transm_regrop_info_t regropinfo;
+    
+    // copy what is inside the list into a temporary variable
+    memcpy(&regropinfo, eo_list_At(p->listofregropinfo, li), sizeof(eo_transm_regrop_info_t));
+    
+    // for each element after li: (name is afterli) retrieve it and modify its content so that ropstarthere is decremented by regropinfo.ropsize ...
+    // but only if ... the element is inside the same regropframe. that is done in function s_eo_transmitter_list_shiftdownropinfo()
+    eo_list_ExecuteFromIter(p->listofregropinfo, s_eo_transmitter_list_shiftdownropinfo, &regropinfo, eo_list_Next(p->listofregropinfo, li));
+    
+    // remove the element indexed by li from the list and from its index
+    eo_list_Erase(p->listofregropinfo, li);
+    s_eo_transmitter_regropindex_remove(p, regropinfo.thenv.id32);
+    
+    // inside the p->ropframeregulars: remove a rop of regropinfo.ropsize which starts at regropinfo.ropstartshere. use a _friend method in here defined.
+    //                                 you must: decrement the nrops by 1, decrement the size by regropinfo.ropsize, ... else in header and private variable ...
+    //                                           and finally make a memmove down by regropinfo.ropsize.
+    eo_ropframe_ROP_Rem(regropinfo.ropframe, regropinfo.ropstarthere, regropinfo.ropsize);
+    
+    // decrement the size of relevant ropframe
+    s_eo_transmitter_regulars_update_sizes(p, (eo_transm_regropframe_t)regropinfo.regropframetype, -regropinfo.ropsize); // with a -regropinfo.ropsize we decrement    
+}
+
+
+// the index of listofregropinfo is a hash table w/ open addressing and linear probing. it has at least twice the 
+// slots of the items in the list, thus the probe sequences stay short and the lookup of a regular rop does not depend anymore
+// on how many regulars are loaded. we use a multiplicative (fibonacci) hash of the id32 and backward shift deletion, so that
+// we dont need tombstones.
+
+EO_static_inline uint32_t s_eo_transmitter_regropindex_hash(const eo_transm_regrop_index_t *idx, eOnvID32_t id32)
+{
+    return((uint32_t)(id32 * 2654435769UL) >> idx->shift);
+}
+
+
+static void s_eo_transmitter_regropindex_init(EOtransmitter *p, uint16_t maxnumberofregularrops)
+{
+    uint32_t capacity = 1;
+    uint8_t log2capacity = 0;
+    
+    p->regropindex.slots = NULL;
+    p->regropindex.capacity = 0;
+    p->regropindex.shift = 32;
+    
+    if(0 == maxnumberofregularrops)
+    {
+        return;
+    }
+    
+    while(capacity < (2*(uint32_t)maxnumberofregularrops))
+    {
+        capacity <<= 1;
+        log2capacity ++;
+    }
+    
+    p->regropindex.slots = (eo_transm_regrop_slot_t*) eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_auto, sizeof(eo_transm_regrop_slot_t), capacity);
+    p->regropindex.capacity = capacity;
+    p->regropindex.shift = 32 - log2capacity;
+    
+    s_eo_transmitter_regropindex_clear(p);
+}
+
+
+static void s_eo_transmitter_regropindex_deinit(EOtransmitter *p)
+{
+    if(NULL != p->regropindex.slots)
+    {
+        eo_mempool_Delete(eo_mempool_GetHandle(), p->regropindex.slots);
+        p->regropindex.slots = NULL;
+    }
+    p->regropindex.capacity = 0;
+}
+
+
+static void s_eo_transmitter_regropindex_clear(EOtransmitter *p)
+{
+    if(NULL != p->regropindex.slots)
+    {
+        memset(p->regropindex.slots, 0, p->regropindex.capacity*sizeof(eo_transm_regrop_slot_t));
+    }
+}
+
+
+static EOlistIter * s_eo_transmitter_regropindex_find(EOtransmitter *p, eOnvID32_t id32)
+{
+    eo_transm_regrop_index_t *idx = &p->regropindex;
+    uint32_t mask = idx->capacity - 1;
+    uint32_t i = 0;
+    
+    if(NULL == idx->slots)
+    {
+        return(NULL);
+    }
+    
+    for(i = s_eo_transmitter_regropindex_hash(idx, id32); NULL != idx->slots[i].iter; i = (i+1) & mask)
+    {
+        if(id32 == idx->slots[i].id32)
+        {
+            return(idx->slots[i].iter);
+        }
+    }
+    
+    return(NULL);
+}
+
+
+static void s_eo_transmitter_regropindex_insert(EOtransmitter *p, eOnvID32_t id32, EOlistIter *li)
+{
+    eo_transm_regrop_index_t *idx = &p->regropindex;
+    uint32_t mask = idx->capacity - 1;
+    uint32_t i = 0;
+    
+    if((NULL == idx->slots) || (NULL == li))
+    {
+        return;
+    }
+    
+    // the index has more slots than the list has items, thus there is always an empty slot
+    for(i = s_eo_transmitter_regropindex_hash(idx, id32); NULL != idx->slots[i].iter; i = (i+1) & mask)
+    {
+        if(id32 == idx->slots[i].id32)
+        {
+            break;
+        }
+    }
+    
+    idx->slots[i].id32 = id32;
+    idx->slots[i].iter = li;
+}
+
+
+static void s_eo_transmitter_regropindex_remove(EOtransmitter *p, eOnvID32_t id32)
+{
+    eo_transm_regrop_index_t *idx = &p->regropindex;
+    uint32_t mask = idx->capacity - 1;
+    uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t h = 0;
+    
+    if(NULL == idx->slots)
+    {
+        return;
+    }
+    
+    for(i = s_eo_transmitter_regropindex_hash(idx, id32); NULL != idx->slots[i].iter; i = (i+1) & mask)
+    {
+        if(id32 == idx->slots[i].id32)
+        {
+            break;
+        }
+    }
+    
+    if(NULL == idx->slots[i].iter)
+    {   // not found
+        return;
+    }
+    
+    // backward shift deletion: we empty slot i and we move back into it any following item of the same cluster 
+    // whose home slot h is not cyclically inside (i, j]. then we repeat with the slot j just emptied.
+    j = i;
+    for(;;)
+    {
+        idx->slots[i].iter = NULL;
+        
+        for(;;)
+        {
+            j = (j+1) & mask;
+            if(NULL == idx->slots[j].iter)
+            {
+                return;
+            }
+            h = s_eo_transmitter_regropindex_hash(idx, idx->slots[j].id32);
+            if( (i <= j) ? ((i < h) && (h <= j)) : ((i < h) || (h <= j)) )
+            {   // the item in j can stay where it is
+                continue;
+            }
+            break;
+        }
+        
+        idx->slots[i] = idx->slots[j];
+        i = j;
+    }
+}
+
+
+static void s_eo_transmitter_occropindex_deinit(EOtransmitter *p)
+{
+    if(NULL != p->occropindex.slots)
+    {
+        eo_mempool_Delete(eo_mempool_GetHandle(), p->occropindex.slots);
+    }
+    
+    p->occropindex.slots = NULL;
+    p->occropindex.capacity = 0;
+}
+
+
+static void s_eo_transmitter_occropindex_rebuild(EOtransmitter *p)
+{   // must be called with p->mtx_occasionals already taken, every time the rops of ropframeoccasionals are moved
+    uint16_t sizeofrops = 0;
+    uint16_t offset = 0;
+    
+    if(NULL == p->occropindex.slots)
+    {
+        return;
+    }
+    
+    // we empty every slot. only when the generation wraps around we need to clear the memory
+    p->occropindex.generation ++;
+    if(0 == p->occropindex.generation)
+    {
+        memset(p->occropindex.slots, 0, p->occropindex.capacity*sizeof(eo_transm_occrop_slot_t));
+        p->occropindex.generation = 1;
+    }
+    
+    // the rops left inside the ropframe, if any, are indexed again with their new offsets
+    sizeofrops = p->ropframeoccasionals->framedata->header.ropssizeof;
+    while(offset < sizeofrops)
+    {
+        uint16_t ropsize = eo_ropframe_hid_ropsize(eo_ropframe_hid_get_pointer_offset(p->ropframeoccasionals, offset));
+        s_eo_transmitter_occropindex_coalesce(p, offset, ropsize, eobool_false);
+        offset += ropsize;
+    }
+}
+
+
+static eObool_t s_eo_transmitter_occropindex_coalesce(EOtransmitter *p, uint16_t addedinpos, uint16_t ropsize, eObool_t coalesce)
+{   // must be called with p->mtx_occasionals already taken, after the rop was added in addedinpos. it returns eobool_true
+    // if the rop was written over a waiting one and thus removed from the end of ropframeoccasionals
+    eo_transm_occrop_index_t *idx = &p->occropindex;
+    uint8_t *rop = NULL;
+    const eOrophead_t *head = NULL;
+    uint32_t i = 0;
+    
+    if(NULL == idx->slots)
+    {
+        return(eobool_false);
+    }
+    
+    rop = eo_ropframe_hid_get_pointer_offset(p->ropframeoccasionals, addedinpos);
+    head = (const eOrophead_t*)rop;
+    
+    if(((eo_ropcode_set != head->ropc) && (eo_ropcode_ask != head->ropc)) || (1 == head->ctrl.rqstconf))
+    {
+        return(eobool_false);
+    }
+    
+    for(i = (head->id32 * 2654435769U) >> idx->shift; ; i = (i + 1) & (idx->capacity - 1))
+    {
+        eo_transm_occrop_slot_t *slot = &idx->slots[i];
+        
+        if(idx->generation != slot->generation)
+        {   // the first rop with this key
+            slot->id32 = head->id32;
+            slot->offset = addedinpos;
+            slot->ropcode = head->ropc;
+            slot->generation = idx->generation;
+            return(eobool_false);
+        }
+        
+        if((head->id32 == slot->id32) && (head->ropc == slot->ropcode))
+        {
+            uint8_t *waiting = eo_ropframe_hid_get_pointer_offset(p->ropframeoccasionals, slot->offset);
+            
+            if( (eobool_true == coalesce) && (0 == memcmp(&((const eOrophead_t*)waiting)->ctrl, &head->ctrl, sizeof(eOropctrl_t))) && 
+                (ropsize == eo_ropframe_hid_ropsize(waiting)) )
+            {   // the new rop replaces the waiting one in its position and it is removed from the end
+                memcpy(waiting, rop, ropsize);
+                eo_ropframe_ROP_Rem(p->ropframeoccasionals, addedinpos, ropsize);
+                idx->coalesced ++;
+                return(eobool_true);
+            }
+            
+            // the two rops cannot be merged: the later rops will be written over the new one
+            slot->offset = addedinpos;
+            return(eobool_false);
+        }
+    }
+}
+
+
+static uint16_t s_eo_transmitter_regulars_append(EOtransmitter *p, uint16_t maxbytes, uint16_t *usedbytes)
+{
+    EOropframe* cycledregulars = NULL;
+    uint16_t nregularscycled = 0;
+    uint16_t nregulars = 0;
+    uint16_t used = 0;
+    uint8_t slot = 0;
+
+    // refresh all regulars ...    
+    eo_transmitter_regular_rops_Refresh(p);
+    
+    // then copy regulars into the ropframe ready to be transmitted
+    
+    eov_mutex_Take(p->mtx_regulars, eok_reltimeINFINITE);
+    
+    // at first the standard regulars which are always transmitted
+    nregulars += s_eo_transmitter_packing_regulars(p, p->ropframeregulars_standard, eo_ropframe_ROP_NumberOf(p->ropframeregulars_standard), maxbytes, &used);
+    *usedbytes = used;
+    
+    // then add the cycled one, if there are any
+    cycledregulars = s_eo_transmitter_get_cycled_regropframe(p, &nregularscycled);
+    if(NULL != cycledregulars)
+    {
+        nregulars += s_eo_transmitter_packing_regulars(p, cycledregulars, nregularscycled, maxbytes - *usedbytes, &used);
+        *usedbytes += used;
+        slot = (cycledregulars == p->ropframeregulars_cycle0of) ? (1) : (2);
+    }
+    
+    // the regulars just appended may be replaced by their delta rop
+    nregulars = s_eo_transmitter_delta_encode(p, slot, nregulars, maxbytes, usedbytes);
+            
+    eov_mutex_Release(p->mtx_regulars);
+    
+    // very important: increment the regulars progressive number. it is used to decide which cycling regular to get
+    p->txregularsprogressive ++;
+    
+    return(nregulars);
+}
+
+
+static uint16_t s_eo_transmitter_delta_encode(EOtransmitter *p, uint8_t slot, uint16_t nrops, uint16_t maxbytes, uint16_t *usedbytes)
+{   // the nrops regulars of usedbytes bytes at the end of ropframereadytotx are replaced by their delta rop, if it fits in maxbytes.
+    // it returns the number of rops which are now there in place of the regulars
+    eo_transm_delta_reference_t *reference = &p->delta.references[slot];
+    eOropdeltahead_t head = {0};
+    uint8_t *rops = NULL;
+    uint16_t streamsize = 0;
+    eObool_t keyframe = eobool_false;
+    
+    if((0 == p->delta.keyframeperiod) || (0 == nrops))
+    {
+        return(nrops);
+    }
+    
+    rops = eo_ropframe_hid_get_pointer_offset(p->ropframereadytotx, p->ropframereadytotx->framedata->header.ropssizeof - *usedbytes);
+    keyframe = ((reference->size != *usedbytes) || (reference->sincekeyframe >= p->delta.keyframeperiod)) ? (eobool_true) : (eobool_false);
+    
+    head.decodedsize = *usedbytes;
+    head.slot = (eobool_true == keyframe) ? (slot | eo_rop_delta_keyframe) : (slot);
+    head.progressive = reference->progressive + 1;
+    
+    if(eores_OK != eo_former_GetDeltaStream(eo_former_GetHandle(), &head, rops, reference->rops, (maxbytes < p->delta.capacity) ? (maxbytes) : (p->delta.capacity), p->delta.stream, &streamsize))
+    {   // the regulars go as they are. the receiver keeps its reference but we dont know if it has it: next is a key frame
+        reference->size = 0;
+        p->delta.statistics.notencoded ++;
+        return(nrops);
+    }
+    
+    // what the receiver will have after decoding
+    memcpy(reference->rops, rops, *usedbytes);
+    reference->size = *usedbytes;
+    reference->progressive = head.progressive;
+    reference->sincekeyframe = (eobool_true == keyframe) ? (1) : (reference->sincekeyframe + 1);
+    
+    p->delta.statistics.rawbytes += *usedbytes;
+    p->delta.statistics.encodedbytes += streamsize;
+    if(eobool_true == keyframe)
+    {
+        p->delta.statistics.keyframes ++;
+    }
+    else
+    {
+        p->delta.statistics.deltaframes ++;
+    }
+    
+    eo_ropframe_hid_rops_removetail(p->ropframereadytotx, nrops, *usedbytes);
+    eo_ropframe_hid_rops_append(p->ropframereadytotx, p->delta.stream, 1, streamsize);
+    *usedbytes = streamsize;
+    
+    return(1);
+}
+
+
+static void s_eo_transmitter_delta_deinit(EOtransmitter *p)
+{
+    uint8_t i = 0;
+    
+    if(NULL != p->delta.stream)
+    {
+        eo_mempool_Delete(eo_mempool_GetHandle(), p->delta.stream);
+        for(i=0; i<eo_transm_delta_slots; i++)
+        {
+            eo_mempool_Delete(eo_mempool_GetHandle(), p->delta.references[i].rops);
+            p->delta.references[i].rops = NULL;
+            p->delta.references[i].size = 0;
+        }
+    }
+    
+    p->delta.stream = NULL;
+    p->delta.keyframeperiod = 0;
+}
+
+
+static uint16_t s_eo_transmitter_gather_detach(EOropframe *ropframe, uint8_t **buffer, uint8_t **spare)
+{   // must be called with the mutex of ropframe already taken
+    uint8_t *detached = *buffer;
+    uint16_t capacity = ropframe->capacity;
+    uint16_t size = ropframe->framedata->header.ropssizeof;
+    
+    if(NULL == *spare)
+    {
+        *spare = (uint8_t*)eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_32bit, capacity, 1);
+    }
+    
+    // the ropframe continues with the spare buffer. the detached one keeps its rops until next call
+    *buffer = *spare;
+    *spare = detached;
+    eo_ropframe_Load(ropframe, *buffer, eo_ropframe_sizeforZEROrops, capacity);
+    eo_ropframe_Clear(ropframe);
+    
+    return(size);
+}
+
+
+static uint16_t s_eo_transmitter_packing_maxbytes(EOtransmitter *p, eOtransmitter_category_t category, uint16_t available)
+{
+    uint16_t budget = p->packing.budget[category];
+    return(((0 == budget) || (budget > available)) ? (available) : (budget));
+}
+
+
+static uint16_t s_eo_transmitter_packing_regulars(EOtransmitter *p, EOropframe *ropframe, uint16_t nrops, uint16_t maxbytes, uint16_t *usedbytes)
+{   // must be called with p->mtx_regulars already taken. the regulars stay inside their ropframe
+    uint16_t size = 0;
+    uint16_t sizeofnext = 0;
+    
+    *usedbytes = 0;
+    
+    if(0 == nrops)
+    {
+        return(0);
+    }
+    
+    size = ropframe->framedata->header.ropssizeof;
+    
+    if(size <= maxbytes)
+    {
+        eo_ropframe_hid_rops_append(p->ropframereadytotx, eo_ropframe_hid_get_pointer_offset(ropframe, 0), nrops, size);
+        *usedbytes = size;
+        return(nrops);
+    }
+    
+    // only the first ones fit. the others are dropped: they will be sent with fresh values at next packet 
+    *usedbytes = eo_ropframe_hid_rops_fit(ropframe, maxbytes, &nrops, &sizeofnext);
+    eo_ropframe_hid_rops_append(p->ropframereadytotx, eo_ropframe_hid_get_pointer_offset(ropframe, 0), nrops, *usedbytes);
+    p->packingstatistics.droppedbytes[eo_transmitter_category_regulars] += (size - *usedbytes);
+#if defined(USE_DEBUG_EOTRANSMITTER)
+    p->debug.txropframeistoobigforthepacket ++;
+#endif
+    
+    return(nrops);
+}
+
+
+static uint16_t s_eo_transmitter_packing_append(EOtransmitter *p, eOtransmitter_category_t category, EOropframe *ropframe, uint16_t maxbytes, uint16_t *usedbytes)
+{   // must be called with the mutex of ropframe already taken. the rops which are packed are removed from ropframe
+    uint16_t remainingbytes = 0;
+    uint16_t nrops = eo_ropframe_ROP_NumberOf(ropframe);
+    uint16_t size = 0;
+    uint16_t n = 0;
+    uint16_t sizeofnext = 0;
+    
+    *usedbytes = 0;
+    
+    if(0 == nrops)
+    {
+        return(0);
+    }
+    
+    size = ropframe->framedata->header.ropssizeof;
+    
+    if(size <= maxbytes)
+    {   // the usual case: they all fit
+        eo_ropframe_Append(p->ropframereadytotx, ropframe, &remainingbytes);
+        eo_ropframe_Clear(ropframe);
+        *usedbytes = size;
+        return(nrops);
+    }
+    
+    *usedbytes = eo_ropframe_hid_rops_fit(ropframe, maxbytes, &n, &sizeofnext);
+    eo_ropframe_hid_rops_append(p->ropframereadytotx, eo_ropframe_hid_get_pointer_offset(ropframe, 0), n, *usedbytes);
+    eo_ropframe_hid_rops_removehead(ropframe, n, *usedbytes);
+    
+    // what is left is moved at the beginning of the ropframe itself
+    s_eo_transmitter_packing_carryover(p, category, ropframe, NULL, nrops - n, size - *usedbytes, sizeofnext);
+    
+    return(n);
+}
+
+
+static uint16_t s_eo_transmitter_packing_detach(EOtransmitter *p, eOtransmitter_category_t category, EOropframe *ropframe, uint8_t **buffer, uint8_t **spare, uint16_t maxbytes, uint16_t *usedbytes, eOtransmitter_segment_t *segment)
+{   // must be called with the mutex of ropframe already taken. the segment points to the rops which are packed
+    uint8_t *detached = *buffer;
+    uint16_t nrops = eo_ropframe_ROP_NumberOf(ropframe);
+    uint16_t size = 0;
+    uint16_t n = 0;
+    uint16_t sizeofnext = 0;
+    
+    *usedbytes = 0;
+    
+    if(0 == nrops)
+    {
+        return(0);
+    }
+    
+    size = ropframe->framedata->header.ropssizeof;
+    
+    if(size <= maxbytes)
+    {   // the usual case: they all fit
+        n = nrops;
+        *usedbytes = size;
+    }
+    else
+    {
+        *usedbytes = eo_ropframe_hid_rops_fit(ropframe, maxbytes, &n, &sizeofnext);
+    }
+    
+    segment->data = detached + sizeof(EOropframeHeader_t);
+    segment->size = *usedbytes;
+    s_eo_transmitter_gather_detach(ropframe, buffer, spare);
+    
+    if(n != nrops)
+    {   // what is left is copied from the detached buffer into the spare one, which is now used by ropframe
+        s_eo_transmitter_packing_carryover(p, category, ropframe, detached + sizeof(EOropframeHeader_t) + *usedbytes, nrops - n, size - *usedbytes, sizeofnext);
+    }
+    
+    return(n);
+}
+
+
+static uint16_t s_eo_transmitter_packing_carryover(EOtransmitter *p, eOtransmitter_category_t category, EOropframe *ropframe, const uint8_t *rops, uint16_t nrops, uint16_t sizeofrops, uint16_t sizeoffirst)
+{   // rops is NULL if the nrops rops are already at the beginning of ropframe, else they are appended to the empty ropframe
+    uint16_t maxbytes = 0;
+    
+#if defined(USE_DEBUG_EOTRANSMITTER)
+    p->debug.txropframeistoobigforthepacket ++;
+#endif
+    
+    // a rop which does not fit even in an empty packet would block the others forever: we drop it
+    eo_ropframe_EffectiveCapacity_Get(p->ropframereadytotx, &maxbytes);
+    if(sizeoffirst > s_eo_transmitter_packing_maxbytes(p, category, maxbytes))
+    {
+        if(NULL == rops)
+        {
+            eo_ropframe_hid_rops_removehead(ropframe, 1, sizeoffirst);
+        }
+        else
+        {
+            rops += sizeoffirst;
+        }
+        nrops --;
+        sizeofrops -= sizeoffirst;
+        p->packingstatistics.droppedbytes[category] += sizeoffirst;
+    }
+    
+    if(eobool_true == p->packing.carryover)
+    {
+        if(NULL != rops)
+        {
+            eo_ropframe_hid_rops_append(ropframe, rops, nrops, sizeofrops);
+        }
+        p->packingstatistics.deferredbytes[category] += sizeofrops;
+        return(nrops);
+    }
+    
+    if(NULL == rops)
+    {
+        eo_ropframe_Clear(ropframe);
+    }
+    p->packingstatistics.droppedbytes[category] += sizeofrops;
+    
+    return(0);
+}
+
+
+static uint64_t s_eo_transmitter_adaptive_overflowbytes(EOtransmitter *p)
+{
+    uint64_t bytes = 0;
+    uint8_t i = 0;
+    
+    for(i=0; i<eo_transmitter_categories_numberof; i++)
+    {
+        bytes += p->packingstatistics.deferredbytes[i] + p->packingstatistics.droppedbytes[i];
+    }
+    
+    return(bytes);
+}
+
+
+static uint32_t s_eo_transmitter_adaptive_sequenceerrors(EOtransmitter *p)
+{
+#if defined(EOTRANSMITTER_ATOMICS)
+    return(atomic_load_explicit(&p->adaptive.sequenceerrors, memory_order_relaxed));
+#else
+    return(p->adaptive.sequenceerrors);
+#endif
+}
+
+
+static void s_eo_transmitter_adaptive_update(EOtransmitter *p, uint16_t usedbytes, uint16_t capacity)
+{
+    eo_transm_adaptive_t *a = &p->adaptive;
+    uint64_t overflowbytes = 0;
+    uint32_t sequenceerrors = 0;
+    uint8_t fillratio = 0;
+    
+    if(eobool_false == a->enabled)
+    {
+        return;
+    }
+    
+    a->packets ++;
+    a->usedbytes += usedbytes;
+    a->capacitybytes += capacity;
+    
+    if(a->packets < a->cfg.window)
+    {
+        return;
+    }
+    
+    // end of the window: we decide
+    overflowbytes = s_eo_transmitter_adaptive_overflowbytes(p);
+    sequenceerrors = s_eo_transmitter_adaptive_sequenceerrors(p);
+    fillratio = (0 == a->capacitybytes) ? (0) : ((uint8_t)((100ULL * a->usedbytes) / a->capacitybytes));
+    
+    a->state.fillratio = fillratio;
+    a->state.overflowbytes = (uint32_t)(overflowbytes - a->overflowbytes);
+    a->state.sequenceerrors = sequenceerrors - a->sequenceerrorsseen;
+    a->state.decisions ++;
+    
+    if(0 != a->state.sequenceerrors)
+    {
+        a->state.reason = eo_transmitter_adaptive_sequenceerrors;
+    }
+    else if(0 != a->state.overflowbytes)
+    {
+        a->state.reason = eo_transmitter_adaptive_overflow;
+    }
+    else if(fillratio >= a->cfg.highfill)
+    {
+        a->state.reason = eo_transmitter_adaptive_fillhigh;
+    }
+    else if(fillratio < a->cfg.lowfill)
+    {
+        a->state.reason = eo_transmitter_adaptive_filllow;
+    }
+    else
+    {
+        a->state.reason = eo_transmitter_adaptive_hold;
+    }
+    
+    if(eo_transmitter_adaptive_filllow == a->state.reason)
+    {   // we go back: at first the regulars, then the cycled ones
+        if(p->txdecimationregulars > a->cfg.minregularsdecimation)
+        {
+            p->txdecimationregulars --;
+        }
+        else if(p->txdecimationcycled > 1)
+        {
+            p->txdecimationcycled --;
+        }
+        else
+        {
+            a->state.reason = eo_transmitter_adaptive_hold;
+        }
+    }
+    else if(eo_transmitter_adaptive_hold != a->state.reason)
+    {   // the link is loaded: at first we decimate the cycled regulars, then all the regulars
+        if(p->txdecimationcycled < a->cfg.maxcycleddecimation)
+        {
+            p->txdecimationcycled ++;
+        }
+        else if(p->txdecimationregulars < a->cfg.maxregularsdecimation)
+        {
+            p->txdecimationregulars ++;
+        }
+    }
+    
+    a->state.regularsdecimation = p->txdecimationregulars;
+    a->state.cycleddecimation = p->txdecimationcycled;
+    
+    // a new window begins
+    a->packets = 0;
+    a->usedbytes = 0;
+    a->capacitybytes = 0;
+    a->overflowbytes = overflowbytes;
+    a->sequenceerrorsseen = sequenceerrors;
+}
+
+
+static void s_eo_transmitter_staging_deinit(EOtransmitter *p)
+{
+#if defined(EOTRANSMITTER_STAGING)
+    uint8_t i = 0;
+    uint8_t q = 0;
+    eo_transm_staging_t *staging = atomic_load_explicit(&p->staging, memory_order_acquire);
+    
+    if(NULL == staging)
+    {
+        return;
+    }
+    
+    atomic_store_explicit(&p->staging, NULL, memory_order_relaxed);
+    // after that the exit of a thread does not touch its producers anymore
+    s_eo_transmitter_staging_register(staging, eobool_false);
+    
+    for(i=0; i<staging->numberofproducers; i++)
+    {
+        eo_transm_staging_producer_t *producer = &staging->producers[i];
+        eo_rop_Delete(producer->rop);
+        for(q=0; q<2; q++)
+        {
+            if(NULL != producer->queues[q].data)
+            {
+                eo_mempool_Delete(eo_mempool_GetHandle(), producer->queues[q].data);
+            }
+        }
+    }
+    
+    eo_mempool_Delete(eo_mempool_GetHandle(), staging->producers);
+    eo_mempool_Delete(eo_mempool_GetHandle(), staging);
+#endif
+}
+
+
+static void s_eo_transmitter_staging_drain(EOtransmitter *p, eo_transm_stagingcategory_t stagingcategory, EOropframe *ropframe)
+{   // must be called with the mutex of ropframe already taken, so that every queue has a single consumer
+#if defined(EOTRANSMITTER_STAGING)
+    uint8_t i = 0;
+    uint8_t n = 0;
+    eo_transm_staging_t *staging = atomic_load_explicit(&p->staging, memory_order_acquire);
+    
+    if(NULL == staging)
+    {
+        return;
+    }
+    
+    n = staging->numberofproducers;
+    
+    for(i=0; i<n; i++)
+    {
+        eo_transm_staging_queue_t *queue = &staging->producers[(staging->first + i) % n].queues[stagingcategory];
+        uint32_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+        uint32_t head = atomic_load_explicit(&queue->head, memory_order_acquire);
+        
+        while(tail != head)
+        {
+            uint32_t position = tail & (queue->capacity - 1);
+            uint32_t size = *((uint32_t*)&queue->data[position]);
+            
+            if(0 == size)
+            {   // the producer has restarted from the beginning of the ring
+                tail += queue->capacity - position;
+                continue;
+            }
+            
+            uint16_t addedinpos = ropframe->framedata->header.ropssizeof;
+            if(eores_OK != eo_ropframe_ROPdata_Add(ropframe, &queue->data[position + 4], size, NULL))
+            {   // the ropframe is full: the rop stays in the queue until next time
+                break;
+            }
+            
+            if(eo_transm_staging_occasionals == stagingcategory)
+            {
+                s_eo_transmitter_occropindex_coalesce(p, addedinpos, size, eobool_true);
+            }
+            
+            tail += 4 + size;
+        }
+        
+        atomic_store_explicit(&queue->tail, tail, memory_order_release);
+    }
+    
+    staging->first = (staging->first + 1) % n;
+#endif
+}
+
+
+#if defined(EOTRANSMITTER_STAGING)
+
+static eo_transm_staging_producer_t * s_eo_transmitter_staging_producer_get(EOtransmitter *p)
+{
+    uintptr_t self = (uintptr_t)&s_eo_transmitter_staging_thread;
+    uint8_t i = 0;
+    eo_transm_staging_t *staging = atomic_load_explicit(&p->staging, memory_order_acquire);
+    
+    if(NULL == staging)
+    {
+        return(NULL);
+    }
+    
+    for(i=0; i<staging->numberofproducers; i++)
+    {
+        if(self == atomic_load_explicit(&staging->producers[i].owner, memory_order_acquire))
+        {
+            return(&staging->producers[i]);
+        }
+    }
+    
+    // first call from this thread: it takes the first free producer, if any. it gives it back when it exits 
+    for(i=0; i<staging->numberofproducers; i++)
+    {
+        uintptr_t expected = 0;
+        if(atomic_compare_exchange_strong_explicit(&staging->producers[i].owner, &expected, self, memory_order_acq_rel, memory_order_relaxed))
+        {
+#if defined(EOTRANSMITTER_STAGING_THREADEXIT)
+            pthread_once(&s_eo_transmitter_staging_keyonce, s_eo_transmitter_staging_key_create);
+            pthread_setspecific(s_eo_transmitter_staging_key, (void*)self);
+#endif
+            return(&staging->producers[i]);
+        }
+    }
+    
+    // all the producers are taken by other threads: this thread uses the mutexes
+    atomic_fetch_add_explicit(&staging->fallbacks, 1, memory_order_relaxed);
+    return(NULL);
+}
+
+
+static eOresult_t s_eo_transmitter_staging_push(EOtransmitter *p, eo_transm_staging_queue_t *queue, EOrop *rop)
+{   // must be called only by the owner of the queue
+    uint32_t head = 0;
+    uint32_t tail = 0;
+    uint32_t position = 0;
+    uint32_t tillend = 0;
+    uint32_t required = 0;
+    uint16_t ropsize = eo_rop_GetSize(rop);
+    uint32_t recordsize = 4 + (uint32_t)ropsize;
+    uint16_t streamsize = 0;
+    
+    if(NULL == queue->data)
+    {   // the transmitter does not have the ropframe for this kind of rops
+        p->lasterror = 2;
+        return(eores_NOK_generic);
+    }
+    
+    head = atomic_load_explicit(&queue->head, memory_order_acquire);
+    tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+    position = head & (queue->capacity - 1);
+    tillend = queue->capacity - position;
+    required = recordsize;
+    if(tillend < required)
+    {   // the record cannot be split: we also use what remains till the end of the ring
+        required += tillend;
+    }
+    
+    if((queue->capacity - (head - tail)) < required)
+    {   // the queue is full. the rop is lost as it happens with a full ropframe
+        p->lasterror_info0 = ropsize;
+        p->lasterror_info1 = queue->capacity - (head - tail);
+        p->lasterror_info2 = queue->capacity;
+        p->lasterror = 6;
+        return(eores_NOK_generic);
+    }
+    
+    if(tillend < recordsize)
+    {   // the record of size zero tells the consumer to restart from the beginning
+        *((uint32_t*)&queue->data[position]) = 0;
+        head += tillend;
+        position = 0;
+    }
+    
+    if(eores_OK != eo_former_GetStream(eo_former_GetHandle(), rop, ropsize, &queue->data[position + 4], &streamsize))
+    {
+        p->lasterror = 5;
+        return(eores_NOK_generic);
+    }
+    
+    *((uint32_t*)&queue->data[position]) = streamsize;
+    atomic_store_explicit(&queue->head, head + 4 + streamsize, memory_order_release);
+    
+    return(eores_OK);
+}
+
+
+static void s_eo_transmitter_staging_register(eo_transm_staging_t *staging, eObool_t add)
+{
+    eo_transm_staging_t **pp = NULL;
+    
+    while(atomic_flag_test_and_set_explicit(&s_eo_transmitter_staging_lock, memory_order_acquire))
+    {
+        ;
+    }
+    
+    if(eobool_true == add)
+    {
+        staging->next = s_eo_transmitter_staging_all;
+        s_eo_transmitter_staging_all = staging;
+    }
+    else
+    {
+        for(pp = &s_eo_transmitter_staging_all; NULL != *pp; pp = &(*pp)->next)
+        {
+            if(staging == *pp)
+            {
+                *pp = staging->next;
+                break;
+            }
+        }
+    }
+    
+    atomic_flag_clear_explicit(&s_eo_transmitter_staging_lock, memory_order_release);
+}
+
+#if defined(EOTRANSMITTER_STAGING_THREADEXIT)
+
+static void s_eo_transmitter_staging_key_create(void)
+{
+    pthread_key_create(&s_eo_transmitter_staging_key, s_eo_transmitter_staging_threadexit);
+}
+
+
+static void s_eo_transmitter_staging_threadexit(void *self)
+{   
+    // the exiting thread gives back its producers of every transmitter. the rops still inside their queues are 
+    // drained as usual and the next owner continues from where the thread has stopped.
+    eo_transm_staging_t *staging = NULL;
+    uint8_t i = 0;
+    
+    while(atomic_flag_test_and_set_explicit(&s_eo_transmitter_staging_lock, memory_order_acquire))
+    {
+        ;
+    }
+    
+    for(staging = s_eo_transmitter_staging_all; NULL != staging; staging = staging->next)
+    {
+        for(i=0; i<staging->numberofproducers; i++)
+        {
+            uintptr_t expected = (uintptr_t)self;
+            atomic_compare_exchange_strong_explicit(&staging->producers[i].owner, &expected, 0, memory_order_release, memory_order_relaxed);
+        }
+    }
+    
+    atomic_flag_clear_explicit(&s_eo_transmitter_staging_lock, memory_order_release);
+}
+
+#endif
+
+#endif
+
 // --------------------------------------------------------------------------------------------------------------------
 // - end-of-file (leave a blank line after)
 // --------------------------------------------------------------------------------------------------------------------
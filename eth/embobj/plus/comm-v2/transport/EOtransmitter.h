@@ -95,17 +95,157 @@ typedef struct
     EOagent*                        agent;    
 } eOtransmitter_cfg_t;
 
+/** @typedef    typedef enum eOtransmitter_refreshmode_t
+    @brief      tells how eo_transmitter_regular_rops_Refresh() takes the values of the regular rops from their NVs. 
+ **/ 
+typedef enum
+{
+    eo_transmitter_refresh_all          = 0,    /**< every regular rop is copied from its NV at each refresh */
+    eo_transmitter_refresh_dirtyonly    = 1     /**< only the regular rops whose NV was changed since last refresh are copied */
+} eOtransmitter_refreshmode_t;
+
+
 typedef struct
 {
     uint8_t     numberofoccasionals; 
     uint8_t     numberofregulars;
     uint8_t     numberofreplies;    
 } eOtransmitter_ropsnumber_t;
+
+
+enum { eo_transmitter_gather_maxsegments = 4 };
+
+/** @typedef    typedef struct eOtransmitter_segment_t
+    @brief      a contiguous block of bytes of the out packet when it is prepared in scatter-gather mode.
+ **/ 
+typedef struct
+{
+    const uint8_t*  data;
+    uint16_t        size;
+} eOtransmitter_segment_t;
+
+
+/** @typedef    typedef struct eOtransmitter_gather_t
+    @brief      the out packet described as a list of segments (as in an iovec) to be sent in order with a single
+                datagram. the concatenation of the segments is a valid ropframe of totalsize bytes. 
+ **/ 
+typedef struct
+{
+    eOipv4addr_t                remaddr;
+    eOipv4port_t                remport;
+    uint16_t                    totalsize;
+    uint8_t                     numberofsegments;
+    eOtransmitter_segment_t     segments[eo_transmitter_gather_maxsegments];
+} eOtransmitter_gather_t;
+
+
+/** @typedef    typedef enum eOtransmitter_category_t
+    @brief      the kinds of rops which eo_transmitter_outpacket_Prepare() packs inside the out packet. 
+ **/ 
+typedef enum
+{
+    eo_transmitter_category_regulars    = 0,
+    eo_transmitter_category_occasionals = 1,
+    eo_transmitter_category_replies     = 2
+} eOtransmitter_category_t;
+
+enum { eo_transmitter_categories_numberof = 3 };
+
+
+/** @typedef    typedef struct eOtransmitter_packing_t
+    @brief      tells how the rops are packed inside the out packet. the categories are served in order of priority and 
+                each one gets at most its budget of the bytes left by the previous ones. the occasionals and the replies 
+                which do not fit stay in their ropframe for the next packet if carryover is eobool_true, otherwise they 
+                are dropped. the regulars which do not fit are always dropped, as they are sent again at next packet.
+                a rop bigger than the budget of its category is always dropped.
+ **/ 
+typedef struct
+{
+    uint8_t     priority[eo_transmitter_categories_numberof];   /**< the categories in decreasing priority. use values of eOtransmitter_category_t */
+    eObool_t    carryover;                                      /**< if eobool_true, the occasionals and replies which do not fit wait for next packet */
+    uint16_t    budget[eo_transmitter_categories_numberof];     /**< max bytes of rops in a packet for each category, indexed by eOtransmitter_category_t. 0 is no limit */
+} eOtransmitter_packing_t;
+
+
+/** @typedef    typedef struct eOtransmitter_packingstatistics_t
+    @brief      the bytes of rops which did not fit inside the out packet since the creation of the transmitter. a rop which 
+                waits for more than one packet is counted as deferred every time.
+ **/ 
+typedef struct
+{
+    uint64_t    deferredbytes[eo_transmitter_categories_numberof];  /**< indexed by eOtransmitter_category_t */
+    uint64_t    droppedbytes[eo_transmitter_categories_numberof];   /**< indexed by eOtransmitter_category_t */
+} eOtransmitter_packingstatistics_t;
+
+
+/** @typedef    typedef struct eOtransmitter_adaptive_cfg_t
+    @brief      the bounds of the adaptive TX decimation. every @e window packets the transmitter looks at the fill ratio 
+                of the packets, at the bytes deferred or dropped by the packing and at the sequence errors reported by 
+                the remote receiver. if the link is loaded it sends the cycled regulars less often and then it decimates 
+                the regulars. if the link is unloaded it goes back the same way.
+ **/ 
+typedef struct
+{
+    uint8_t     minregularsdecimation;  /**< the regulars decimation used when the link is unloaded. at least 1 */
+    uint8_t     maxregularsdecimation;  /**< the max regulars decimation */
+    uint8_t     maxcycleddecimation;    /**< the max decimation of the cycled regulars, which are used less often before the others. 1 keeps them as they are */
+    uint8_t     highfill;               /**< the fill ratio in percentage above which the link is loaded */
+    uint8_t     lowfill;                /**< the fill ratio in percentage below which the link is unloaded. it must be smaller than highfill */
+    uint8_t     filler;
+    uint16_t    window;                 /**< the number of packets between two decisions */
+} eOtransmitter_adaptive_cfg_t;
+
+
+/** @typedef    typedef enum eOtransmitter_adaptive_reason_t
+    @brief      the reason of the last decision of the adaptive TX decimation.
+ **/ 
+typedef enum
+{
+    eo_transmitter_adaptive_hold            = 0,    /**< nothing changed */
+    eo_transmitter_adaptive_fillhigh        = 1,    /**< the packets were too full */
+    eo_transmitter_adaptive_overflow        = 2,    /**< some rops were deferred or dropped by the packing */
+    eo_transmitter_adaptive_sequenceerrors  = 3,    /**< the remote receiver reported sequence errors */
+    eo_transmitter_adaptive_filllow         = 4     /**< the packets were almost empty */
+} eOtransmitter_adaptive_reason_t;
+
+
+/** @typedef    typedef struct eOtransmitter_adaptive_state_t
+    @brief      the last decision of the adaptive TX decimation and what it was based on.
+ **/ 
+typedef struct
+{
+    uint8_t     regularsdecimation;     /**< the decimation of the regulars now in use */
+    uint8_t     cycleddecimation;       /**< the decimation of the cycled regulars now in use */
+    uint8_t     fillratio;              /**< the average fill ratio of the packets of the last window, in percentage */
+    uint8_t     reason;                 /**< use eOtransmitter_adaptive_reason_t */
+    uint32_t    overflowbytes;          /**< the bytes deferred or dropped by the packing in the last window */
+    uint32_t    sequenceerrors;         /**< the sequence errors reported in the last window */
+    uint32_t    decisions;              /**< the number of windows evaluated so far */
+} eOtransmitter_adaptive_state_t;
+
+
+/** @typedef    typedef struct eOtransmitter_deltastatistics_t
+    @brief      the statistics of the delta encoding of the regulars since it was enabled.
+ **/ 
+typedef struct
+{
+    uint64_t    rawbytes;               /**< the bytes of the regular rops which were encoded */
+    uint64_t    encodedbytes;           /**< the bytes of the delta rops which carried them */
+    uint32_t    keyframes;              /**< the delta rops which were key frames */
+    uint32_t    deltaframes;            /**< the delta rops which were computed against the previous ones */
+    uint32_t    notencoded;             /**< the times the regulars were sent as they are because the delta rop did not fit */
+} eOtransmitter_deltastatistics_t;
     
 // - declaration of extern public variables, ... but better using use _get/_set instead -------------------------------
 
 extern const eOtransmitter_cfg_t eo_transmitter_cfg_default; 
 
+// regulars, occasionals, replies. no budgets. carry-over of occasionals and replies
+extern const eOtransmitter_packing_t eo_transmitter_packing_default;
+
+// regulars decimation in [1, 4], cycled decimation up to 2, fill ratio between 50% and 90%, a decision every 100 packets
+extern const eOtransmitter_adaptive_cfg_t eo_transmitter_adaptive_cfg_default;
+
 
 // - declaration of extern public functions ---------------------------------------------------------------------------
  
@@ -150,8 +290,84 @@ extern eOresult_t eo_transmitter_outpacket_SetRemoteAddress(EOtransmitter *p, eO
 extern eOresult_t eo_transmitter_outpacket_Get(EOtransmitter *p, EOpacket **outpkt);
 
 
+/** @fn         extern eOresult_t eo_transmitter_outpacket_PrepareGather(EOtransmitter *p, uint16_t *numberofrops, eOtransmitter_ropsnumber_t *ropsnum)
+    @brief      prepares the out packet in scatter-gather mode. it works as eo_transmitter_outpacket_Prepare() but the
+                occasional and reply rops are not copied: their ropframes are detached and replaced by spare buffers,
+                so that the out packet points at them directly. the rops which must wait for next packet are copied 
+                into the spare buffer. the regulars are still copied in the out packet because they can be loaded or 
+                unloaded at any time.
+                in the same cycle use either this function or eo_transmitter_outpacket_Prepare(), not both.
+    @param      p               pointer to transceiver        
+    @param      numberofrops    contains number of rops in out packet
+    @param      ropsnum         if not NULL, it contains the number of rops of each kind
+    @return     eores_OK or eores_NOK_nullpointer
+ **/
+extern eOresult_t eo_transmitter_outpacket_PrepareGather(EOtransmitter *p, uint16_t *numberofrops, eOtransmitter_ropsnumber_t *ropsnum);
+
+
+/** @fn         extern eOresult_t eo_transmitter_outpacket_GetGather(EOtransmitter *p, eOtransmitter_gather_t *gather)
+    @brief      returns the out packet as a list of segments. it is well formed only if eo_transmitter_outpacket_PrepareGather() 
+                function is called before. the segments stay valid until the next call of eo_transmitter_outpacket_PrepareGather().  
+    @param      p         pointer to transceiver        
+    @param      gather    in output will contain the segments of the outpacket and its destination
+    @return     eores_OK or eores_NOK_nullpointer
+ **/
+extern eOresult_t eo_transmitter_outpacket_GetGather(EOtransmitter *p, eOtransmitter_gather_t *gather);
+
+
 extern eOresult_t eo_transmitter_TXdecimation_Set(EOtransmitter *p, uint8_t repliesTXdecimation, uint8_t regularsTXdecimation, uint8_t occasionalsTXdecimation);
 
+
+/** @fn         extern eOresult_t eo_transmitter_Packing_Set(EOtransmitter *p, const eOtransmitter_packing_t *packing)
+    @brief      sets the priorities and the budgets used by eo_transmitter_outpacket_Prepare() and 
+                eo_transmitter_outpacket_PrepareGather(). the default is eo_transmitter_packing_default.
+                it must be called by the thread which prepares the out packet.
+    @param      p           pointer to transmitter        
+    @param      packing     the packing. if NULL, then eo_transmitter_packing_default is used.
+    @return     eores_OK, eores_NOK_nullpointer, or eores_NOK_generic if priority does not contain every category once.
+ **/
+extern eOresult_t eo_transmitter_Packing_Set(EOtransmitter *p, const eOtransmitter_packing_t *packing);
+
+
+/** @fn         extern eOresult_t eo_transmitter_Packing_GetStatistics(EOtransmitter *p, eOtransmitter_packingstatistics_t *stats)
+    @brief      gets the bytes of each category deferred to next packet or dropped by the packing.
+    @param      p           pointer to transmitter        
+    @param      stats       in output it contains the statistics
+    @return     eores_OK or eores_NOK_nullpointer
+ **/
+extern eOresult_t eo_transmitter_Packing_GetStatistics(EOtransmitter *p, eOtransmitter_packingstatistics_t *stats);
+
+
+/** @fn         extern eOresult_t eo_transmitter_TXadaptive_Set(EOtransmitter *p, const eOtransmitter_adaptive_cfg_t *cfg)
+    @brief      enables or disables the adaptive TX decimation of the regulars. when it is enabled, it overrides the regulars 
+                decimation given by eo_transmitter_TXdecimation_Set(), which is kept aside. when it is disabled, the regulars 
+                decimation goes back to the one of eo_transmitter_TXdecimation_Set() and the cycled decimation goes back to 1. 
+                it must be called by the thread which prepares the out packet.
+    @param      p           pointer to transmitter        
+    @param      cfg         the bounds. if NULL, the adaptive TX decimation is disabled.
+    @return     eores_OK, eores_NOK_nullpointer, or eores_NOK_generic if the bounds are not coherent.
+ **/
+extern eOresult_t eo_transmitter_TXadaptive_Set(EOtransmitter *p, const eOtransmitter_adaptive_cfg_t *cfg);
+
+
+/** @fn         extern eOresult_t eo_transmitter_TXadaptive_ReportSequenceErrors(EOtransmitter *p, uint32_t errors)
+    @brief      tells the adaptive TX decimation how many sequence errors the remote receiver has detected in our packets
+                since the last report, for instance as it is told by its diagnostics. it can be called by any thread. 
+    @param      p           pointer to transmitter        
+    @param      errors      the number of new sequence errors
+    @return     eores_OK or eores_NOK_nullpointer
+ **/
+extern eOresult_t eo_transmitter_TXadaptive_ReportSequenceErrors(EOtransmitter *p, uint32_t errors);
+
+
+/** @fn         extern eOresult_t eo_transmitter_TXadaptive_Get(EOtransmitter *p, eOtransmitter_adaptive_state_t *state)
+    @brief      gets the last decision of the adaptive TX decimation, for instance to log it.
+    @param      p           pointer to transmitter        
+    @param      state       in output it contains the state
+    @return     eores_OK, eores_NOK_nullpointer, or eores_NOK_generic if the adaptive TX decimation is not enabled.
+ **/
+extern eOresult_t eo_transmitter_TXadaptive_Get(EOtransmitter *p, eOtransmitter_adaptive_state_t *state);
+
 // the rops in regular_rops stay forever unless unloaded one by one or all cleared. at each eo_transmitter_outpacket_Prepare() they are placed 
 // inside the packet. they however need an explicit refresh of their values. 
 extern eOsizecntnr_t eo_transmitter_regular_rops_Size(EOtransmitter *p);
@@ -164,6 +380,20 @@ extern eOresult_t eo_transmitter_regular_rops_entity_Unload(EOtransmitter *p, eO
 extern eOresult_t eo_transmitter_regular_rops_Clear(EOtransmitter *p); 
 extern eOresult_t eo_transmitter_regular_rops_Refresh(EOtransmitter *p);
 
+// eo_transmitter_refresh_dirtyonly enables dirty tracking inside the EOnvSet. see eo_nvset_NV_MarkDirty() for NVs 
+// which are written directly in ram. the time fields of the regular rops are always refreshed.
+extern eOresult_t eo_transmitter_regular_rops_RefreshMode_Set(EOtransmitter *p, eOtransmitter_refreshmode_t mode);
+// the bytes of data copied from the NVs by the last call of eo_transmitter_regular_rops_Refresh()
+extern uint32_t eo_transmitter_regular_rops_RefreshedBytes_Get(EOtransmitter *p);
+
+// a keyframeperiod different from 0 enables the delta encoding: the regulars of each packet are sent inside a single delta rop 
+// (see eOropdeltahead_t) computed against the regulars previously sent, with a key frame every keyframeperiod delta rops and
+// whenever the size of the regulars changes. the remote receiver must have enabled eo_receiver_Delta_Set() before, because
+// a receiver which does not manage the delta encoding refuses the delta rop and the rops which follow it in the packet. 
+// keyframeperiod = 0 disables it. it must be called by the thread which prepares the out packet.
+extern eOresult_t eo_transmitter_regular_rops_Delta_Set(EOtransmitter *p, uint16_t keyframeperiod);
+extern eOresult_t eo_transmitter_regular_rops_Delta_GetStatistics(EOtransmitter *p, eOtransmitter_deltastatistics_t *stats);
+
 // the rops in occasional_rops are inserted with following functions, put inside the packet with function eo_transmitter_outpacket_Get()
 // and after that they are cleared.
 
@@ -172,10 +402,53 @@ extern eOresult_t eo_transmitter_lasterror_Get(EOtransmitter *p, int32_t *err, i
 extern eOresult_t eo_transmitter_occasional_rops_Load(EOtransmitter *p, eOropdescriptor_t* ropdesc);
 extern eOresult_t eo_transmitter_occasional_rops_LoadStream(EOtransmitter *p, uint8_t *stream, uint16_t size);
 
+/** @fn         extern eOresult_t eo_transmitter_occasional_rops_Coalescing_Set(EOtransmitter *p, eObool_t enable)
+    @brief      enables the coalescing of the occasional rops. when a set<> or an ask<> rop is loaded while another one with 
+                the same ropcode and id32 is still waiting for transmission, the new rop is written over the waiting one, 
+                so that only the last value is transmitted. the waiting rop keeps its position, thus the order of rops 
+                with different id32 is preserved. rops which request a confirmation, or which differ in their control 
+                flags or size, are never coalesced. the rops loaded with eo_transmitter_occasional_rops_LoadStream() are
+                coalesced one by one, as if they were loaded singularly.
+    @param      p           pointer to transmitter        
+    @param      enable      eobool_true to enable, eobool_false to disable.
+    @return     eores_OK or eores_NOK_nullpointer
+ **/
+extern eOresult_t eo_transmitter_occasional_rops_Coalescing_Set(EOtransmitter *p, eObool_t enable);
+
+// the number of occasional rops which were written over a waiting one since the creation of the transmitter
+extern uint32_t eo_transmitter_occasional_rops_Coalesced_Get(EOtransmitter *p);
+
 extern eOresult_t eo_transmitter_reply_rops_Load(EOtransmitter *p, eOropdescriptor_t* ropdesc);
 extern eOresult_t eo_transmitter_reply_ropframe_Load(EOtransmitter *p, EOropframe* ropframe);
 
 
+/** @fn         extern eOresult_t eo_transmitter_Staging_Set(EOtransmitter *p, uint8_t numberofproducers, uint16_t capacityofqueue)
+    @brief      enables the staging mode of the occasional and reply rops. in this mode each thread which calls 
+                eo_transmitter_occasional_rops_Load() or eo_transmitter_reply_rops_Load() gets its own pair of lock-free 
+                single-producer / single-consumer queues, one for occasionals and one for replies. the thread forms the rop 
+                and puts its stream inside the queue without taking any mutex of the transmitter. the queues are drained into 
+                the ropframes of occasionals and replies by eo_transmitter_NumberofOutROPs(), eo_transmitter_outpacket_Prepare()
+                and eo_transmitter_outpacket_PrepareGather(), thus the numbers they return already count the staged rops.
+                a staged rop which does not fit inside its ropframe stays in the queue until the next transmission.
+                when @e numberofproducers threads already own a pair of queues, the other threads keep on using the 
+                mutexes: see eo_transmitter_Staging_Fallbacks_Get(). on linux a thread gives its queues back when it
+                exits, elsewhere a pair of queues stays with its first thread for the whole life of the transmitter.
+                the function must be called only once, before any occasional or reply rop is loaded. 
+                the mode requires c11 atomics and thread-local storage. eo_transmitter_occasional_rops_LoadStream() and 
+                eo_transmitter_reply_ropframe_Load() are not affected.
+    @param      p                   pointer to transmitter        
+    @param      numberofproducers   the max number of threads which get their own queues. it must not be zero.
+    @param      capacityofqueue     the capacity in bytes of each queue. it is rounded up to a power of two able to 
+                                    contain at least two rops of max size.
+    @return     eores_OK, eores_NOK_nullpointer, eores_NOK_generic if the mode is already enabled or numberofproducers is
+                zero, eores_NOK_unsupported if the compiler does not offer c11 atomics.
+ **/
+extern eOresult_t eo_transmitter_Staging_Set(EOtransmitter *p, uint8_t numberofproducers, uint16_t capacityofqueue);
+
+// the number of occasional or reply rops which went through the mutexes because no pair of queues was free. 
+extern uint32_t eo_transmitter_Staging_Fallbacks_Get(EOtransmitter *p);
+
+
 
 
 
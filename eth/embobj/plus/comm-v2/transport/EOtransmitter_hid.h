@@ -54,6 +54,12 @@ extern "C" {
 
 #define USE_DEBUG_EOTRANSMITTER 
 
+// the fields which are shared amongst threads without any mutex need c11 atomics
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_ATOMICS__)
+    #define EOTRANSMITTER_ATOMICS
+    #include <stdatomic.h>
+#endif
+
 // - definition of the hidden struct implementing the object ----------------------------------------------------------
 
 typedef enum
@@ -76,12 +82,91 @@ typedef struct      // 40 bytes on arm .... but not 40 on a 64-bit architecture
 } eo_transm_regrop_info_t;   //EO_VERIFYsizeof(eo_transm_regrop_info_t, (8+28+4))
 
 
+typedef struct
+{
+    eOnvID32_t      id32;
+    EOlistIter*     iter;                   // the iterator of listofregropinfo which holds id32. NULL marks an empty slot
+} eo_transm_regrop_slot_t;
+
+
+typedef struct      // open addressing index (linear probing) of listofregropinfo keyed by id32
+{
+    eo_transm_regrop_slot_t*    slots;
+    uint32_t                    capacity;   // a power of two which is at least twice the capacity of listofregropinfo
+    uint8_t                     shift;      // = 32 - log2(capacity). it is used by the multiplicative hash
+} eo_transm_regrop_index_t;
+
+
+typedef struct
+{
+    eOnvID32_t      id32;
+    uint16_t        offset;         // where the rop starts inside the rops of ropframeoccasionals
+    uint8_t         ropcode;
+    uint8_t         generation;     // the slot is empty if it is not the generation of the index
+} eo_transm_occrop_slot_t;
+
+
+typedef struct      // open addressing index (linear probing) of the set<> and ask<> rops inside ropframeoccasionals keyed by (ropcode, id32)
+{
+    eo_transm_occrop_slot_t*    slots;      // NULL if the coalescing of occasionals is disabled
+    uint32_t                    capacity;   // a power of two which is at least twice the max number of rops inside ropframeoccasionals
+    uint8_t                     shift;      // = 32 - log2(capacity). it is used by the multiplicative hash
+    uint8_t                     generation; // it is incremented to empty all the slots at once. it is never 0
+    uint32_t                    coalesced;  // the number of rops written over a pending one
+} eo_transm_occrop_index_t;
+
+
+enum { eo_transm_delta_slots = 3 };    // the standard regulars alone, with the cycle0of ones, with the cycle1of ones
+
+
+typedef struct
+{
+    uint8_t*    rops;           // the regulars carried by the last delta rop of the slot, as the receiver has them after decoding
+    uint16_t    size;           // 0 if the receiver may not have them, so that the next delta rop must be a key frame
+    uint16_t    sincekeyframe;  // the delta rops sent after the last key frame
+    uint8_t     progressive;
+} eo_transm_delta_reference_t;
+
+
+typedef struct
+{
+    uint16_t                        keyframeperiod; // 0 if the delta encoding is disabled
+    uint16_t                        capacity;       // the capacity of each of the following buffers
+    uint8_t*                        stream;         // where the delta rop is formed
+    eo_transm_delta_reference_t     references[eo_transm_delta_slots];
+    eOtransmitter_deltastatistics_t statistics;
+} eo_transm_delta_t;
+
+
 typedef struct
 {
     uint32_t    txropframeistoobigforthepacket;
 } EOtransmitterDEBUG_t;
 
 
+typedef struct
+{
+    eObool_t                        enabled;
+    uint8_t                         staticregularsdecimation;   // the one of eo_transmitter_TXdecimation_Set(), restored when disabled
+    eOtransmitter_adaptive_cfg_t    cfg;
+    eOtransmitter_adaptive_state_t  state;
+    uint16_t                        packets;            // the packets of the current window
+    uint32_t                        usedbytes;          // the bytes of rops inside the packets of the current window
+    uint32_t                        capacitybytes;      // the bytes of rops which the packets of the current window could hold
+    uint64_t                        overflowbytes;      // the deferred and dropped bytes of packingstatistics at the start of the window
+#if defined(EOTRANSMITTER_ATOMICS)
+    atomic_uint_least32_t           sequenceerrors;     // cumulative. written by eo_transmitter_TXadaptive_ReportSequenceErrors() from any thread
+#else
+    volatile uint32_t               sequenceerrors;     // cumulative. written by eo_transmitter_TXadaptive_ReportSequenceErrors() under mtx_regulars
+#endif
+    uint32_t                        sequenceerrorsseen; // the value of sequenceerrors at the start of the window
+} eo_transm_adaptive_t;
+
+
+// it is defined inside EOtransmitter.c because it needs c11 atomics. see eo_transmitter_Staging_Set()
+typedef struct eo_transm_staging_t eo_transm_staging_t;
+
+
 /** @struct     EOtransmitter_hid
     @brief      Hidden definition. Implements private data used only internally by the 
                 public or private (static) functions of the object and protected data
@@ -108,7 +193,11 @@ struct EOtransmitter_hid
     uint8_t*                    bufferropframeregulars_cycle1of;
     uint8_t*                    bufferropframeoccasionals;
     uint8_t*                    bufferropframereplies;
+    uint8_t*                    spareropframeoccasionals;   // used only in scatter-gather mode: it holds the occasionals of the last gather
+    uint8_t*                    spareropframereplies;       // used only in scatter-gather mode: it holds the replies of the last gather
+    eOtransmitter_gather_t      gather;
     EOlist*                     listofregropinfo; 
+    eo_transm_regrop_index_t    regropindex;
     eOabstime_t                 currenttime;   
     EOVmutexDerived*            mtx_replies;
     EOVmutexDerived*            mtx_regulars;
@@ -132,6 +221,19 @@ struct EOtransmitter_hid
     uint16_t                    maxsizeofregulars;
     uint16_t                    effectivecapacityofregulars;
     uint64_t                    txregularsprogressive;
+    eOtransmitter_refreshmode_t refreshmode;
+    uint32_t                    refreshedbytes;
+#if defined(EOTRANSMITTER_ATOMICS)
+    _Atomic(eo_transm_staging_t*) staging;      // NULL unless the staging mode of occasionals and replies is enabled. read by the producers without mutex
+#else
+    eo_transm_staging_t*        staging;        // NULL unless the staging mode of occasionals and replies is enabled
+#endif
+    eOtransmitter_packing_t     packing;
+    eOtransmitter_packingstatistics_t packingstatistics;
+    uint8_t                     txdecimationcycled;     // the cycled regulars are added once every txdecimationcycled times the regulars are
+    eo_transm_adaptive_t        adaptive;
+    eo_transm_occrop_index_t    occropindex;
+    eo_transm_delta_t           delta;
 }; 
 
 
@@ -75,7 +75,7 @@ static eOresult_t s_eodeb_eoProtoParser_CheckNV(eODeb_eoProtoParser *p, eOethLow
 static uint8_t s_eodeb_eoProtoParser_NVisrequired(eODeb_eoProtoParser *p, eOprotID32_t id32);
 static uint8_t s_eodeb_eoProtoParser_CheckSeqnum(eODeb_eoProtoParser *p, eOethLowLevParser_packetInfo_t *pktInfo_ptr, 
                                                 uint32_t *rec_seqnum, uint32_t *expeted_seqnum);
-static uint8_t s_eodeb_eoProtoParser_isvalidropframe(uint8_t *payload, uint32_t size);
+static uint8_t s_eodeb_eoProtoParser_isvalidropframe(eODeb_eoProtoParser *p, uint8_t *payload, uint32_t size);
 //static eOresult_t s_eodeb_eoProtoParser_DumpNV(eODeb_eoProtoParser *p, eOethLowLevParser_packetInfo_t *pktInfo_ptr);
 
 
@@ -124,8 +124,8 @@ extern eOresult_t eODeb_eoProtoParser_RopFrameDissect(eODeb_eoProtoParser *p, eO
         return(eores_NOK_nullpointer);
     }
 
-    //1) verify if i received a valid ropframe
-    if(!(s_eodeb_eoProtoParser_isvalidropframe(pktInfo_ptr->payload_ptr, pktInfo_ptr->size)))
+    //1) verify if i received a valid ropframe. it also finds where its rops are
+    if(!(s_eodeb_eoProtoParser_isvalidropframe(p, pktInfo_ptr->payload_ptr, pktInfo_ptr->size)))
     {
         if(p->cfg.checks.invalidRopFrame.cbk != NULL)
         {
@@ -167,18 +167,22 @@ extern eOresult_t eODeb_eoProtoParser_RopFrameDissect(eODeb_eoProtoParser *p, eO
 // --------------------------------------------------------------------------------------------------------------------
 // - definition of static functions 
 // --------------------------------------------------------------------------------------------------------------------
-static uint8_t s_eodeb_eoProtoParser_isvalidropframe(uint8_t *payload, uint32_t size)
+static uint8_t s_eodeb_eoProtoParser_isvalidropframe(eODeb_eoProtoParser *p, uint8_t *payload, uint32_t size)
 {
-    EOropframeHeader_t *ropframeHdr = (EOropframeHeader_t *)payload;
-    uint32_t footer =*((uint32_t*)(&payload[size-4]));
-    if((ropframeHdr->startofframe == 0x12345678) && (footer == 0x87654321))
+    p->numberofrops = 0;
+    
+    if((size > 0xffff) || (eores_OK != eo_ropframe_Scan(payload, (uint16_t)size, p->ropoffsets, EODEB_EOPROTOPARSER_MAXROPS, &p->numberofrops)))
     {
-        return(1);
+        return(0);
     }
-    else
-    {
+    
+    if(p->numberofrops > EODEB_EOPROTOPARSER_MAXROPS)
+    {   // it cannot be inside an ethernet frame
+        p->numberofrops = 0;
         return(0);
     }
+    
+    return(1);
 }
 
 
@@ -194,18 +198,18 @@ static eOresult_t s_eodeb_eoProtoParser_CheckNV(eODeb_eoProtoParser *p, eOethLow
 	//get ropframe header
 	ropframeheader = (EOropframeHeader_t *)pktInfo_ptr->payload_ptr;
 
-    //get rop to first rop
-	rop_ptr = &pktInfo_ptr->payload_ptr[ROPFRAME_HEADER_SIZE];
-	ropheader = (eOrophead_t*)rop_ptr;
-
-	for(i=0; i<ropframeheader->ropsnumberof; i++)
+	//the rops were found by s_eodeb_eoProtoParser_isvalidropframe()
+	for(i=0; i<p->numberofrops; i++)
 	{
 		//uint8_t *enddata_ptr;
 		eODeb_eoProtoParser_ropAdditionalInfo_t ropAddInfo = {0};
-		int32_t filldata = 0, totdatasize = 0, signaturesize = 0, timesize = 0;
+		int32_t filldata = 0, totdatasize = 0, signaturesize = 0;
                 uint32_t signature = EOK_uint32dummy;
                 uint64_t time = EOK_uint64dummy;
 
+		rop_ptr = &pktInfo_ptr->payload_ptr[ROPFRAME_HEADER_SIZE + p->ropoffsets[i]];
+		ropheader = (eOrophead_t*)rop_ptr;
+
 		//calulate fill data size
 		filldata = ropheader->dsiz%4;
 		if(filldata!=0)
@@ -236,7 +240,6 @@ static eOresult_t s_eodeb_eoProtoParser_CheckNV(eODeb_eoProtoParser *p, eOethLow
 			//uint8_t *data_ptr = &rop_ptr[totdatasize + signaturesize];
                         uint8_t *data_ptr = &rop_ptr[ropheader_size + totdatasize + signaturesize];
 			memcpy((uint8_t*)&time, data_ptr, sizeof(uint64_t));
-			timesize = 8;
 		}
 
 		if(s_eodeb_eoProtoParser_NVisrequired(p, ropheader->id32))
@@ -256,11 +259,6 @@ static eOresult_t s_eodeb_eoProtoParser_CheckNV(eODeb_eoProtoParser *p, eOethLow
 			p->cfg.checks.nv.cbk_onNVfound(pktInfo_ptr, &ropAddInfo);
 		}
 
-
-		//go to next rop
-		rop_ptr = &rop_ptr[ROP_HEADER_SIZE + totdatasize + signaturesize + timesize];
-		ropheader = (eOrophead_t*)rop_ptr;
-
 	} //end for
 
     return(eores_OK);
@@ -41,7 +41,9 @@ extern "C" {
 
 
 // - #define used with hidden struct ----------------------------------------------------------------------------------
-// empty-section
+
+// the max number of rops of a ropframe inside an ethernet frame: each one has at least its head of 8 bytes
+#define EODEB_EOPROTOPARSER_MAXROPS     ((1500 - 28) / 8)
 
 
 // - definition of the hidden struct implementing the object ----------------------------------------------------------
@@ -54,6 +56,8 @@ struct eODeb_eoProtoParser_hid
 {
     eODeb_eoProtoParser_cfg_t     cfg;
     uint8_t                       initted;
+    uint16_t                      numberofrops;                             // of the last valid ropframe
+    uint16_t                      ropoffsets[EODEB_EOPROTOPARSER_MAXROPS];  // of its rops, from the first one
 };
 // - declaration of extern hidden functions ---------------------------------------------------------------------------
 
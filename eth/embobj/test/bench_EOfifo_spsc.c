@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+// throughput benchmark of the EOfifo with one producer thread and one consumer thread: eo_fifo_access_mutex with the
+// recursive user mutex of the host against eo_fifo_access_spsc. the producer puts a progressive number in every item
+// and it retries when the fifo is full, the consumer removes the items with eo_fifo_GetRem() and it fails if any
+// number is lost, repeated or out of order. it reports the items per second.
+// usage: bench_EOfifo_spsc [milliseconds of every measure]
+
+#include "EoCommon.h"
+#include "EOfifo.h"
+#include "EOYmutex.h"
+
+#include "test_host.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+
+#define CAPACITY        255
+#define MAXITEMSIZE     64
+
+typedef struct
+{
+    EOfifo          *fifo;
+    volatile int    stop;
+    volatile int    done;           // the producer has put its last item
+    uint32_t        produced;
+    uint32_t        consumed;
+    uint32_t        wrong;
+} bench_fifo_t;
+
+static void* s_producer(void *arg)
+{
+    bench_fifo_t *b = (bench_fifo_t*) arg;
+    uint8_t item[MAXITEMSIZE];
+
+    memset(item, 0, sizeof(item));
+    while(0 == b->stop)
+    {
+        memcpy(item, &b->produced, sizeof(b->produced));
+        if(eores_OK == eo_fifo_Put(b->fifo, item, eok_reltimeINFINITE))
+        {
+            b->produced++;
+        }
+        else
+        {   // full
+            sched_yield();
+        }
+    }
+    return(NULL);
+}
+
+static void* s_consumer(void *arg)
+{
+    bench_fifo_t *b = (bench_fifo_t*) arg;
+    uint8_t item[MAXITEMSIZE];
+    uint32_t number = 0;
+
+    for(;;)
+    {
+        if(eores_OK == eo_fifo_GetRem(b->fifo, item, eok_reltimeINFINITE))
+        {
+            memcpy(&number, item, sizeof(number));
+            if(number != b->consumed)
+            {
+                b->wrong++;
+            }
+            b->consumed++;
+        }
+        else if(0 != b->done)
+        {   // empty and the producer has put its last item
+            break;
+        }
+        else
+        {
+            sched_yield();
+        }
+    }
+    return(NULL);
+}
+
+static double s_run(eOfifo_access_t access, uint16_t itemsize, uint32_t ms, uint32_t *wrong)
+{   // it returns the items per second
+    bench_fifo_t b;
+    pthread_t producer;
+    pthread_t consumer;
+    EOVmutexDerived *mutex = (eo_fifo_access_mutex == access) ? (eoy_mutex_New()) : (NULL);
+
+    memset(&b, 0, sizeof(b));
+    b.fifo = eo_fifo_NewWithAccess(itemsize, CAPACITY, NULL, 0, NULL, NULL, mutex, access);
+
+    pthread_create(&consumer, NULL, s_consumer, &b);
+    pthread_create(&producer, NULL, s_producer, &b);
+    usleep(1000*ms);
+    b.stop = 1;
+    pthread_join(producer, NULL);
+    b.done = 1;
+    pthread_join(consumer, NULL);
+
+    eo_fifo_Delete(b.fifo);
+    if(NULL != mutex)
+    {
+        eoy_mutex_Delete(mutex);
+    }
+
+    *wrong = b.wrong + (b.produced - b.consumed);
+    return(1000.0*b.consumed/ms);
+}
+
+int main(int argc, char *argv[])
+{
+    static const eOfifo_access_t accesses[2] = { eo_fifo_access_mutex, eo_fifo_access_spsc };
+    static const char *names[2] = { "mutex", "spsc" };
+    static const uint16_t itemsizes[2] = { 4, MAXITEMSIZE };
+    uint32_t ms = test_host_Duration(argc, argv, 100);
+    int errors = 0;
+    uint8_t s = 0;
+    uint8_t a = 0;
+
+    test_host_Initialise(eoy_mutex_backend_user);
+
+    printf("%-6s %9s %14s\n", "mode", "itemsize", "items/s");
+    for(s=0; s<2; s++)
+    {
+        for(a=0; a<2; a++)
+        {
+            uint32_t wrong = 0;
+            double rate = s_run(accesses[a], itemsizes[s], ms, &wrong);
+            if(0 != wrong)
+            {
+                printf("FAIL: %u items lost or out of order with %s\n", wrong, names[a]);
+                errors++;
+            }
+            printf("%-6s %9u %14.0f\n", names[a], itemsizes[s], rate);
+        }
+    }
+
+    printf("%s\n", (0 == errors) ? "OK" : "FAIL");
+    return((0 == errors) ? 0 : 1);
+}
@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+// contention benchmark of the protection of the NVs: one writer thread sets a joint status, as the RX thread does,
+// while N reader threads get it, as the device threads do. it compares eo_nvset_protection_one_per_netvar with the
+// recursive user mutex of the host against eo_nvset_protection_seqlock_per_netvar. the writer either writes without
+// pause or once per millisecond as the RX thread of a board at 1 kHz. it reports the reads and writes per second and
+// the longest write, and it fails if a reader sees a torn value. usage: bench_EOnv_seqlock [milliseconds of every measure]
+
+#include "EoCommon.h"
+#include "EOhostTransceiver.h"
+#include "EOYmutex.h"
+#include "EOnvSet.h"
+#include "EOnv_hid.h"
+#include "EoProtocol.h"
+#include "EoProtocolMC.h"
+
+#include "test_host.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+
+#define MAXREADERS      8
+
+typedef struct
+{
+    EOnv            nv;
+    volatile int    stop;
+    int             paced;
+    long            count;
+    long            torn;
+    uint64_t        maxnanosec;
+} bench_thread_t;
+
+static void* s_writer(void *arg)
+{
+    bench_thread_t *t = (bench_thread_t*) arg;
+    uint8_t value[256];
+    uint8_t v = 0;
+    uint64_t t0 = 0;
+    uint64_t t1 = 0;
+
+    while(0 == t->stop)
+    {
+        memset(value, v++, sizeof(value));
+        t0 = test_host_Nanotime();
+        eo_nv_Set(&t->nv, value, eobool_true, eo_nv_upd_dontdo);
+        t1 = test_host_Nanotime();
+        if((t1 - t0) > t->maxnanosec)
+        {
+            t->maxnanosec = t1 - t0;
+        }
+        t->count++;
+        if(0 != t->paced)
+        {
+            usleep(1000);
+        }
+    }
+    return(NULL);
+}
+
+static void* s_reader(void *arg)
+{
+    bench_thread_t *t = (bench_thread_t*) arg;
+    uint8_t buffer[256];
+    uint16_t size = 0;
+    uint16_t i = 0;
+
+    while(0 == t->stop)
+    {
+        eo_nv_Get(&t->nv, eo_nv_strg_volatile, buffer, &size);
+        for(i=1; i<size; i++)
+        {
+            if(buffer[i] != buffer[0])
+            {
+                t->torn++;
+                break;
+            }
+        }
+        t->count++;
+    }
+    return(NULL);
+}
+
+static long s_run(const EOnv *nv, uint8_t numberofreaders, int paced, uint32_t ms, long *writes, uint64_t *maxwrite)
+{   // it returns the total number of reads, or -1 if any read was torn
+    pthread_t threads[MAXREADERS+1];
+    bench_thread_t state[MAXREADERS+1];
+    long reads = 0;
+    long torn = 0;
+    uint8_t i = 0;
+
+    memset(state, 0, sizeof(state));
+    for(i=0; i<=numberofreaders; i++)
+    {
+        state[i].nv = *nv;
+        state[i].paced = paced;
+        pthread_create(&threads[i], NULL, (0 == i) ? (s_writer) : (s_reader), &state[i]);
+    }
+    usleep(1000*ms);
+    for(i=0; i<=numberofreaders; i++)
+    {
+        state[i].stop = 1;
+    }
+    for(i=0; i<=numberofreaders; i++)
+    {
+        pthread_join(threads[i], NULL);
+        if(0 != i)
+        {
+            reads += state[i].count;
+            torn += state[i].torn;
+        }
+    }
+    *writes = state[0].count;
+    *maxwrite = state[0].maxnanosec;
+    return((0 == torn) ? (reads) : (-1));
+}
+
+int main(int argc, char *argv[])
+{
+    static const eOnvset_protection_t protections[2] = { eo_nvset_protection_one_per_netvar, eo_nvset_protection_seqlock_per_netvar };
+    static const char *names[2] = { "mutex", "seqlock" };
+    uint32_t ms = test_host_Duration(argc, argv, 50);
+    eOnvID32_t id32 = eoprot_ID_get(eoprot_endpoint_motioncontrol, eoprot_entity_mc_joint, 0, eoprot_tag_mc_joint_status);
+    eOnvset_BRDcfg_t brdcfg[2];
+    EOhostTransceiver *hosttxrx[2];
+    EOnv nv[2];
+    int errors = 0;
+    uint8_t n = 0;
+    uint8_t p = 0;
+    int paced = 0;
+
+    test_host_Initialise(eoy_mutex_backend_user);
+
+    // one board per protection, so that the two NVs do not share their ram
+    for(p=0; p<2; p++)
+    {
+        eOhosttransceiver_cfg_t cfg = eo_hosttransceiver_cfg_default;
+        brdcfg[p] = eonvset_BRDcfgMax;
+        brdcfg[p].boardnum = eonvset_BRDcfgMax.boardnum - p;
+        cfg.nvsetbrdcfg = &brdcfg[p];
+        cfg.nvsetprotection = protections[p];
+        cfg.mutex_fn_new = (eov_mutex_fn_mutexderived_new) eoy_mutex_New;
+        hosttxrx[p] = eo_hosttransceiver_New(&cfg);
+        eo_nvset_NV_Get(eo_hosttransceiver_GetNVset(hosttxrx[p]), id32, &nv[p]);
+    }
+
+    printf("%-8s %-7s %8s %14s %14s %14s\n", "mode", "writer", "readers", "reads/s", "writes/s", "maxwrite[ns]");
+    for(paced=0; paced<2; paced++)
+    {
+        for(n=1; n<=MAXREADERS; n*=2)
+        {
+            for(p=0; p<2; p++)
+            {
+                long writes = 0;
+                uint64_t maxwrite = 0;
+                long reads = s_run(&nv[p], n, paced, ms, &writes, &maxwrite);
+                if(reads < 0)
+                {
+                    printf("FAIL: torn reads with %s and %u readers\n", names[p], n);
+                    errors++;
+                    continue;
+                }
+                printf("%-8s %-7s %8u %14.0f %14.0f %14llu\n", names[p], (0 == paced) ? "busy" : "1kHz", n, 
+                       1000.0*reads/ms, 1000.0*writes/ms, (unsigned long long)maxwrite);
+            }
+        }
+    }
+
+    for(p=0; p<2; p++)
+    {
+        eo_hosttransceiver_Delete(hosttxrx[p]);
+    }
+
+    printf("%s\n", (0 == errors) ? "OK" : "FAIL");
+    return((0 == errors) ? 0 : 1);
+}
@@ -0,0 +1,298 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+// bandwidth and cpu benchmark of the delta encoding of the regulars on the traffic of a board with skin and joints:
+// two EOarray_of_skincandata_t and four eOmc_joint_status_t are sent as regulars, once per cycle, first raw and then
+// with the delta encoding. it reports the bytes per packet and the microseconds of the transmitter and of the
+// receiver, and it fails if the NVs of the receiver differ from the ones of the transmitter.
+// usage: bench_EOtransmitter_delta [cycles] [capture]
+// a capture is a binary file of records, one per cycle, each one with the two EOarray_of_skincandata_t and then the
+// four eOmc_joint_status_t as they were in the ram of the board. the records are used in loop. without a capture the
+// records are generated: the joints move back and forth with noisy measures, and every skin array carries
+// the can frames of the triangles which were sampled in the cycle, with noisy taxels.
+
+#include "EoCommon.h"
+#include "EOhostTransceiver.h"
+#include "EOtransceiver.h"
+#include "EOtransmitter.h"
+#include "EOreceiver.h"
+#include "EOnv_hid.h"
+#include "EOnvSet.h"
+#include "EOpacket.h"
+#include "EOropframe.h"
+#include "EoProtocol.h"
+#include "EoProtocolMC.h"
+#include "EoProtocolSK.h"
+
+#include "test_host.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#define NUMBEROFSKINS       2
+#define NUMBEROFJOINTS      4
+#define NUMBEROFREGULARS    (NUMBEROFSKINS+NUMBEROFJOINTS)
+#define RECORDSIZE          (NUMBEROFSKINS*sizeof(EOarray_of_skincandata_t) + NUMBEROFJOINTS*sizeof(eOmc_joint_status_t))
+#define CAPACITYOFPACKET    1408
+#define KEYFRAMEPERIOD      50
+#define TRIANGLESPERSKIN    112     // 7 boards of 16 triangles
+#define TRIANGLEPERIOD      20      // in cycles, each triangle sends two can frames
+
+typedef struct
+{
+    EOhostTransceiver   *host[2];
+    EOnv                nv[2][NUMBEROFREGULARS];
+    uint16_t            size[NUMBEROFREGULARS];
+    FILE                *capture;
+    uint32_t            records;
+} bench_t;
+
+static void s_generate(uint8_t *record, uint32_t cycle)
+{
+    EOarray_of_skincandata_t *skin = (EOarray_of_skincandata_t*) record;
+    eOmc_joint_status_t *joint = (eOmc_joint_status_t*) &record[NUMBEROFSKINS*sizeof(EOarray_of_skincandata_t)];
+    uint8_t s = 0;
+    uint8_t j = 0;
+    uint16_t t = 0;
+    uint8_t k = 0;
+
+    memset(record, 0, RECORDSIZE);
+
+    for(s=0; s<NUMBEROFSKINS; s++)
+    {   // the triangles are sampled in turn: those of this cycle put their two can frames in the array
+        skin[s].head.capacity = eosk_capacity_arrayof_skincandata;
+        skin[s].head.itemsize = sizeof(eOsk_candata_t);
+        for(t=(cycle % TRIANGLEPERIOD); t<TRIANGLESPERSKIN; t+=TRIANGLEPERIOD)
+        {
+            for(k=0; (k<2) && (skin[s].head.size < eosk_capacity_arrayof_skincandata); k++)
+            {
+                eOsk_candata_t *candata = (eOsk_candata_t*) &skin[s].data[skin[s].head.size*sizeof(eOsk_candata_t)];
+                uint8_t b = 0;
+                candata->info = EOSK_CANDATA_INFO(8, (0x400 | ((t/16) << 4) | (t%16)));
+                for(b=0; b<8; b++)
+                {   // a taxel at rest is close to 0xf0, a touched one lower
+                    candata->data[b] = (uint8_t)(0xf0 - (rand() % 4) - (((t % 30) == 0) ? (0x40) : (0)));
+                }
+                candata->data[0] = (uint8_t)((k << 6) | (t % 16));
+                skin[s].head.size++;
+            }
+        }
+    }
+
+    for(j=0; j<NUMBEROFJOINTS; j++)
+    {   // back and forth over 40 degrees in 2 s, in icubdegrees. the measures have some noise
+        int32_t phase = (int32_t)((cycle + 500*j) % 2000);
+        int32_t velocity = (phase < 1000) ? (7280) : (-7280);
+        int32_t target = (phase < 1000) ? (-3640 + 7280*phase/1000) : (3640 - 7280*(phase-1000)/1000);
+        joint[j].core.measures.meas_position = target + (rand() % 5) - 2;
+        joint[j].core.measures.meas_velocity = velocity + (rand() % 9) - 4;
+        joint[j].core.measures.meas_acceleration = (rand() % 33) - 16;
+        joint[j].core.measures.meas_torque = 120 + (rand() % 7) - 3;
+        joint[j].core.ofpid.legacy.positionreference = target;
+        joint[j].core.ofpid.legacy.error = target - joint[j].core.measures.meas_position;
+        joint[j].core.ofpid.legacy.output = 40*joint[j].core.ofpid.legacy.error + (rand() % 3);
+        joint[j].core.modes.controlmodestatus = eomc_controlmode_position;
+        joint[j].core.modes.interactionmodestatus = eOmc_interactionmode_stiff;
+        joint[j].core.modes.ismotiondone = eobool_false;
+        joint[j].target.trgt_position = 3640;
+        joint[j].target.trgt_velocity = 7280;
+        joint[j].addinfo.multienc[0] = 4*joint[j].core.measures.meas_position + (rand() % 3);
+    }
+}
+
+static eObool_t s_record(bench_t *b, uint8_t *record, uint32_t cycle)
+{
+    if(NULL == b->capture)
+    {
+        s_generate(record, cycle);
+        return(eobool_true);
+    }
+
+    if(0 == (cycle % b->records))
+    {
+        fseek(b->capture, 0, SEEK_SET);
+    }
+    return((1 == fread(record, RECORDSIZE, 1, b->capture)) ? (eobool_true) : (eobool_false));
+}
+
+static int s_run(bench_t *b, eObool_t delta, uint32_t cycles, double *bytes, double *txusec, double *rxusec)
+{   // it returns the number of cycles where the receiver does not have the NVs of the transmitter
+    EOtransceiver *txrx = eo_hosttransceiver_GetTransceiver(b->host[0]);
+    EOreceiver *receiver = eo_transceiver_GetReceiver(eo_hosttransceiver_GetTransceiver(b->host[1]));
+    static uint8_t record[RECORDSIZE];
+    uint64_t tx = 0;
+    uint64_t rx = 0;
+    uint64_t wire = 0;
+    uint64_t t0 = 0;
+    int mismatches = 0;
+    uint32_t c = 0;
+    uint8_t r = 0;
+
+    eo_transmitter_regular_rops_Delta_Set(eo_transceiver_GetTransmitter(txrx), (eobool_true == delta) ? (KEYFRAMEPERIOD) : (0));
+    eo_receiver_Delta_Set(receiver, (eobool_true == delta) ? (CAPACITYOFPACKET) : (0));
+    srand(7);
+
+    for(c=0; c<cycles; c++)
+    {
+        EOpacket *packet = NULL;
+        uint8_t *payload = NULL;
+        uint16_t size = 0;
+        uint16_t nrops = 0;
+        uint16_t offset = 0;
+
+        if(eobool_false == s_record(b, record, c))
+        {
+            printf("FAIL: cannot read the record %u of the capture\n", c);
+            return(-1);
+        }
+        for(r=0; r<NUMBEROFREGULARS; r++)
+        {
+            memcpy(eo_nv_RAM(&b->nv[0][r]), &record[offset], b->size[r]);
+            offset += b->size[r];
+        }
+
+        t0 = test_host_Nanotime();
+        eo_transceiver_outpacket_Prepare(txrx, &nrops, NULL);
+        eo_transceiver_outpacket_Get(txrx, &packet);
+        tx += test_host_Nanotime() - t0;
+
+        eo_packet_Payload_Get(packet, &payload, &size);
+        wire += size;
+
+        t0 = test_host_Nanotime();
+        eo_receiver_ProcessAppend(receiver, packet, &nrops, NULL, NULL, NULL, NULL);
+        rx += test_host_Nanotime() - t0;
+
+        for(r=0; r<NUMBEROFREGULARS; r++)
+        {
+            if(0 != memcmp(eo_nv_RAM(&b->nv[0][r]), eo_nv_RAM(&b->nv[1][r]), b->size[r]))
+            {
+                mismatches++;
+                break;
+            }
+        }
+    }
+
+    *bytes = (double)wire/cycles;
+    *txusec = tx/1000.0/cycles;
+    *rxusec = rx/1000.0/cycles;
+    return(mismatches);
+}
+
+int main(int argc, char *argv[])
+{
+    static const char *names[2] = { "raw", "delta" };
+    eOhosttransceiver_cfg_t cfg = eo_hosttransceiver_cfg_default;
+    eOnvset_BRDcfg_t brdcfg[2];
+    eOtransmitter_deltastatistics_t stats;
+    bench_t bench;
+    uint32_t cycles = (argc > 1) ? ((uint32_t)atoi(argv[1])) : (1000);
+    uint32_t id32s[NUMBEROFREGULARS];
+    int errors = 0;
+    uint8_t h = 0;
+    uint8_t r = 0;
+    uint8_t m = 0;
+
+    memset(&bench, 0, sizeof(bench));
+    test_host_Initialise(eoy_mutex_backend_native);
+
+    if(argc > 2)
+    {
+        long filesize = 0;
+        bench.capture = fopen(argv[2], "rb");
+        if(NULL != bench.capture)
+        {
+            fseek(bench.capture, 0, SEEK_END);
+            filesize = ftell(bench.capture);
+        }
+        bench.records = (uint32_t)(filesize / RECORDSIZE);
+        if(0 == bench.records)
+        {
+            printf("FAIL: %s does not have any record of %u bytes\n", argv[2], (unsigned)RECORDSIZE);
+            return(1);
+        }
+    }
+
+    for(r=0; r<NUMBEROFREGULARS; r++)
+    {
+        id32s[r] = (r < NUMBEROFSKINS) ? (eoprot_ID_get(eoprot_endpoint_skin, eoprot_entity_sk_skin, r, eoprot_tag_sk_skin_status_arrayofcandata)) :
+                                         (eoprot_ID_get(eoprot_endpoint_motioncontrol, eoprot_entity_mc_joint, r - NUMBEROFSKINS, eoprot_tag_mc_joint_status));
+    }
+
+    // the regulars of the two skins and of the four joints fit in the regulars of the packet
+    cfg.sizes.capacityoftxpacket = CAPACITYOFPACKET;
+    cfg.sizes.capacityofropframeregulars = 900;
+    cfg.sizes.maxnumberofregularrops = 16;
+    cfg.sizes.capacityofropframeoccasionals = cfg.sizes.capacityoftxpacket - cfg.sizes.capacityofropframeregulars -
+                                              cfg.sizes.capacityofropframereplies - eo_ropframe_sizeforZEROrops;
+    for(h=0; h<2; h++)
+    {   // another board number, otherwise the two hosts share the ram of the NVs
+        brdcfg[h] = eonvset_BRDcfgMax;
+        brdcfg[h].boardnum = eonvset_BRDcfgMax.boardnum - h;
+        cfg.nvsetbrdcfg = &brdcfg[h];
+        bench.host[h] = eo_hosttransceiver_New(&cfg);
+        for(r=0; r<NUMBEROFREGULARS; r++)
+        {
+            eo_nvset_NV_Get(eo_hosttransceiver_GetNVset(bench.host[h]), id32s[r], &bench.nv[h][r]);
+            bench.size[r] = eo_nv_Size(&bench.nv[h][r]);
+        }
+    }
+    for(r=0; r<NUMBEROFREGULARS; r++)
+    {
+        eOropdescriptor_t ropdes = eok_ropdesc_basic;
+        ropdes.ropcode = eo_ropcode_sig;
+        ropdes.id32 = id32s[r];
+        if(eores_OK != eo_transceiver_RegularROP_Load(eo_hosttransceiver_GetTransceiver(bench.host[0]), &ropdes))
+        {
+            printf("FAIL: the regular %u cannot be loaded\n", r);
+            return(1);
+        }
+    }
+
+    printf("trace: %s, %u cycles, key frame period %u\n", (NULL == bench.capture) ? ("generated") : (argv[2]), cycles, KEYFRAMEPERIOD);
+    printf("%-6s %12s %10s %10s\n", "mode", "bytes/pkt", "tx[us]", "rx[us]");
+    for(m=0; m<2; m++)
+    {
+        double bytes = 0;
+        double txusec = 0;
+        double rxusec = 0;
+        int mismatches = s_run(&bench, (eObool_t)m, cycles, &bytes, &txusec, &rxusec);
+        if(0 != mismatches)
+        {
+            printf("FAIL: with %s the NVs of the receiver differ in %d cycles\n", names[m], mismatches);
+            errors++;
+        }
+        if(1 == m)
+        {
+            eo_transmitter_regular_rops_Delta_GetStatistics(eo_transceiver_GetTransmitter(eo_hosttransceiver_GetTransceiver(bench.host[0])), &stats);
+        }
+        printf("%-6s %12.1f %10.2f %10.2f\n", names[m], bytes, txusec, rxusec);
+    }
+    printf("delta: %u key frames, %u delta rops, %u not encoded\n", stats.keyframes, stats.deltaframes, stats.notencoded);
+
+    for(h=0; h<2; h++)
+    {
+        eo_hosttransceiver_Delete(bench.host[h]);
+    }
+    if(NULL != bench.capture)
+    {
+        fclose(bench.capture);
+    }
+
+    printf("%s\n", (0 == errors) ? "OK" : "FAIL");
+    return((0 == errors) ? 0 : 1);
+}
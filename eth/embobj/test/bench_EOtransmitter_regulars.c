@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+// micro-benchmark of the load and unload of the regular rops of the EOtransmitter with 1..N regulars taken from the
+// valid ids of a full board. for every N it repeats: the load of the N regulars, their load again which finds them in
+// the id32 index and does nothing else, and their unload. it reports the time per operation of each of the three and,
+// as a reference, of the linear walk of listofregropinfo which load and unload did for every call before the index.
+// it fails if the number of regulars is wrong after a load or an unload.
+// usage: bench_EOtransmitter_regulars [milliseconds of every measure]
+
+#include "EoCommon.h"
+#include "EOhostTransceiver.h"
+#include "EOtransceiver.h"
+#include "EOtransmitter.h"
+#include "EOtransmitter_hid.h"
+#include "EOlist.h"
+#include "EoProtocol.h"
+#include "EOYmutex.h"
+
+#include "test_host.h"
+
+#include <stdio.h>
+#include <string.h>
+
+
+#define MAXREGULARS     1000
+
+static uint32_t s_id32s[MAXREGULARS];
+static uint16_t s_numberofid32s = 0;
+
+static void s_collect(eOnvBRD_t brd)
+{   // the valid ids of the board, in the order of endpoint, entity, index and tag
+    uint8_t ep = 0;
+    uint8_t en = 0;
+    uint8_t ix = 0;
+    uint8_t tg = 0;
+
+    for(ep=0; ep<eoprot_endpoints_numberof; ep++)
+    {
+        for(en=0; en<8; en++)
+        {
+            for(ix=0; ix<12; ix++)
+            {
+                for(tg=0; tg<64; tg++)
+                {
+                    uint32_t id32 = eoprot_ID_get(ep, en, ix, tg);
+                    if((s_numberofid32s < MAXREGULARS) && (eobool_true == eoprot_id_isvalid(brd, id32)))
+                    {
+                        s_id32s[s_numberofid32s++] = id32;
+                    }
+                }
+            }
+        }
+    }
+}
+
+static uint16_t s_load(EOtransmitter *tx, uint16_t n)
+{   // it returns the number of regulars loaded
+    eOropdescriptor_t ropdes = eok_ropdesc_basic;
+    uint16_t i = 0;
+
+    ropdes.ropcode = eo_ropcode_sig;
+    for(i=0; i<n; i++)
+    {
+        ropdes.id32 = s_id32s[i];
+        if(eores_OK != eo_transmitter_regular_rops_Load(tx, &ropdes))
+        {
+            break;
+        }
+    }
+    return(i);
+}
+
+static void s_unload(EOtransmitter *tx, uint16_t n)
+{
+    eOropdescriptor_t ropdes = eok_ropdesc_basic;
+    uint16_t i = 0;
+
+    ropdes.ropcode = eo_ropcode_sig;
+    for(i=0; i<n; i++)
+    {
+        ropdes.id32 = s_id32s[i];
+        eo_transmitter_regular_rops_Unload(tx, &ropdes);
+    }
+}
+
+static uint16_t s_scan(EOtransmitter *tx, uint16_t n)
+{   // the lookup of load and unload before the index: a walk of listofregropinfo. it returns the number of ids found
+    uint16_t found = 0;
+    uint16_t i = 0;
+
+    for(i=0; i<n; i++)
+    {
+        EOlistIter *li = eo_list_Begin(tx->listofregropinfo);
+        while(NULL != li)
+        {
+            eo_transm_regrop_info_t *info = (eo_transm_regrop_info_t*) eo_list_At(tx->listofregropinfo, li);
+            if(info->thenv.id32 == s_id32s[i])
+            {
+                found++;
+                break;
+            }
+            li = eo_list_Next(tx->listofregropinfo, li);
+        }
+    }
+    return(found);
+}
+
+int main(int argc, char *argv[])
+{
+    static const uint16_t sizes[] = { 1, 10, 50, 100, 200, 500, MAXREGULARS };
+    eOhosttransceiver_cfg_t cfg = eo_hosttransceiver_cfg_default;
+    EOhostTransceiver *host = NULL;
+    EOtransmitter *tx = NULL;
+    uint32_t ms = test_host_Duration(argc, argv, 100);
+    int errors = 0;
+    uint16_t previous = 0;
+    uint8_t s = 0;
+
+    test_host_Initialise(eoy_mutex_backend_user);
+
+    // all the regulars fit in the packet and the biggest NV of the board fits in a rop
+    cfg.nvsetbrdcfg = &eonvset_BRDcfgMax;
+    cfg.sizes.capacityofrop = 1024;
+    cfg.sizes.capacityoftxpacket = 64000;
+    cfg.sizes.capacityofropframeregulars = 60000;
+    cfg.sizes.maxnumberofregularrops = MAXREGULARS;
+    cfg.sizes.capacityofropframeoccasionals = cfg.sizes.capacityoftxpacket - cfg.sizes.capacityofropframeregulars -
+                                              cfg.sizes.capacityofropframereplies - eo_ropframe_sizeforZEROrops;
+    cfg.mutex_fn_new = (eov_mutex_fn_mutexderived_new) eoy_mutex_New;
+    host = eo_hosttransceiver_New(&cfg);
+    tx = eo_transceiver_GetTransmitter(eo_hosttransceiver_GetTransceiver(host));
+    s_collect(eo_hosttransceiver_GetBoardNumber(host));
+
+    printf("%9s %12s %12s %12s %12s\n", "regulars", "load us", "reload us", "unload us", "scan us");
+    for(s=0; s<sizeof(sizes)/sizeof(sizes[0]); s++)
+    {
+        uint16_t n = (sizes[s] < s_numberofid32s) ? (sizes[s]) : (s_numberofid32s);
+        uint64_t load = 0;
+        uint64_t reload = 0;
+        uint64_t unload = 0;
+        uint64_t scan = 0;
+        uint64_t rounds = 0;
+        uint64_t end = test_host_Nanotime() + 1000000ULL*ms;
+        uint64_t t0 = 0;
+
+        if(n <= previous)
+        {   // the board has fewer ids
+            break;
+        }
+        previous = n;
+
+        do
+        {
+            t0 = test_host_Nanotime();
+            n = s_load(tx, n);
+            load += test_host_Nanotime() - t0;
+            if(n != eo_transmitter_regular_rops_Size(tx))
+            {
+                errors++;
+            }
+
+            t0 = test_host_Nanotime();
+            s_load(tx, n);
+            reload += test_host_Nanotime() - t0;
+
+            t0 = test_host_Nanotime();
+            if(n != s_scan(tx, n))
+            {
+                errors++;
+            }
+            scan += test_host_Nanotime() - t0;
+
+            t0 = test_host_Nanotime();
+            s_unload(tx, n);
+            unload += test_host_Nanotime() - t0;
+            if(0 != eo_transmitter_regular_rops_Size(tx))
+            {
+                errors++;
+            }
+            rounds++;
+        } while((0 == errors) && (test_host_Nanotime() < end));
+
+        if(0 != errors)
+        {
+            printf("FAIL: wrong number of regulars with %u regulars\n", n);
+            break;
+        }
+        printf("%9u %12.3f %12.3f %12.3f %12.3f\n", n, load/(1000.0*rounds*n), reload/(1000.0*rounds*n),
+               unload/(1000.0*rounds*n), scan/(1000.0*rounds*n));
+    }
+
+    eo_hosttransceiver_Delete(host);
+
+    printf("%s\n", (0 == errors) ? "OK" : "FAIL");
+    return((0 == errors) ? 0 : 1);
+}
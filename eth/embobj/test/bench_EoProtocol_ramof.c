@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+// benchmark of eoprot_variable_ramof_get() over all the valid ids of a remote board with eoprot_arrayof_maxEPcfg. the
+// lookup is rewritten here, with its own copy of the data of the board, twice: before, with the loop which summed the
+// sizes of the previous entities at every lookup, and after, with the offsets of the entities precomputed as in
+// eoprot_config_endpoint_entities(). the two copies are compiled alike, so they measure only the change. it also
+// measures eoprot_variable_ramof_get() of the library. it fails if any of the three gives a different ram for an id.
+// it reports the lookups per second.
+// usage: bench_EoProtocol_ramof [milliseconds of every measure]
+
+#include "EoCommon.h"
+#include "EOhostTransceiver.h"
+#include "EOnvSet.h"
+#include "EoProtocol.h"
+#include "EoProtocolEPs.h"
+#include "EOYmutex.h"
+
+#include "test_host.h"
+
+#include <stdio.h>
+#include <string.h>
+
+
+#define MAXIDS      1000
+
+typedef struct
+{   // the fields of eOprot_board_data_t used by the lookup
+    const uint8_t*      numberofeachentity[eoprot_endpoints_numberof];
+    void*               ramofeachendpoint[eoprot_endpoints_numberof];
+    uint16_t            entityoffset[eoprot_endpoints_numberof][eoprot_entities_maxnumberofsupported];
+} bench_board_data_t;
+
+typedef enum
+{
+    bench_lookup_loop           = 0,
+    bench_lookup_precomputed    = 1,
+    bench_lookup_library        = 2
+} bench_lookup_t;
+
+static uint32_t s_id32s[MAXIDS];
+static uint16_t s_numberofid32s = 0;
+static bench_board_data_t s_board;
+static volatile uintptr_t s_sink = 0;
+
+static uint16_t s_brdentityindex2ramoffset(uint8_t epi, eOprotEntity_t entity, eOprotIndex_t index, bench_lookup_t lookup)
+{   // as s_eoprot_brdentityindex2ramoffset() before and after the precomputed offsets
+    uint16_t offset = 0;
+    uint8_t i = 0;
+
+    if(entity >= eoprot_ep_entities_numberof[epi])
+    {
+        return(EOK_uint16dummy);
+    }
+    if(NULL == s_board.numberofeachentity[epi])
+    {
+        return(EOK_uint16dummy);
+    }
+    if(index >= s_board.numberofeachentity[epi][entity])
+    {
+        return(EOK_uint16dummy);
+    }
+    if(bench_lookup_loop == lookup)
+    {
+        for(i=0; i<entity; i++)
+        {   // we sum the size of all the entities before the current one
+            offset += (s_board.numberofeachentity[epi][i] * eoprot_ep_entities_sizeof[epi][i]);
+        }
+    }
+    else
+    {
+        offset = s_board.entityoffset[epi][entity];
+    }
+    offset += (index*eoprot_ep_entities_sizeof[epi][entity]);
+    return(offset);
+}
+
+static void* s_variable_ramof_get(eOprotID32_t id, bench_lookup_t lookup)
+{   // as eoprot_variable_ramof_get()
+    eOprotEndpoint_t ep = eoprot_ID2endpoint(id);
+    eOprotEntity_t entity = eoprot_ID2entity(id);
+    eOprotTag_t tag = eoprot_ID2tag(id);
+    uint8_t *startofdata = NULL;
+    uint16_t offset = 0;
+    uint8_t epi = 0;
+
+    if(ep >= eoprot_endpoints_numberof)
+    {
+        return(NULL);
+    }
+    epi = eoprot_ep_ep2index(ep);
+    startofdata = (uint8_t*) s_board.ramofeachendpoint[epi];
+    if(NULL == startofdata)
+    {
+        return(NULL);
+    }
+    offset = s_brdentityindex2ramoffset(epi, entity, eoprot_ID2index(id), lookup);
+    if(EOK_uint16dummy == offset)
+    {
+        return(NULL);
+    }
+    // the offset of the tag as in s_eoprot_rom_entity_offset_of_tag()
+    offset += (uint16_t)((const uint8_t*)eoprot_ep_descriptors[epi][entity][tag]->resetval - (const uint8_t*)eoprot_ep_entities_defval[epi][entity]);
+    return(&startofdata[offset]);
+}
+
+static double s_run(eOprotBRD_t brd, bench_lookup_t lookup, uint32_t ms)
+{   // it returns the lookups per second
+    uint64_t lookups = 0;
+    uint64_t start = test_host_Nanotime();
+    uint64_t end = start + 1000000ULL*ms;
+    uint64_t now = start;
+    uintptr_t sum = 0;
+    uint16_t i = 0;
+
+    do
+    {
+        if(bench_lookup_library == lookup)
+        {
+            for(i=0; i<s_numberofid32s; i++)
+            {
+                sum += (uintptr_t) eoprot_variable_ramof_get(brd, s_id32s[i]);
+            }
+        }
+        else
+        {
+            for(i=0; i<s_numberofid32s; i++)
+            {
+                sum += (uintptr_t) s_variable_ramof_get(s_id32s[i], lookup);
+            }
+        }
+        lookups += s_numberofid32s;
+        now = test_host_Nanotime();
+    } while(now < end);
+
+    s_sink = sum;
+    return(1000000000.0*lookups/(now - start));
+}
+
+int main(int argc, char *argv[])
+{
+    eOhosttransceiver_cfg_t cfg = eo_hosttransceiver_cfg_default;
+    EOhostTransceiver *host = NULL;
+    eOprotBRD_t brd = 0;
+    uint32_t ms = test_host_Duration(argc, argv, 100);
+    static const char *names[3] = { "loop", "precomputed", "library" };
+    int errors = 0;
+    uint8_t ep = 0;
+    uint8_t en = 0;
+    uint8_t ix = 0;
+    uint8_t tg = 0;
+    uint16_t i = 0;
+    uint16_t offset = 0;
+    uint8_t l = 0;
+
+    test_host_Initialise(eoy_mutex_backend_user);
+
+    // the host configures the protocol of the remote board with eoprot_arrayof_maxEPcfg
+    cfg.nvsetbrdcfg = &eonvset_BRDcfgMax;
+    host = eo_hosttransceiver_New(&cfg);
+    brd = eo_hosttransceiver_GetBoardNumber(host);
+
+    memset(&s_board, 0, sizeof(s_board));
+    for(ep=0; ep<eoprot_endpoints_numberof; ep++)
+    {
+        uint8_t epi = eoprot_ep_ep2index(ep);
+        s_board.numberofeachentity[epi] = eoprot_arrayof_maxEPcfg[ep].numberofentities;
+        s_board.ramofeachendpoint[epi] = eoprot_endpoint_ramof_get(brd, ep);
+        offset = 0;
+        for(en=0; en<eoprot_ep_entities_numberof[epi]; en++)
+        {
+            s_board.entityoffset[epi][en] = offset;
+            offset += (s_board.numberofeachentity[epi][en] * eoprot_ep_entities_sizeof[epi][en]);
+            for(ix=0; ix<eoprot_entity_numberof_get(brd, ep, en); ix++)
+            {
+                for(tg=0; tg<eoprot_ep_tags_numberof[epi][en]; tg++)
+                {
+                    uint32_t id32 = eoprot_ID_get(ep, en, ix, tg);
+                    if((s_numberofid32s < MAXIDS) && (eobool_true == eoprot_id_isvalid(brd, id32)))
+                    {
+                        s_id32s[s_numberofid32s++] = id32;
+                    }
+                }
+            }
+        }
+    }
+
+    for(i=0; i<s_numberofid32s; i++)
+    {
+        void *ram = eoprot_variable_ramof_get(brd, s_id32s[i]);
+        if((NULL == ram) || (ram != s_variable_ramof_get(s_id32s[i], bench_lookup_loop)) || (ram != s_variable_ramof_get(s_id32s[i], bench_lookup_precomputed)))
+        {
+            printf("FAIL: the ram of 0x%08x differs\n", s_id32s[i]);
+            errors++;
+        }
+    }
+
+    if(0 == errors)
+    {
+        printf("%-12s %6s %14s\n", "offsets", "ids", "lookups/s");
+        for(l=0; l<3; l++)
+        {
+            printf("%-12s %6u %14.0f\n", names[l], s_numberofid32s, s_run(brd, (bench_lookup_t)l, ms));
+        }
+    }
+
+    eo_hosttransceiver_Delete(host);
+
+    printf("%s\n", (0 == errors) ? "OK" : "FAIL");
+    return((0 == errors) ? 0 : 1);
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+// it takes a named EOYmutex with the user backend, whose take ignores the timeout as the ace mutex of the host does,
+// while another thread holds it for some milliseconds. the lock-contention profiler must record the take as contended
+// and its wait. it needs the library built with EMBOBJ_MUTEX_PROFILER, otherwise it is skipped.
+
+#include "EoCommon.h"
+#include "EOVmutex.h"
+#include "EOYmutex.h"
+
+#include "test_host.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+
+#define HOLDMILLISEC    20
+
+static EOVmutexDerived *s_mutex = NULL;
+static volatile int s_taken = 0;
+
+static void* s_holder(void *arg)
+{
+    (void)arg;
+    eov_mutex_Take(s_mutex, eok_reltimeINFINITE);
+    s_taken = 1;
+    usleep(1000*HOLDMILLISEC);
+    eov_mutex_Release(s_mutex);
+    return(NULL);
+}
+
+int main(void)
+{
+    static const char name[] = "test.profiler";
+    eOvmutex_profile_t profile;
+    pthread_t holder;
+    int errors = 0;
+    uint16_t i = 0;
+
+    test_host_Initialise(eoy_mutex_backend_user);
+    s_mutex = eoy_mutex_New();
+
+    if(eores_NOK_unsupported == eov_mutex_SetName(s_mutex, name))
+    {
+        printf("SKIP: the profiler is not compiled in\n");
+        return(0);
+    }
+
+    pthread_create(&holder, NULL, s_holder, NULL);
+    while(0 == s_taken)
+    {
+        sched_yield();
+    }
+    // the attempt without waiting of the profiler blocks until the holder releases
+    eov_mutex_Take(s_mutex, eok_reltimeINFINITE);
+    eov_mutex_Release(s_mutex);
+    pthread_join(holder, NULL);
+
+    memset(&profile, 0, sizeof(profile));
+    for(i=0; i<eov_mutex_Profiler_NumberOf(); i++)
+    {
+        if((eores_OK == eov_mutex_Profiler_Get(i, &profile)) && (name == profile.name))
+        {
+            break;
+        }
+    }
+
+    if(2 != profile.takes)
+    {
+        printf("FAIL: %llu takes instead of 2\n", (unsigned long long)profile.takes);
+        errors++;
+    }
+    if(profile.contended < 1)
+    {
+        printf("FAIL: the blocked take is not counted as contended\n");
+        errors++;
+    }
+    if(profile.waitmaxnanosec < (HOLDMILLISEC/2)*1000000ULL)
+    {
+        printf("FAIL: the longest wait is %llu ns\n", (unsigned long long)profile.waitmaxnanosec);
+        errors++;
+    }
+
+    eoy_mutex_Delete(s_mutex);
+
+    printf("%s: %llu takes, %llu contended, max wait %llu us\n", (0 == errors) ? "OK" : "FAIL", (unsigned long long)profile.takes,
+           (unsigned long long)profile.contended, (unsigned long long)(profile.waitmaxnanosec/1000));
+    return((0 == errors) ? 0 : 1);
+}
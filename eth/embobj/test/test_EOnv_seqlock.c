@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+// it runs the remote set<> and say<> paths of an NV protected by eo_nvset_protection_seqlock_per_netvar while other 
+// threads read the NV. the update() and onsay() callbacks rewrite the ram byte by byte and yield in the middle, so 
+// that a reader which is not kept out of the write section sees a torn value. it also verifies that a change done 
+// inside onsay() marks the NV as dirty, and that an onsay() which calls eo_nv_Get() and eo_nv_Set() on its own NV 
+// does not wait for itself.
+
+#include "EoCommon.h"
+#include "EOYtheSystem.h"
+#include "EOhostTransceiver.h"
+#include "EOnvSet.h"
+#include "EOnv_hid.h"
+#include "EoProtocol.h"
+#include "EoProtocolMC.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+
+#define NUMBEROFREADERS     2
+#define NUMBEROFWRITES      100
+
+static EOnvSet *s_nvset = NULL;
+static eOnvID32_t s_id32 = 0;
+static volatile int s_stop = 0;
+static volatile int s_torn = 0;
+static volatile long s_reads = 0;
+static int s_reentrant = 0;
+
+
+static void s_rewrite(const EOnv *nv, uint8_t value)
+{   // byte by byte with a yield in the middle: an unprotected reader surely sees half of the change
+    volatile uint8_t *ram = (volatile uint8_t*) eo_nv_RAM(nv);
+    uint16_t size = eo_nv_Size(nv);
+    uint16_t i = 0;
+    for(i=0; i<size; i++)
+    {
+        ram[i] = value;
+        if(i == size/2)
+        {
+            sched_yield();
+        }
+    }
+}
+
+static void s_update(const EOnv *nv, const eOropdescriptor_t *rd)
+{
+    (void)rd;
+    s_rewrite(nv, (uint8_t)(((uint8_t*)eo_nv_RAM(nv))[0] + 1));
+}
+
+static void s_onsay(const EOnv *nv, const eOropdescriptor_t *rd)
+{
+    uint8_t buffer[256];
+    uint16_t size = 0;
+    (void)rd;
+    
+    if(0 == s_reentrant)
+    {
+        s_rewrite(nv, (uint8_t)(((uint8_t*)eo_nv_RAM(nv))[0] + 2));
+        return;
+    }
+    
+    // the public functions on the NV whose write section is open in this thread 
+    eo_nv_Get(nv, eo_nv_strg_volatile, buffer, &size);
+    memset(buffer, buffer[0] + 3, size);
+    eo_nv_Set(nv, buffer, eobool_true, eo_nv_upd_dontdo);
+}
+
+static void* s_reader(void *arg)
+{
+    EOnv nv;
+    uint8_t buffer[256];
+    uint16_t size = 0;
+    uint16_t i = 0;
+    (void)arg;
+    
+    eo_nvset_NV_Get(s_nvset, s_id32, &nv);
+    while(0 == s_stop)
+    {
+        eo_nv_Get(&nv, eo_nv_strg_volatile, buffer, &size);
+        for(i=1; i<size; i++)
+        {
+            if(buffer[i] != buffer[0])
+            {
+                s_torn++;
+                break;
+            }
+        }
+        s_reads++;
+    }
+    return(NULL);
+}
+
+int main(void)
+{
+    eOhosttransceiver_cfg_t cfg = eo_hosttransceiver_cfg_default;
+    eOprot_callbacks_variable_descriptor_t cbk = {0};
+    eOropdescriptor_t ropdes = eok_ropdesc_basic;
+    EOhostTransceiver *hosttxrx = NULL;
+    pthread_t readers[NUMBEROFREADERS];
+    uint8_t value[256];
+    uint8_t copy[256];
+    uint16_t size = 0;
+    EOnv nv;
+    int errors = 0;
+    int i = 0;
+    
+    eoy_sys_Initialise(NULL, NULL, NULL);
+    
+    s_id32 = eoprot_ID_get(eoprot_endpoint_motioncontrol, eoprot_entity_mc_joint, 0, eoprot_tag_mc_joint_status);
+    
+    cbk.endpoint = eoprot_endpoint_motioncontrol;
+    cbk.entity = eoprot_entity_mc_joint;
+    cbk.tag = eoprot_tag_mc_joint_status;
+    cbk.update = s_update;
+    eoprot_config_callbacks_variable_set(&cbk);
+    eoprot_config_onsay_endpoint_set(eoprot_endpoint_motioncontrol, s_onsay);
+    
+    cfg.nvsetbrdcfg = &eonvset_BRDcfgMax;
+    cfg.nvsetprotection = eo_nvset_protection_seqlock_per_netvar;
+    hosttxrx = eo_hosttransceiver_New(&cfg);
+    s_nvset = eo_hosttransceiver_GetNVset(hosttxrx);
+    eo_nvset_DirtyTracking_Enable(s_nvset);
+    
+    if(eores_OK != eo_nvset_NV_Get(s_nvset, s_id32, &nv))
+    {
+        printf("FAIL: cannot get the nv\n");
+        return(1);
+    }
+    if(NULL == nv.seqlock)
+    {   // without c11 atomics the mode is mutex based and there is nothing to verify
+        printf("SKIP: the nv does not have a sequence counter\n");
+        return(0);
+    }
+    
+    // 1. remote set<> and say<> alongside the readers
+    for(i=0; i<NUMBEROFREADERS; i++)
+    {
+        pthread_create(&readers[i], NULL, s_reader, NULL);
+    }
+    ropdes.id32 = s_id32;
+    for(i=0; i<NUMBEROFWRITES; i++)
+    {
+        memset(value, (uint8_t)(4*i), sizeof(value));
+        ropdes.ropcode = eo_ropcode_set;
+        eo_nv_hid_remoteSetROP(&nv, value, eo_nv_upd_always, &ropdes);
+        ropdes.ropcode = eo_ropcode_say;
+        eo_nv_hid_remoteSetROP(&nv, value, eo_nv_upd_always, &ropdes);
+        eo_nv_hid_OnSay(&nv, &ropdes);
+    }
+    s_stop = 1;
+    for(i=0; i<NUMBEROFREADERS; i++)
+    {
+        pthread_join(readers[i], NULL);
+    }
+    if(0 != s_torn)
+    {
+        printf("FAIL: %d torn reads over %ld\n", s_torn, s_reads);
+        errors++;
+    }
+    
+    // 2. a change done by onsay() must be seen by the refresh of the dirty nvs
+    eo_nv_hid_Fast_LocalMemoryGetIfDirty(&nv, copy);
+    if(0 != eo_nv_hid_Fast_LocalMemoryGetIfDirty(&nv, copy))
+    {
+        printf("FAIL: the nv is still dirty after a refresh\n");
+        errors++;
+    }
+    eo_nv_hid_OnSay(&nv, &ropdes);
+    if(eo_nv_Capacity(&nv) != eo_nv_hid_Fast_LocalMemoryGetIfDirty(&nv, copy))
+    {
+        printf("FAIL: the change done by onsay() is not marked as dirty\n");
+        errors++;
+    }
+    else if(0 != memcmp(copy, eo_nv_RAM(&nv), eo_nv_Capacity(&nv)))
+    {
+        printf("FAIL: the refresh does not copy the change done by onsay()\n");
+        errors++;
+    }
+    
+    // 3. onsay() reads and writes its own NV: a wait for the write section of the same thread never ends
+    alarm(10);
+    s_reentrant = 1;
+    memcpy(value, eo_nv_RAM(&nv), eo_nv_Capacity(&nv));
+    eo_nv_hid_OnSay(&nv, &ropdes);
+    alarm(0);
+    eo_nv_Get(&nv, eo_nv_strg_volatile, copy, &size);
+    if((copy[0] != (uint8_t)(value[0] + 3)) || (copy[eo_nv_Capacity(&nv)-1] != (uint8_t)(value[0] + 3)))
+    {
+        printf("FAIL: the eo_nv_Set() inside onsay() is lost\n");
+        errors++;
+    }
+    if(0 != (atomic_load((atomic_uint_least32_t*) nv.seqlock) & 1))
+    {
+        printf("FAIL: the write section is still open after onsay()\n");
+        errors++;
+    }
+    
+    printf("%s: %ld reads\n", (0 == errors) ? "OK" : "FAIL", s_reads);
+    return((0 == errors) ? 0 : 1);
+}
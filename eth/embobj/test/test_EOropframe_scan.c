@@ -0,0 +1,232 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+// it verifies eo_ropframe_Scan(): the offsets of the rops of a valid ropframe, the refusal of the ropframes with a
+// corrupted header, rop head or size, the offsets limited to their capacity, and random corruptions which must never
+// give offsets outside of the rops. then it verifies that the EOreceiver processes every rop of a valid ropframe,
+// also when the packet holds more rops than the offsets sized by the first packet, and none of a corrupted one.
+
+#include "EoCommon.h"
+#include "EOYtheSystem.h"
+#include "EOhostTransceiver.h"
+#include "EOtransceiver.h"
+#include "EOreceiver.h"
+#include "EOpacket.h"
+#include "EOropframe.h"
+#include "EOropframe_hid.h"
+#include "EOrop.h"
+#include "EoProtocol.h"
+#include "EoProtocolMC.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#define MAXFRAMESIZE    1408
+#define MAXROPS         200
+#define FUZZITERATIONS  20000
+
+static uint8_t s_frame[MAXFRAMESIZE];
+static uint16_t s_framesize = 0;
+static int s_errors = 0;
+
+static void s_check(int condition, const char *what)
+{
+    if(!condition)
+    {
+        printf("FAIL: %s\n", what);
+        s_errors++;
+    }
+}
+
+static uint16_t s_build(uint16_t numberofrops, uint16_t capacity, uint32_t (*id32of)(uint16_t))
+{   // ask<> rops, sig<> rops of various sizes, some with time. it returns the number of rops which fit in capacity
+    EOropframeHeader_t *header = (EOropframeHeader_t*) s_frame;
+    uint32_t endoframe = EOFRAME_END;
+    uint16_t offset = sizeof(EOropframeHeader_t);
+    uint16_t ropsize = 0;
+    uint16_t i = 0;
+
+    memset(s_frame, 0, sizeof(s_frame));
+    header->startofframe = EOFRAME_START;
+    for(i=0; i<numberofrops; i++)
+    {
+        eOrophead_t *head = (eOrophead_t*) &s_frame[offset];
+        head->ropc = (0 == (i % 3)) ? (eo_ropcode_ask) : (eo_ropcode_sig);
+        head->dsiz = (eo_ropcode_ask == head->ropc) ? (0) : (1 + (i % 23));
+        head->ctrl.plustime = (0 == (i % 5)) ? (1) : (0);
+        head->id32 = id32of(i);
+        ropsize = sizeof(eOrophead_t) + eo_rop_datafield_effective_size(head->dsiz) + ((1 == head->ctrl.plustime) ? (8) : (0));
+        if((offset + ropsize + sizeof(endoframe)) > capacity)
+        {
+            memset(head, 0, sizeof(eOrophead_t));
+            break;
+        }
+        offset += ropsize;
+        header->ropsnumberof++;
+    }
+    header->ropssizeof = offset - sizeof(EOropframeHeader_t);
+    memcpy(&s_frame[offset], &endoframe, sizeof(endoframe));
+    s_framesize = offset + sizeof(endoframe);
+    return(header->ropsnumberof);
+}
+
+static uint32_t s_index(uint16_t i)
+{
+    return(i);
+}
+
+static uint32_t s_joint(uint16_t i)
+{
+    return(eoprot_ID_get(eoprot_endpoint_motioncontrol, eoprot_entity_mc_joint, i % 4, eoprot_tag_mc_joint_status));
+}
+
+static void s_scan(void)
+{
+    static const struct { const char *name; uint16_t position; uint8_t value; } corruptions[] =
+    {
+        { "a wrong start of frame is accepted",             0,  0x00 },
+        { "a wrong size of the rops is accepted",           4,  0x10 },
+        { "a wrong number of rops is accepted",             6,  0x3b },
+        { "a rop with a wrong version is accepted",         24, 0xc0 },
+        { "a rop with a wrong ropcode is accepted",         25, 0x09 },
+        { "a rop longer than the ropframe is accepted",     26, 0xfe },
+        { "a rop of almost 64k is accepted",                27, 0xff }
+    };
+    uint16_t offsets[MAXROPS];
+    uint16_t numberofrops = 0;
+    uint16_t built = 0;
+    uint16_t i = 0;
+    int wrong = 0;
+    int accepted = 0;
+    int k = 0;
+
+    // the offsets of a valid ropframe
+    built = s_build(60, MAXFRAMESIZE, s_index);
+    s_check(eores_OK == eo_ropframe_Scan(s_frame, s_framesize, offsets, MAXROPS, &numberofrops), "a valid ropframe is refused");
+    s_check(built == numberofrops, "wrong number of rops");
+    for(i=0; i<numberofrops; i++)
+    {
+        const eOrophead_t *head = (const eOrophead_t*) &s_frame[sizeof(EOropframeHeader_t) + offsets[i]];
+        wrong += (head->id32 != i) ? (1) : (0);
+    }
+    s_check(0 == wrong, "an offset does not point to its rop");
+    s_check(eores_NOK_generic == eo_ropframe_Scan(s_frame, s_framesize - 1, NULL, 0, NULL), "a truncated ropframe is accepted");
+    s_check(eores_NOK_nullpointer == eo_ropframe_Scan(NULL, s_framesize, NULL, 0, NULL), "a NULL ropframe is accepted");
+
+    // only as many offsets as their capacity are written, but all the rops are counted
+    memset(offsets, 0xff, sizeof(offsets));
+    s_check(eores_OK == eo_ropframe_Scan(s_frame, s_framesize, offsets, 10, &numberofrops), "the scan fails with few offsets");
+    s_check((built == numberofrops) && (0xffff == offsets[10]) && (0xffff != offsets[9]), "the offsets exceed their capacity");
+
+    for(k=0; k<(int)(sizeof(corruptions)/sizeof(corruptions[0])); k++)
+    {
+        s_build(60, MAXFRAMESIZE, s_index);
+        s_frame[corruptions[k].position] = corruptions[k].value;
+        if(27 == corruptions[k].position)
+        {
+            s_frame[26] = 0xfe;
+        }
+        s_check(eores_NOK_generic == eo_ropframe_Scan(s_frame, s_framesize, offsets, MAXROPS, &numberofrops), corruptions[k].name);
+    }
+
+    // random corruptions: an accepted ropframe has increasing offsets which stay inside of its rops
+    srand(3);
+    for(k=0; k<FUZZITERATIONS; k++)
+    {
+        uint16_t size = 0;
+        int bytes = 1 + (rand() % 4);
+        s_build(1 + (rand() % 60), MAXFRAMESIZE, s_index);
+        while(bytes-- > 0)
+        {
+            s_frame[rand() % s_framesize] = (uint8_t) rand();
+        }
+        size = (0 == (rand() % 2)) ? (s_framesize) : ((uint16_t)(rand() % s_framesize));
+        if(eores_OK == eo_ropframe_Scan(s_frame, size, offsets, MAXROPS, &numberofrops))
+        {
+            const EOropframeHeader_t *header = (const EOropframeHeader_t*) s_frame;
+            accepted++;
+            for(i=0; i<numberofrops; i++)
+            {
+                if(((i > 0) && (offsets[i] <= offsets[i-1])) || ((offsets[i] + sizeof(eOrophead_t)) > header->ropssizeof))
+                {
+                    wrong++;
+                    break;
+                }
+            }
+        }
+    }
+    s_check(0 == wrong, "a corrupted ropframe is accepted with offsets outside of its rops");
+    printf("scan: %d of %d corrupted ropframes are still valid\n", accepted, FUZZITERATIONS);
+}
+
+static eOresult_t s_receive(EOreceiver *receiver, uint16_t capacity, uint16_t *numberofrops)
+{
+    EOpacket *packet = eo_packet_New(capacity);
+    eOresult_t res = eores_NOK_generic;
+    *numberofrops = 0xffff;
+    eo_packet_Payload_Set(packet, s_frame, s_framesize);
+    eo_packet_Addressing_Set(packet, EO_COMMON_IPV4ADDR(10, 0, 1, 1), 12345);
+    res = eo_receiver_ProcessAppend(receiver, packet, numberofrops, NULL, NULL, NULL, NULL);
+    eo_receiver_ClearReply(receiver);
+    eo_packet_Delete(packet);
+    return(res);
+}
+
+static void s_receiver(void)
+{
+    eOhosttransceiver_cfg_t cfg = eo_hosttransceiver_cfg_default;
+    EOhostTransceiver *host = NULL;
+    EOreceiver *receiver = NULL;
+    uint16_t offsets[MAXROPS];
+    uint16_t numberofrops = 0;
+    uint16_t built = 0;
+
+    cfg.nvsetbrdcfg = &eonvset_BRDcfgMax;
+    host = eo_hosttransceiver_New(&cfg);
+    receiver = eo_transceiver_GetReceiver(eo_hosttransceiver_GetTransceiver(host));
+
+    // the first packet is small: it sizes the offsets of the receiver
+    built = s_build(10, 256, s_joint);
+    s_check(eores_OK == s_receive(receiver, 256, &numberofrops), "the receiver refuses a valid ropframe");
+    s_check(built == numberofrops, "the receiver does not process every rop");
+
+    // a bigger packet has more rops than the offsets
+    built = s_build(MAXROPS, MAXFRAMESIZE, s_joint);
+    s_check(built > ((256 - eo_ropframe_sizeforZEROrops) / sizeof(eOrophead_t)), "the ropframe does not have more rops than the offsets");
+    s_check(eores_OK == s_receive(receiver, MAXFRAMESIZE, &numberofrops), "the receiver refuses a ropframe with more rops than its offsets");
+    s_check(built == numberofrops, "the receiver does not process the rops beyond its offsets");
+
+    // a rop in the middle with a wrong ropcode: no rop is processed
+    s_build(40, MAXFRAMESIZE, s_joint);
+    eo_ropframe_Scan(s_frame, s_framesize, offsets, MAXROPS, NULL);
+    s_frame[sizeof(EOropframeHeader_t) + offsets[20] + 1] = 0x09;
+    s_check(eores_NOK_generic == s_receive(receiver, MAXFRAMESIZE, &numberofrops), "the receiver accepts a corrupted ropframe");
+    s_check(0xffff == numberofrops, "the receiver processes rops of a corrupted ropframe");
+
+    eo_hosttransceiver_Delete(host);
+}
+
+int main(void)
+{
+    eoy_sys_Initialise(NULL, NULL, NULL);
+
+    s_scan();
+    s_receiver();
+
+    printf("%s\n", (0 == s_errors) ? "OK" : "FAIL");
+    return((0 == s_errors) ? 0 : 1);
+}
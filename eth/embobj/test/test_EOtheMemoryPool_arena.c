@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+// it runs many short-lived threads one after the other in mode eo_mempool_alloc_arena. each thread allocates some 
+// objects, releases half of them and leaves the others to the main thread, which releases them after the thread has 
+// exited. the arena of an exited thread must be reused by the next thread, thus the heap must serve only one chunk.
+
+#include "EoCommon.h"
+#include "EOtheMemoryPool.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+#define NUMBEROFTHREADS     64
+#define NUMBEROFOBJECTS     256
+#define SIZEOFOBJECT        48
+
+static volatile uint32_t s_bigallocations = 0;
+static void* s_leftover[NUMBEROFOBJECTS/2];
+
+static void* s_allocate(uint32_t size)
+{
+    if(size > 64*1024)
+    {   // only the chunks of the arenas are so big
+        s_bigallocations++;
+    }
+    return(calloc(size, 1));
+}
+
+static void* s_reallocate(void *m, uint32_t size)
+{
+    return(realloc(m, size));
+}
+
+static void s_release(void *m)
+{
+    free(m);
+}
+
+static void* s_thread(void *arg)
+{
+    void *objects[NUMBEROFOBJECTS];
+    int i = 0;
+    (void)arg;
+    
+    for(i=0; i<NUMBEROFOBJECTS; i++)
+    {
+        objects[i] = eo_mempool_New(eo_mempool_GetHandle(), SIZEOFOBJECT);
+    }
+    for(i=0; i<NUMBEROFOBJECTS/2; i++)
+    {
+        eo_mempool_Delete(eo_mempool_GetHandle(), objects[2*i]);
+        s_leftover[i] = objects[2*i+1];
+    }
+    return(NULL);
+}
+
+int main(void)
+{
+    static eOmempool_alloc_config_t alloc = {0};
+    eOmempool_cfg_t cfg = {0};
+    eOmempool_arena_stats_t stats;
+    pthread_t thread;
+    int errors = 0;
+    int i = 0;
+    int j = 0;
+    
+    alloc.heap.allocate = s_allocate;
+    alloc.heap.reallocate = s_reallocate;
+    alloc.heap.release = s_release;
+    cfg.mode = eo_mempool_alloc_arena;
+    cfg.conf = &alloc;
+    eo_mempool_Initialise(&cfg);
+    
+    if(eo_mempool_alloc_arena != eo_mempool_alloc_mode_Get(eo_mempool_GetHandle()))
+    {
+        printf("SKIP: the arenas are not available\n");
+        return(0);
+    }
+    
+    for(i=0; i<NUMBEROFTHREADS; i++)
+    {
+        pthread_create(&thread, NULL, s_thread, NULL);
+        pthread_join(thread, NULL);
+        // the objects left by the exited thread go into the remote lists of its arena
+        for(j=0; j<NUMBEROFOBJECTS/2; j++)
+        {
+            eo_mempool_Delete(eo_mempool_GetHandle(), s_leftover[j]);
+        }
+    }
+    
+    if(1 != s_bigallocations)
+    {
+        printf("FAIL: %u chunks for %d threads which did not run together\n", s_bigallocations, NUMBEROFTHREADS);
+        errors++;
+    }
+    
+    eo_mempool_arena_Stats_Get(eo_mempool_GetHandle(), &stats);
+    if(0 != stats.usedbytes)
+    {
+        printf("FAIL: %u bytes still in use\n", stats.usedbytes);
+        errors++;
+    }
+    
+    printf("%s: %u chunks\n", (0 == errors) ? "OK" : "FAIL", s_bigallocations);
+    return((0 == errors) ? 0 : 1);
+}
@@ -0,0 +1,412 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+// it verifies the coalescing of the occasional rops of the EOtransmitter. 100 ask<> rops on 5 ids must become 5 rops
+// in the order of their first arrival, or stay 100 when the coalescing is disabled. rops with a different ctrl or
+// size, or with a confirmation request, must not be merged. the rops of eo_transmitter_occasional_rops_LoadStream()
+// and those of the staging mode must be coalesced one by one. after a packet which carries over part of the rops the
+// index must point to the new offsets of the rops left. every time the waiting rops must form a valid ropframe.
+
+#include "EoCommon.h"
+#include "EOYtheSystem.h"
+#include "EOhostTransceiver.h"
+#include "EOtransceiver.h"
+#include "EOtransmitter.h"
+#include "EOtransmitter_hid.h"
+#include "EOpacket.h"
+#include "EOropframe.h"
+#include "EOropframe_hid.h"
+#include "EOrop.h"
+#include "EoProtocol.h"
+
+#include <stdio.h>
+#include <string.h>
+
+
+#define NUMBEROFIDS         5
+#define NUMBEROFROUNDS      20
+#define MAXIDS              16
+#define MAXROPS             128
+#define MAXSIZEOFVALUE      16
+
+typedef struct
+{   // a rop waiting inside the ropframe of the occasionals
+    uint32_t                    id32;
+    eOropcode_t                 ropc;
+    eOropctrl_t                 ctrl;
+    uint16_t                    dsiz;
+    uint32_t                    value;
+} waiting_t;
+
+static int s_errors = 0;
+static uint32_t s_id32s[MAXIDS];
+static uint16_t s_numberofid32s = 0;
+static EOhostTransceiver *s_host = NULL;
+static EOtransmitter *s_tx = NULL;
+static waiting_t s_waiting[MAXROPS];
+
+static void s_check(int condition, const char *what)
+{
+    if(!condition)
+    {
+        printf("FAIL: %s\n", what);
+        s_errors++;
+    }
+}
+
+static void s_new(uint16_t capacityofpacket, eObool_t coalescing)
+{   // the ids are the first ones of the board whose variable has from 4 to MAXSIZEOFVALUE bytes
+    eOhosttransceiver_cfg_t cfg = eo_hosttransceiver_cfg_default;
+    uint8_t ep = 0;
+    uint8_t en = 0;
+    uint8_t ix = 0;
+    uint8_t tg = 0;
+
+    cfg.nvsetbrdcfg = &eonvset_BRDcfgMax;
+    cfg.sizes.capacityoftxpacket = capacityofpacket;
+    cfg.sizes.capacityofropframeoccasionals = eo_ropframe_sizeforZEROrops + 1024;
+    s_host = eo_hosttransceiver_New(&cfg);
+    s_tx = eo_transceiver_GetTransmitter(eo_hosttransceiver_GetTransceiver(s_host));
+    eo_transmitter_occasional_rops_Coalescing_Set(s_tx, coalescing);
+
+    if(0 != s_numberofid32s)
+    {
+        return;
+    }
+    for(ep=0; ep<eoprot_endpoints_numberof; ep++)
+    {
+        for(en=0; en<8; en++)
+        {
+            for(ix=0; ix<12; ix++)
+            {
+                for(tg=0; tg<64; tg++)
+                {
+                    uint32_t id32 = eoprot_ID_get(ep, en, ix, tg);
+                    uint16_t size = 0;
+                    if((s_numberofid32s >= MAXIDS) || (eobool_false == eoprot_id_isvalid(eo_hosttransceiver_GetBoardNumber(s_host), id32)))
+                    {
+                        continue;
+                    }
+                    size = eoprot_variable_sizeof_get(eo_hosttransceiver_GetBoardNumber(s_host), id32);
+                    if((size >= sizeof(uint32_t)) && (size <= MAXSIZEOFVALUE))
+                    {
+                        s_id32s[s_numberofid32s++] = id32;
+                    }
+                }
+            }
+        }
+    }
+}
+
+static eOresult_t s_ask(uint32_t id32, eOropctrl_t ctrl)
+{
+    eOropdescriptor_t ropdes = eok_ropdesc_basic;
+
+    ropdes.ropcode = eo_ropcode_ask;
+    ropdes.control = ctrl;
+    ropdes.id32 = id32;
+    return(eo_transmitter_occasional_rops_Load(s_tx, &ropdes));
+}
+
+static eOresult_t s_set(uint32_t id32, uint32_t value)
+{   // the value goes in the first 4 bytes, the others are zero. the transmitter gives the rop the size of the variable
+    eOropdescriptor_t ropdes = eok_ropdesc_basic;
+    uint8_t data[MAXSIZEOFVALUE] = {0};
+
+    memcpy(data, &value, sizeof(value));
+    ropdes.ropcode = eo_ropcode_set;
+    ropdes.id32 = id32;
+    ropdes.data = data;
+    return(eo_transmitter_occasional_rops_Load(s_tx, &ropdes));
+}
+
+static uint16_t s_append(uint8_t *stream, uint16_t size, eOropcode_t ropc, uint32_t id32, uint32_t value, uint16_t dsiz)
+{   // it appends to stream a rop w/o sign and time and returns the new size. the value goes in the first 4 bytes of data
+    eOrophead_t head;
+
+    memset(&head, 0, sizeof(head));
+    head.ropc = ropc;
+    head.dsiz = dsiz;
+    head.id32 = id32;
+    memcpy(&stream[size], &head, sizeof(head));
+    size += sizeof(head);
+    if(0 != dsiz)
+    {
+        memset(&stream[size], 0, eo_rop_datafield_effective_size(dsiz));
+        memcpy(&stream[size], &value, sizeof(value));
+        size += eo_rop_datafield_effective_size(dsiz);
+    }
+    return(size);
+}
+
+static int s_scan(void)
+{   // it fills s_waiting with the rops of the occasionals and returns their number, or -1 if they are not a valid ropframe
+    EOropframe *ropframe = s_tx->ropframeoccasionals;
+    uint16_t offsets[MAXROPS];
+    uint16_t n = 0;
+    uint16_t i = 0;
+
+    if(eores_OK != eo_ropframe_Scan((const uint8_t*)ropframe->framedata, ropframe->size, offsets, MAXROPS, &n))
+    {
+        return(-1);
+    }
+    if(n > MAXROPS)
+    {
+        return(-1);
+    }
+    for(i=0; i<n; i++)
+    {
+        const uint8_t *rop = eo_ropframe_hid_get_pointer_offset(ropframe, offsets[i]);
+        const eOrophead_t *head = (const eOrophead_t*)rop;
+        memset(&s_waiting[i], 0, sizeof(waiting_t));
+        s_waiting[i].id32 = head->id32;
+        s_waiting[i].ropc = (eOropcode_t)head->ropc;
+        s_waiting[i].ctrl = head->ctrl;
+        s_waiting[i].dsiz = head->dsiz;
+        if(head->dsiz >= sizeof(uint32_t))
+        {
+            memcpy(&s_waiting[i].value, &rop[sizeof(eOrophead_t)], sizeof(uint32_t));
+        }
+    }
+    return(n);
+}
+
+static void s_hundred(void)
+{   // 100 ask<> on 5 ids, w/ and w/o coalescing
+    uint32_t coalesced = 0;
+    int accepted = 0;
+    int inorder = 1;
+    int n = 0;
+    int r = 0;
+    int i = 0;
+
+    s_new(eo_ropframe_sizeforZEROrops + 1024, eobool_false);
+    for(r=0; r<NUMBEROFROUNDS; r++)
+    {
+        for(i=0; i<NUMBEROFIDS; i++)
+        {
+            accepted += (eores_OK == s_ask(s_id32s[i], eok_ropctrl_basic)) ? (1) : (0);
+        }
+    }
+    n = s_scan();
+    s_check((NUMBEROFROUNDS*NUMBEROFIDS == accepted) && (NUMBEROFROUNDS*NUMBEROFIDS == n), "the rops are not all kept without coalescing");
+    s_check(0 == eo_transmitter_occasional_rops_Coalesced_Get(s_tx), "rops are coalesced without coalescing");
+
+    // the rops already waiting are indexed when the coalescing is enabled
+    eo_transmitter_occasional_rops_Coalescing_Set(s_tx, eobool_true);
+    s_ask(s_id32s[0], eok_ropctrl_basic);
+    s_check((n == s_scan()) && (1 == eo_transmitter_occasional_rops_Coalesced_Get(s_tx)), "the rops waiting before the coalescing are not indexed");
+    eo_hosttransceiver_Delete(s_host);
+
+    s_new(eo_ropframe_sizeforZEROrops + 1024, eobool_true);
+    for(r=0; r<NUMBEROFROUNDS; r++)
+    {
+        for(i=0; i<NUMBEROFIDS; i++)
+        {
+            s_ask(s_id32s[i], eok_ropctrl_basic);
+        }
+    }
+    coalesced = eo_transmitter_occasional_rops_Coalesced_Get(s_tx);
+    n = s_scan();
+    for(i=0; (i<n) && (i<NUMBEROFIDS); i++)
+    {
+        inorder &= ((s_waiting[i].id32 == s_id32s[i]) && (eo_ropcode_ask == s_waiting[i].ropc)) ? (1) : (0);
+    }
+    s_check(NUMBEROFIDS == n, "100 ask<> on 5 ids do not become 5 rops");
+    s_check(((NUMBEROFROUNDS-1)*NUMBEROFIDS) == coalesced, "wrong number of coalesced rops");
+    s_check(inorder, "the coalesced rops are not in the order of their first arrival");
+
+    // a later value replaces the waiting one in its position
+    s_set(s_id32s[5], 1);
+    s_ask(s_id32s[6], eok_ropctrl_basic);
+    s_set(s_id32s[5], 2);
+    n = s_scan();
+    s_check((NUMBEROFIDS+2 == n) && (s_id32s[5] == s_waiting[NUMBEROFIDS].id32) && (2 == s_waiting[NUMBEROFIDS].value),
+            "a coalesced set<> does not keep the last value in the first position");
+    eo_hosttransceiver_Delete(s_host);
+}
+
+static void s_mismatch(void)
+{   // rops with the same id32 and ropcode but with a different ctrl or size, and rops which request a confirmation.
+    // the transmitter gives a set<> the size of its variable, thus the rops of different size come from a stream
+    eOropctrl_t rqsttime = eok_ropctrl_basic;
+    eOropctrl_t plussign = eok_ropctrl_basic;
+    eOropctrl_t rqstconf = eok_ropctrl_basic;
+    uint8_t stream[64];
+    uint16_t size = 0;
+    int n = 0;
+
+    rqsttime.rqsttime = 1;
+    plussign.plussign = 1;
+    rqstconf.rqstconf = 1;
+    s_new(eo_ropframe_sizeforZEROrops + 1024, eobool_true);
+
+    s_ask(s_id32s[0], eok_ropctrl_basic);
+    s_ask(s_id32s[0], rqsttime);                    // same size, different ctrl
+    s_ask(s_id32s[0], plussign);                    // different ctrl and size
+    size = s_append(stream, size, eo_ropcode_set, s_id32s[1], 1, 4);
+    size = s_append(stream, size, eo_ropcode_set, s_id32s[1], 2, 8);   // same ctrl, different size
+    eo_transmitter_occasional_rops_LoadStream(s_tx, stream, size);
+    s_ask(s_id32s[2], rqstconf);
+    s_ask(s_id32s[2], rqstconf);                    // never merged
+    n = s_scan();
+    s_check(7 == n, "rops with a different ctrl or size, or with a confirmation request, are coalesced");
+    s_check(0 == eo_transmitter_occasional_rops_Coalesced_Get(s_tx), "rops are counted as coalesced after a mismatch");
+
+    // after a mismatch the index points to the later rop
+    s_ask(s_id32s[0], plussign);
+    size = s_append(stream, 0, eo_ropcode_set, s_id32s[1], 3, 8);
+    eo_transmitter_occasional_rops_LoadStream(s_tx, stream, size);
+    n = s_scan();
+    s_check((7 == n) && (2 == eo_transmitter_occasional_rops_Coalesced_Get(s_tx)), "the rops after a mismatch are not coalesced");
+    s_check((7 == n) && (1 == s_waiting[3].value) && (4 == s_waiting[3].dsiz) && (3 == s_waiting[4].value) && (8 == s_waiting[4].dsiz),
+            "a rop is coalesced into one with a different size");
+    s_check((7 == n) && (0 == s_waiting[0].ctrl.rqsttime) && (1 == s_waiting[1].ctrl.rqsttime) && (1 == s_waiting[2].ctrl.plussign),
+            "a rop is coalesced into one with a different ctrl");
+    eo_hosttransceiver_Delete(s_host);
+}
+
+static void s_stream(void)
+{   // a stream w/ duplicates is coalesced rop by rop, and the rops which follow a removed one keep a valid offset
+    uint8_t stream[128];
+    uint16_t size = 0;
+    int n = 0;
+
+    s_new(eo_ropframe_sizeforZEROrops + 1024, eobool_true);
+    s_ask(s_id32s[0], eok_ropctrl_basic);
+
+    size = s_append(stream, size, eo_ropcode_set, s_id32s[1], 1, 4);
+    size = s_append(stream, size, eo_ropcode_ask, s_id32s[2], 0, 0);
+    size = s_append(stream, size, eo_ropcode_set, s_id32s[1], 2, 4);
+    size = s_append(stream, size, eo_ropcode_ask, s_id32s[0], 0, 0);
+    size = s_append(stream, size, eo_ropcode_sig, s_id32s[3], 0, 4);
+    size = s_append(stream, size, eo_ropcode_sig, s_id32s[3], 0, 4);
+    size = s_append(stream, size, eo_ropcode_ask, s_id32s[2], 0, 0);
+    size = s_append(stream, size, eo_ropcode_set, s_id32s[1], 3, 4);
+    s_check(eores_OK == eo_transmitter_occasional_rops_LoadStream(s_tx, stream, size), "the stream is refused");
+
+    n = s_scan();
+    s_check(5 == n, "the duplicates of the stream are not coalesced or the ropframe is not valid");
+    s_check(4 == eo_transmitter_occasional_rops_Coalesced_Get(s_tx), "wrong number of rops coalesced from the stream");
+    s_check((5 == n) && (s_id32s[0] == s_waiting[0].id32) && (s_id32s[1] == s_waiting[1].id32) && (3 == s_waiting[1].value) &&
+            (s_id32s[2] == s_waiting[2].id32) && (eo_ropcode_sig == s_waiting[3].ropc) && (eo_ropcode_sig == s_waiting[4].ropc),
+            "the rops of the stream are not in the order of their first arrival with their last value");
+
+    // the index agrees with the offsets left by the stream
+    s_ask(s_id32s[0], eok_ropctrl_basic);
+    s_ask(s_id32s[2], eok_ropctrl_basic);
+    size = s_append(stream, 0, eo_ropcode_set, s_id32s[1], 4, 4);
+    eo_transmitter_occasional_rops_LoadStream(s_tx, stream, size);
+    n = s_scan();
+    s_check((5 == n) && (7 == eo_transmitter_occasional_rops_Coalesced_Get(s_tx)) && (4 == s_waiting[1].value),
+            "the rops loaded after the stream are not coalesced in their position");
+    eo_hosttransceiver_Delete(s_host);
+}
+
+static void s_staging(void)
+{   // the rops staged by a producer are coalesced when they are drained into the ropframe
+    uint16_t numberofoccasionals = 0;
+    int n = 0;
+    int r = 0;
+    int i = 0;
+
+    s_new(eo_ropframe_sizeforZEROrops + 1024, eobool_true);
+    if(eores_OK != eo_transmitter_Staging_Set(s_tx, 1, 2048))
+    {
+        printf("SKIP: the staging mode is not available\n");
+        eo_hosttransceiver_Delete(s_host);
+        return;
+    }
+
+    for(r=0; r<NUMBEROFROUNDS; r++)
+    {
+        for(i=0; i<NUMBEROFIDS; i++)
+        {
+            s_ask(s_id32s[i], eok_ropctrl_basic);
+        }
+    }
+    s_check(0 == s_scan(), "the staged rops are not in the queue");
+    eo_transmitter_NumberofOutROPs(s_tx, NULL, &numberofoccasionals, NULL);
+    n = s_scan();
+    s_check((NUMBEROFIDS == numberofoccasionals) && (NUMBEROFIDS == n), "the staged rops are not coalesced at the drain");
+    s_check(((NUMBEROFROUNDS-1)*NUMBEROFIDS) == eo_transmitter_occasional_rops_Coalesced_Get(s_tx), "wrong number of coalesced staged rops");
+    s_check(0 == eo_transmitter_Staging_Fallbacks_Get(s_tx), "the staged rops went through the mutexes");
+    eo_hosttransceiver_Delete(s_host);
+}
+
+static void s_carryover(void)
+{   // a packet has room for 5 ask<> of the 10 waiting. the 5 left move to the beginning of the ropframe
+    uint16_t numberofrops = 0;
+    eOtransmitter_ropsnumber_t number;
+    EOpacket *packet = NULL;
+    int inorder = 1;
+    int n = 0;
+    int i = 0;
+
+    s_new(eo_ropframe_sizeforZEROrops + 5*sizeof(eOrophead_t), eobool_true);
+    for(i=0; i<10; i++)
+    {
+        s_ask(s_id32s[i], eok_ropctrl_basic);
+    }
+    eo_transmitter_outpacket_Prepare(s_tx, &numberofrops, &number);
+    eo_transmitter_outpacket_Get(s_tx, &packet);
+    s_check(5 == number.numberofoccasionals, "the packet does not carry 5 occasionals");
+
+    // an id still waiting is coalesced, an id already sent is not
+    s_ask(s_id32s[7], eok_ropctrl_basic);
+    s_ask(s_id32s[2], eok_ropctrl_basic);
+    s_ask(s_id32s[9], eok_ropctrl_basic);
+    s_ask(s_id32s[5], eok_ropctrl_basic);
+    n = s_scan();
+    for(i=0; (i<n) && (i<5); i++)
+    {
+        inorder &= (s_waiting[i].id32 == s_id32s[5+i]) ? (1) : (0);
+    }
+    s_check(6 == n, "the index is not rebuilt after the carry-over");
+    s_check(3 == eo_transmitter_occasional_rops_Coalesced_Get(s_tx), "wrong number of coalesced rops after the carry-over");
+    s_check(inorder && (6 == n) && (s_id32s[2] == s_waiting[5].id32), "the rops carried over are not in order");
+
+    // and again after the packet which sends them all
+    eo_transmitter_outpacket_Prepare(s_tx, &numberofrops, &number);
+    eo_transmitter_outpacket_Get(s_tx, &packet);
+    eo_transmitter_outpacket_Prepare(s_tx, &numberofrops, &number);
+    eo_transmitter_outpacket_Get(s_tx, &packet);
+    s_ask(s_id32s[2], eok_ropctrl_basic);
+    s_ask(s_id32s[5], eok_ropctrl_basic);
+    s_check((2 == s_scan()) && (3 == eo_transmitter_occasional_rops_Coalesced_Get(s_tx)), "rops are coalesced into rops already sent");
+    eo_hosttransceiver_Delete(s_host);
+}
+
+int main(void)
+{
+    eoy_sys_Initialise(NULL, NULL, NULL);
+
+    s_new(eo_ropframe_sizeforZEROrops + 1024, eobool_false);
+    eo_hosttransceiver_Delete(s_host);
+    if(s_numberofid32s < MAXIDS)
+    {
+        printf("SKIP: the board has only %u ids with a variable from 4 to %u bytes\n", s_numberofid32s, MAXSIZEOFVALUE);
+        return(0);
+    }
+
+    s_hundred();
+    s_mismatch();
+    s_stream();
+    s_staging();
+    s_carryover();
+
+    printf("%s\n", (0 == s_errors) ? "OK" : "FAIL");
+    return((0 == s_errors) ? 0 : 1);
+}
@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+// it sends the regulars of a transceiver to another one with the delta encoding. it checks the first key frame, a delta
+// with changed and unchanged rops, the key frame at the end of the period, the delta rops discarded after a lost packet
+// until the next key frame, and the key frame forced by a change of the size of the regulars. after every decoded
+// packet the NVs of the receiver must be equal to the ones of the transmitter.
+
+#include "EoCommon.h"
+#include "EOYtheSystem.h"
+#include "EOhostTransceiver.h"
+#include "EOtransceiver.h"
+#include "EOtransmitter.h"
+#include "EOreceiver.h"
+#include "EOnv_hid.h"
+#include "EOnvSet.h"
+#include "EOpacket.h"
+#include "EOropframe.h"
+#include "EoProtocol.h"
+#include "EoProtocolMC.h"
+
+#include <stdio.h>
+#include <string.h>
+
+
+#define NUMBEROFREGULARS    4
+#define KEYFRAMEPERIOD      4
+
+static EOhostTransceiver *s_hostA = NULL;
+static EOhostTransceiver *s_hostB = NULL;
+static uint32_t s_id32s[NUMBEROFREGULARS+1];
+static uint8_t s_nregulars = 0;
+static int s_errors = 0;
+
+static void s_check(int condition, int cycle, const char *what)
+{
+    if(!condition)
+    {
+        printf("FAIL: cycle %d: %s\n", cycle, what);
+        s_errors++;
+    }
+}
+
+static void s_change(uint8_t regular, uint8_t value)
+{   // it writes one byte of the NV of the transmitter, as its owner does
+    EOnv nv;
+    eo_nvset_NV_Get(eo_hosttransceiver_GetNVset(s_hostA), s_id32s[regular], &nv);
+    ((uint8_t*)eo_nv_RAM(&nv))[1] = value;
+}
+
+static eObool_t s_equal(void)
+{   // the regulars of the receiver have the values of the ones of the transmitter
+    uint8_t i = 0;
+    for(i=0; i<s_nregulars; i++)
+    {
+        EOnv nva, nvb;
+        eo_nvset_NV_Get(eo_hosttransceiver_GetNVset(s_hostA), s_id32s[i], &nva);
+        eo_nvset_NV_Get(eo_hosttransceiver_GetNVset(s_hostB), s_id32s[i], &nvb);
+        if(0 != memcmp(eo_nv_RAM(&nva), eo_nv_RAM(&nvb), eo_nv_Size(&nva)))
+        {
+            return(eobool_false);
+        }
+    }
+    return(eobool_true);
+}
+
+static uint16_t s_cycle(eObool_t deliver, uint16_t *numberofrops)
+{   // it sends a packet from A to B, if delivered, and returns its size
+    EOtransceiver *txrxA = eo_hosttransceiver_GetTransceiver(s_hostA);
+    EOtransceiver *txrxB = eo_hosttransceiver_GetTransceiver(s_hostB);
+    EOpacket *packet = NULL;
+    uint8_t *payload = NULL;
+    uint16_t size = 0;
+    uint16_t nrops = 0;
+
+    eo_transceiver_outpacket_Prepare(txrxA, &nrops, NULL);
+    eo_transceiver_outpacket_Get(txrxA, &packet);
+    eo_packet_Payload_Get(packet, &payload, &size);
+
+    *numberofrops = 0;
+    if(eobool_true == deliver)
+    {
+        eo_receiver_ProcessAppend(eo_transceiver_GetReceiver(txrxB), packet, numberofrops, NULL, NULL, NULL, NULL);
+    }
+    return(size);
+}
+
+static eObool_t s_load(uint32_t id32)
+{
+    eOropdescriptor_t ropdes = eok_ropdesc_basic;
+    ropdes.ropcode = eo_ropcode_sig;
+    ropdes.id32 = id32;
+    if(eores_OK != eo_transceiver_RegularROP_Load(eo_hosttransceiver_GetTransceiver(s_hostA), &ropdes))
+    {
+        return(eobool_false);
+    }
+    s_id32s[s_nregulars++] = id32;
+    return(eobool_true);
+}
+
+int main(void)
+{
+    eOhosttransceiver_cfg_t cfg = eo_hosttransceiver_cfg_default;
+    eOnvset_BRDcfg_t brdcfgB;
+    EOtransmitter *transmitter = NULL;
+    EOreceiver *receiver = NULL;
+    eOtransmitter_deltastatistics_t txstats;
+    eOreceiver_deltastatistics_t rxstats;
+    uint16_t keysize = 0;
+    uint16_t size = 0;
+    uint16_t nrops = 0;
+    int cycle = 0;
+    uint8_t i = 0;
+
+    eoy_sys_Initialise(NULL, NULL, NULL);
+
+    cfg.nvsetbrdcfg = &eonvset_BRDcfgMax;
+    // the host has no regulars by default
+    cfg.sizes.capacityoftxpacket = 1024;
+    cfg.sizes.capacityofropframeregulars = 640;
+    cfg.sizes.maxnumberofregularrops = 16;
+    cfg.sizes.capacityofropframeoccasionals = cfg.sizes.capacityoftxpacket - cfg.sizes.capacityofropframeregulars - 
+                                              cfg.sizes.capacityofropframereplies - eo_ropframe_sizeforZEROrops;
+    s_hostA = eo_hosttransceiver_New(&cfg);
+    // another board number, otherwise the two hosts share the ram of the NVs
+    brdcfgB = eonvset_BRDcfgMax;
+    brdcfgB.boardnum = eonvset_BRDcfgMax.boardnum - 1;
+    cfg.nvsetbrdcfg = &brdcfgB;
+    cfg.remoteboardipv4addr = EO_COMMON_IPV4ADDR(10, 0, 1, 2);
+    s_hostB = eo_hosttransceiver_New(&cfg);
+    transmitter = eo_transceiver_GetTransmitter(eo_hosttransceiver_GetTransceiver(s_hostA));
+    receiver = eo_transceiver_GetReceiver(eo_hosttransceiver_GetTransceiver(s_hostB));
+
+    for(i=0; i<NUMBEROFREGULARS; i++)
+    {
+        s_load(eoprot_ID_get(eoprot_endpoint_motioncontrol, eoprot_entity_mc_joint, i, eoprot_tag_mc_joint_status));
+    }
+    s_check(NUMBEROFREGULARS == s_nregulars, 0, "the regulars cannot be loaded");
+
+    eo_receiver_Delta_Set(receiver, cfg.sizes.capacityoftxpacket);
+    eo_transmitter_regular_rops_Delta_Set(transmitter, KEYFRAMEPERIOD);
+
+    // cycle 0: the first delta rop is a key frame
+    keysize = s_cycle(eobool_true, &nrops);
+    eo_transmitter_regular_rops_Delta_GetStatistics(transmitter, &txstats);
+    eo_receiver_Delta_GetStatistics(receiver, &rxstats);
+    s_check((1 == txstats.keyframes) && (0 == txstats.deltaframes), cycle, "the first delta rop is not a key frame");
+    s_check((1 == rxstats.decoded) && (NUMBEROFREGULARS == nrops), cycle, "the key frame is not decoded");
+    s_check(eobool_true == s_equal(), cycle, "the NVs differ after the key frame");
+
+    // cycles 1, 2, 3: deltas where one rop changes and the others do not
+    for(cycle=1; cycle<KEYFRAMEPERIOD; cycle++)
+    {
+        s_change(cycle % NUMBEROFREGULARS, (uint8_t)(0x10 + cycle));
+        size = s_cycle(eobool_true, &nrops);
+        s_check(size < keysize, cycle, "the delta rop is not smaller than the key frame");
+        s_check(NUMBEROFREGULARS == nrops, cycle, "the delta rop does not carry all the regulars");
+        s_check(eobool_true == s_equal(), cycle, "the NVs differ after the delta rop");
+    }
+    eo_transmitter_regular_rops_Delta_GetStatistics(transmitter, &txstats);
+    s_check((1 == txstats.keyframes) && ((KEYFRAMEPERIOD-1) == txstats.deltaframes), cycle, "wrong number of delta rops");
+
+    // cycle 4: the period rolls over and a new key frame is sent
+    s_change(0, 0x20);
+    s_cycle(eobool_true, &nrops);
+    eo_transmitter_regular_rops_Delta_GetStatistics(transmitter, &txstats);
+    s_check(2 == txstats.keyframes, cycle, "no key frame at the end of the period");
+    s_check(eobool_true == s_equal(), cycle, "the NVs differ after the second key frame");
+
+    // cycle 5 is lost: the deltas of cycles 6 and 7 miss their reference and are discarded
+    for(cycle=5; cycle<(2*KEYFRAMEPERIOD); cycle++)
+    {
+        s_change(1, (uint8_t)(0x20 + cycle));
+        s_cycle((5 == cycle) ? (eobool_false) : (eobool_true), &nrops);
+        s_check(0 == nrops, cycle, "a delta rop without its reference was decoded");
+        s_check(eobool_false == s_equal(), cycle, "the NVs are equal even if the packet was lost");
+    }
+    eo_receiver_Delta_GetStatistics(receiver, &rxstats);
+    s_check(2 == rxstats.discarded, cycle, "wrong number of discarded delta rops");
+
+    // cycle 8: the next key frame gives the receiver its reference back
+    s_cycle(eobool_true, &nrops);
+    eo_transmitter_regular_rops_Delta_GetStatistics(transmitter, &txstats);
+    s_check(3 == txstats.keyframes, cycle, "no key frame after the lost packet");
+    s_check(NUMBEROFREGULARS == nrops, cycle, "the key frame after the lost packet is not decoded");
+    s_check(eobool_true == s_equal(), cycle, "the NVs differ after the key frame which follows the lost packet");
+
+    // cycle 9: one more regular changes the size of the regulars, thus a key frame is sent before the period ends
+    cycle++;
+    s_check(eobool_true == s_load(eoprot_ID_get(eoprot_endpoint_motioncontrol, eoprot_entity_mc_joint, NUMBEROFREGULARS, eoprot_tag_mc_joint_status)), cycle, "the new regular cannot be loaded");
+    s_change(NUMBEROFREGULARS, 0x30);
+    s_cycle(eobool_true, &nrops);
+    eo_transmitter_regular_rops_Delta_GetStatistics(transmitter, &txstats);
+    s_check(4 == txstats.keyframes, cycle, "no key frame after the change of size");
+    s_check((NUMBEROFREGULARS+1) == nrops, cycle, "the key frame after the change of size is not decoded");
+    s_check(eobool_true == s_equal(), cycle, "the NVs differ after the change of size");
+
+    // cycle 10: and a delta follows it
+    cycle++;
+    s_change(0, 0x40);
+    s_cycle(eobool_true, &nrops);
+    eo_transmitter_regular_rops_Delta_GetStatistics(transmitter, &txstats);
+    s_check((4 == txstats.keyframes) && ((2*(KEYFRAMEPERIOD-1)+1) == txstats.deltaframes), cycle, "no delta rop after the change of size");
+    s_check(eobool_true == s_equal(), cycle, "the NVs differ after the delta rop of the new size");
+    eo_receiver_Delta_GetStatistics(receiver, &rxstats);
+
+    eo_hosttransceiver_Delete(s_hostA);
+    eo_hosttransceiver_Delete(s_hostB);
+
+    printf("%s: %u key frames, %u delta rops, %u decoded, %u discarded\n", (0 == s_errors) ? "OK" : "FAIL",
+           txstats.keyframes, txstats.deltaframes, rxstats.decoded, rxstats.discarded);
+    return((0 == s_errors) ? 0 : 1);
+}
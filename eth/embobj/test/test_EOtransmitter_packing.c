@@ -0,0 +1,437 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+// it verifies the packing of the out packet of the EOtransmitter with eo_transmitter_outpacket_Prepare() and with
+// eo_transmitter_outpacket_PrepareGather(). a packet of 188 bytes has room for 20 ask<> rops while 10 regulars, 40
+// occasionals and 30 replies wait: every packet must be a valid ropframe, the priorities and the budgets must be
+// respected, with carry-over the rops must all arrive in order within 7 packets, without carry-over they must be
+// counted as dropped. a rop which is bigger than the packet or than its budget must be dropped, and in scatter-gather
+// mode the rops carried over into the spare buffer must not change the segments of the packet just prepared.
+
+#include "EoCommon.h"
+#include "EOYtheSystem.h"
+#include "EOhostTransceiver.h"
+#include "EOtransceiver.h"
+#include "EOtransmitter.h"
+#include "EOpacket.h"
+#include "EOropframe.h"
+#include "EOropframe_hid.h"
+#include "EOrop.h"
+#include "EoProtocol.h"
+
+#include <stdio.h>
+#include <string.h>
+
+
+#define SIZEOFROPS          160                                     // 20 ask<> rops
+#define CAPACITYOFPACKET    (eo_ropframe_sizeforZEROrops + SIZEOFROPS)
+#define NUMBEROFREGULARS    10
+#define NUMBEROFOCCASIONALS 40
+#define NUMBEROFREPLIES     30
+#define MAXIDS              600
+#define MAXROPS             64
+
+typedef struct
+{   // what a packet contains
+    eOtransmitter_ropsnumber_t  number;
+    uint16_t                    numberofrops;
+    uint32_t                    id32s[MAXROPS];
+    uint16_t                    sizeofrops;
+} packet_t;
+
+static int s_errors = 0;
+static uint32_t s_id32s[MAXIDS];
+static uint16_t s_numberofid32s = 0;
+static uint32_t s_bigid32 = 0;
+static uint16_t s_bigsize = 0;
+static EOhostTransceiver *s_host = NULL;
+static EOtransmitter *s_tx = NULL;
+
+static void s_check(int condition, const char *mode, const char *what)
+{
+    if(!condition)
+    {
+        printf("FAIL: %s: %s\n", mode, what);
+        s_errors++;
+    }
+}
+
+static void s_new(const eOtransmitter_packing_t *packing)
+{
+    eOhosttransceiver_cfg_t cfg = eo_hosttransceiver_cfg_default;
+    uint8_t ep = 0;
+    uint8_t en = 0;
+    uint8_t ix = 0;
+    uint8_t tg = 0;
+
+    cfg.nvsetbrdcfg = &eonvset_BRDcfgMax;
+    cfg.sizes.capacityoftxpacket = CAPACITYOFPACKET;
+    cfg.sizes.capacityofropframeregulars = eo_ropframe_sizeforZEROrops + 200;
+    cfg.sizes.capacityofropframeoccasionals = eo_ropframe_sizeforZEROrops + 400;
+    cfg.sizes.capacityofropframereplies = eo_ropframe_sizeforZEROrops + 400;
+    cfg.sizes.maxnumberofregularrops = 50;
+    s_host = eo_hosttransceiver_New(&cfg);
+    s_tx = eo_transceiver_GetTransmitter(eo_hosttransceiver_GetTransceiver(s_host));
+    eo_transmitter_Packing_Set(s_tx, packing);
+
+    if(0 != s_numberofid32s)
+    {
+        return;
+    }
+    for(ep=0; ep<eoprot_endpoints_numberof; ep++)
+    {
+        for(en=0; en<8; en++)
+        {
+            for(ix=0; ix<12; ix++)
+            {
+                for(tg=0; tg<64; tg++)
+                {
+                    uint32_t id32 = eoprot_ID_get(ep, en, ix, tg);
+                    uint16_t size = 0;
+                    if((s_numberofid32s >= MAXIDS) || (eobool_false == eoprot_id_isvalid(eo_hosttransceiver_GetBoardNumber(s_host), id32)))
+                    {
+                        continue;
+                    }
+                    s_id32s[s_numberofid32s++] = id32;
+                    // a variable whose sig<> does not fit in the packet, but fits in the ropframe of the occasionals
+                    size = eoprot_variable_sizeof_get(eo_hosttransceiver_GetBoardNumber(s_host), id32);
+                    if((0 == s_bigid32) && (size > SIZEOFROPS) && (size < 240))
+                    {
+                        s_bigid32 = id32;
+                        s_bigsize = sizeof(eOrophead_t) + eo_rop_datafield_effective_size(size);
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void s_load(eOropcode_t ropcode, uint16_t first, uint16_t regulars, uint16_t occasionals, uint16_t replies)
+{   // the regulars take the last ids so that they differ from the others
+    eOropdescriptor_t ropdes = eok_ropdesc_basic;
+    uint16_t i = 0;
+
+    ropdes.ropcode = eo_ropcode_ask;
+    for(i=0; i<regulars; i++)
+    {
+        ropdes.id32 = s_id32s[s_numberofid32s - 1 - i];
+        eo_transmitter_regular_rops_Load(s_tx, &ropdes);
+    }
+    ropdes.ropcode = ropcode;
+    for(i=0; i<occasionals; i++)
+    {
+        ropdes.id32 = s_id32s[first + i];
+        eo_transmitter_occasional_rops_Load(s_tx, &ropdes);
+    }
+    ropdes.ropcode = eo_ropcode_ask;
+    for(i=0; i<replies; i++)
+    {
+        ropdes.id32 = s_id32s[100 + i];
+        eo_transmitter_reply_rops_Load(s_tx, &ropdes);
+    }
+}
+
+static int s_prepare(eObool_t gather, packet_t *packet)
+{   // it prepares a packet and returns 1 if it is a valid ropframe which agrees with the numbers given by the transmitter
+    static uint8_t frame[2*CAPACITYOFPACKET];
+    uint16_t offsets[MAXROPS];
+    uint16_t size = 0;
+    uint16_t i = 0;
+    int valid = 1;
+
+    memset(packet, 0, sizeof(packet_t));
+    if(eobool_true == gather)
+    {
+        eOtransmitter_gather_t g;
+        uint8_t s = 0;
+        eo_transmitter_outpacket_PrepareGather(s_tx, &packet->numberofrops, &packet->number);
+        eo_transmitter_outpacket_GetGather(s_tx, &g);
+        for(s=0; s<g.numberofsegments; s++)
+        {
+            if((size + g.segments[s].size) > sizeof(frame))
+            {
+                return(0);
+            }
+            memcpy(&frame[size], g.segments[s].data, g.segments[s].size);
+            size += g.segments[s].size;
+        }
+        valid = (size == g.totalsize) ? (1) : (0);
+    }
+    else
+    {
+        EOpacket *pkt = NULL;
+        uint8_t *data = NULL;
+        eo_transmitter_outpacket_Prepare(s_tx, &packet->numberofrops, &packet->number);
+        eo_transmitter_outpacket_Get(s_tx, &pkt);
+        eo_packet_Payload_Get(pkt, &data, &size);
+        if(size > sizeof(frame))
+        {
+            return(0);
+        }
+        memcpy(frame, data, size);
+    }
+
+    if((size > CAPACITYOFPACKET) || (eores_OK != eo_ropframe_Scan(frame, size, offsets, MAXROPS, &i)) || (i != packet->numberofrops))
+    {
+        return(0);
+    }
+    if(packet->numberofrops != (packet->number.numberofregulars + packet->number.numberofoccasionals + packet->number.numberofreplies))
+    {
+        return(0);
+    }
+    for(i=0; i<packet->numberofrops; i++)
+    {
+        const eOrophead_t *head = (const eOrophead_t*) &frame[sizeof(EOropframeHeader_t) + offsets[i]];
+        packet->id32s[i] = head->id32;
+    }
+    packet->sizeofrops = ((const EOropframeHeader_t*)frame)->ropssizeof;
+    return(valid);
+}
+
+static void s_statistics(eOtransmitter_packingstatistics_t *stats)
+{
+    memset(stats, 0, sizeof(eOtransmitter_packingstatistics_t));
+    eo_transmitter_Packing_GetStatistics(s_tx, stats);
+}
+
+static void s_default(eObool_t gather, const char *mode)
+{   // regulars, occasionals, replies: everything arrives in order within 7 packets
+    eOtransmitter_packingstatistics_t stats;
+    packet_t packet;
+    uint16_t occasionals = 0;
+    uint16_t replies = 0;
+    int inorder = 1;
+    int valid = 1;
+    int c = 0;
+
+    s_new(NULL);
+    s_load(eo_ropcode_ask, 0, NUMBEROFREGULARS, NUMBEROFOCCASIONALS, NUMBEROFREPLIES);
+    for(c=0; c<7; c++)
+    {
+        uint16_t i = 0;
+        valid &= s_prepare(gather, &packet);
+        valid &= (NUMBEROFREGULARS == packet.number.numberofregulars) ? (1) : (0);
+        for(i=0; i<packet.number.numberofoccasionals; i++)
+        {
+            inorder &= (packet.id32s[NUMBEROFREGULARS + i] == s_id32s[occasionals++]) ? (1) : (0);
+        }
+        for(i=0; i<packet.number.numberofreplies; i++)
+        {
+            inorder &= (packet.id32s[NUMBEROFREGULARS + packet.number.numberofoccasionals + i] == s_id32s[100 + replies++]) ? (1) : (0);
+        }
+    }
+    s_statistics(&stats);
+
+    s_check(valid, mode, "a packet is not a valid ropframe with all the regulars");
+    s_check(inorder, mode, "the occasionals or the replies are not in order");
+    s_check((NUMBEROFOCCASIONALS == occasionals) && (NUMBEROFREPLIES == replies), mode, "the rops do not arrive within 7 packets");
+    s_check((0 != stats.deferredbytes[eo_transmitter_category_occasionals]) && (0 != stats.deferredbytes[eo_transmitter_category_replies]), mode, "the rops carried over are not counted");
+    s_check((0 == stats.droppedbytes[0]) && (0 == stats.droppedbytes[1]) && (0 == stats.droppedbytes[2]), mode, "rops are dropped with carry-over");
+    s_prepare(gather, &packet);
+    s_check((NUMBEROFREGULARS == packet.numberofrops), mode, "rops are left after all have arrived");
+
+    eo_hosttransceiver_Delete(s_host);
+}
+
+static void s_priority(eObool_t gather, const char *mode)
+{   // replies first, then at most 48 bytes of occasionals, then the regulars in what is left. in scatter-gather mode the
+    // regulars are always inside the first segment, thus the replies follow them
+    eOtransmitter_packing_t packing = eo_transmitter_packing_default;
+    eOtransmitter_packingstatistics_t stats;
+    packet_t packet;
+    uint16_t occasionals = 0;
+    uint16_t replies = 0;
+    int repliesfirst = 1;
+    int budget = 1;
+    int valid = 1;
+    int c = 0;
+
+    packing.priority[0] = eo_transmitter_category_replies;
+    packing.priority[1] = eo_transmitter_category_occasionals;
+    packing.priority[2] = eo_transmitter_category_regulars;
+    packing.budget[eo_transmitter_category_occasionals] = 48;
+    s_new(&packing);
+    s_load(eo_ropcode_ask, 0, NUMBEROFREGULARS, NUMBEROFOCCASIONALS, NUMBEROFREPLIES);
+
+    valid &= s_prepare(gather, &packet);
+    s_check((20 == packet.number.numberofreplies) && (0 == packet.number.numberofoccasionals) && (0 == packet.number.numberofregulars),
+            mode, "the replies do not fill the first packet");
+    for(c=0; c<12; c++)
+    {
+        uint16_t first = (eobool_true == gather) ? (packet.number.numberofregulars) : (0);
+        uint16_t i = 0;
+        occasionals += packet.number.numberofoccasionals;
+        replies += packet.number.numberofreplies;
+        for(i=0; i<packet.number.numberofreplies; i++)
+        {
+            repliesfirst &= (packet.id32s[first + i] == s_id32s[100 + replies - packet.number.numberofreplies + i]) ? (1) : (0);
+        }
+        budget &= ((packet.number.numberofoccasionals * sizeof(eOrophead_t)) <= 48) ? (1) : (0);
+        valid &= s_prepare(gather, &packet);
+    }
+    s_statistics(&stats);
+
+    s_check(valid, mode, "a packet is not a valid ropframe");
+    s_check(repliesfirst, mode, "the replies are not at the beginning of the packet");
+    s_check(budget, mode, "the occasionals exceed their budget");
+    s_check((NUMBEROFOCCASIONALS == occasionals) && (NUMBEROFREPLIES == replies), mode, "the rops do not arrive with priorities");
+    s_check(0 != stats.droppedbytes[eo_transmitter_category_regulars], mode, "the regulars left without room are not dropped");
+
+    eo_hosttransceiver_Delete(s_host);
+}
+
+static void s_nocarryover(eObool_t gather, const char *mode)
+{   // what does not fit in the first packet is lost
+    eOtransmitter_packing_t packing = eo_transmitter_packing_default;
+    eOtransmitter_packingstatistics_t stats;
+    packet_t packet;
+    int valid = 1;
+
+    packing.carryover = eobool_false;
+    s_new(&packing);
+    s_load(eo_ropcode_ask, 0, NUMBEROFREGULARS, NUMBEROFOCCASIONALS, NUMBEROFREPLIES);
+
+    valid &= s_prepare(gather, &packet);
+    s_check((10 == packet.number.numberofoccasionals) && (0 == packet.number.numberofreplies), mode, "wrong rops without carry-over");
+    valid &= s_prepare(gather, &packet);
+    s_check((0 == packet.number.numberofoccasionals) && (0 == packet.number.numberofreplies), mode, "rops are carried over without carry-over");
+    s_statistics(&stats);
+
+    s_check(valid, mode, "a packet is not a valid ropframe without carry-over");
+    s_check(((NUMBEROFOCCASIONALS - 10) * sizeof(eOrophead_t)) == stats.droppedbytes[eo_transmitter_category_occasionals], mode, "wrong dropped bytes of the occasionals");
+    s_check((NUMBEROFREPLIES * sizeof(eOrophead_t)) == stats.droppedbytes[eo_transmitter_category_replies], mode, "wrong dropped bytes of the replies");
+    s_check((0 == stats.deferredbytes[eo_transmitter_category_occasionals]) && (0 == stats.deferredbytes[eo_transmitter_category_replies]), mode, "rops are deferred without carry-over");
+
+    eo_hosttransceiver_Delete(s_host);
+}
+
+static void s_oversize(eObool_t gather, const char *mode)
+{   // a sig<> bigger than the packet at the head of the occasionals, and replies bigger than their budget
+    eOtransmitter_packing_t packing = eo_transmitter_packing_default;
+    eOtransmitter_packingstatistics_t stats;
+    eOropdescriptor_t ropdes = eok_ropdesc_basic;
+    packet_t packet;
+    uint16_t replies = 0;
+    int valid = 1;
+    int c = 0;
+
+    if(0 == s_bigid32)
+    {
+        printf("SKIP: %s: the board has no variable bigger than the packet\n", mode);
+        return;
+    }
+
+    s_new(NULL);
+    ropdes.ropcode = eo_ropcode_sig;
+    ropdes.id32 = s_bigid32;
+    eo_transmitter_occasional_rops_Load(s_tx, &ropdes);
+    s_load(eo_ropcode_ask, 0, 0, 3, 0);
+    valid &= s_prepare(gather, &packet);
+    s_check(0 == packet.number.numberofoccasionals, mode, "a rop bigger than the packet is sent");
+    valid &= s_prepare(gather, &packet);
+    s_check((3 == packet.number.numberofoccasionals) && (packet.id32s[0] == s_id32s[0]), mode, "the rops after a rop bigger than the packet are lost");
+    s_statistics(&stats);
+    s_check(s_bigsize == stats.droppedbytes[eo_transmitter_category_occasionals], mode, "the rop bigger than the packet is not counted as dropped");
+    eo_hosttransceiver_Delete(s_host);
+
+    // every packet drops the reply at the head, which is bigger than the budget
+    packing.budget[eo_transmitter_category_replies] = sizeof(eOrophead_t) / 2;
+    s_new(&packing);
+    s_load(eo_ropcode_ask, 0, 0, 0, 5);
+    for(c=0; c<5; c++)
+    {
+        valid &= s_prepare(gather, &packet);
+        replies += packet.number.numberofreplies;
+    }
+    s_statistics(&stats);
+    s_check(0 == replies, mode, "a rop bigger than its budget is sent");
+    s_check((5 * sizeof(eOrophead_t)) == stats.droppedbytes[eo_transmitter_category_replies], mode, "the rops bigger than the budget are not dropped one per packet");
+    s_check(valid, mode, "a packet is not a valid ropframe with oversize rops");
+    eo_hosttransceiver_Delete(s_host);
+}
+
+static void s_spare(void)
+{   // the rops loaded after PrepareGather() go into the spare buffer together with the carried over ones
+    static const char mode[] = "gather";
+    eOtransmitter_gather_t g;
+    packet_t packet;
+    uint8_t before[2*CAPACITYOFPACKET];
+    uint8_t after[2*CAPACITYOFPACKET];
+    uint16_t size = 0;
+    uint16_t occasionals = 0;
+    int inorder = 1;
+    int c = 0;
+    uint8_t s = 0;
+
+    s_new(NULL);
+    s_load(eo_ropcode_ask, 0, NUMBEROFREGULARS, NUMBEROFOCCASIONALS, 0);
+    eo_transmitter_outpacket_PrepareGather(s_tx, &packet.numberofrops, &packet.number);
+    eo_transmitter_outpacket_GetGather(s_tx, &g);
+    for(s=0, size=0; s<g.numberofsegments; s++)
+    {
+        memcpy(&before[size], g.segments[s].data, g.segments[s].size);
+        size += g.segments[s].size;
+    }
+    occasionals = packet.number.numberofoccasionals;
+
+    s_load(eo_ropcode_ask, NUMBEROFOCCASIONALS, 0, 5, 0);
+    for(s=0, size=0; s<g.numberofsegments; s++)
+    {
+        memcpy(&after[size], g.segments[s].data, g.segments[s].size);
+        size += g.segments[s].size;
+    }
+    s_check(0 == memcmp(before, after, size), mode, "the rops carried over change the segments of the packet");
+
+    for(c=0; c<6; c++)
+    {
+        uint16_t i = 0;
+        s_check(s_prepare(eobool_true, &packet), mode, "a packet is not a valid ropframe after the spare buffer");
+        for(i=0; i<packet.number.numberofoccasionals; i++)
+        {
+            inorder &= (packet.id32s[NUMBEROFREGULARS + i] == s_id32s[occasionals++]) ? (1) : (0);
+        }
+    }
+    s_check(inorder && ((NUMBEROFOCCASIONALS + 5) == occasionals), mode, "the rops of the spare buffer are lost or out of order");
+
+    eo_hosttransceiver_Delete(s_host);
+}
+
+int main(void)
+{
+    static const char *modes[2] = { "prepare", "gather" };
+    eOtransmitter_packing_t packing = eo_transmitter_packing_default;
+    uint8_t m = 0;
+
+    eoy_sys_Initialise(NULL, NULL, NULL);
+
+    for(m=0; m<2; m++)
+    {
+        eObool_t gather = (1 == m) ? (eobool_true) : (eobool_false);
+        s_default(gather, modes[m]);
+        s_priority(gather, modes[m]);
+        s_nocarryover(gather, modes[m]);
+        s_oversize(gather, modes[m]);
+    }
+    s_spare();
+
+    s_new(NULL);
+    packing.priority[1] = packing.priority[0];
+    s_check(eores_NOK_generic == eo_transmitter_Packing_Set(s_tx, &packing), "set", "a priority without every category is accepted");
+    s_check(eores_OK == eo_transmitter_Packing_Set(s_tx, NULL), "set", "the default packing is refused");
+    eo_hosttransceiver_Delete(s_host);
+
+    printf("%s\n", (0 == s_errors) ? "OK" : "FAIL");
+    return((0 == s_errors) ? 0 : 1);
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+// it enables the staging mode of an EOtransmitter with two producers and runs many waves of two short-lived threads 
+// which load occasional rops. the threads of a wave must find the producers given back by the threads of the previous 
+// waves, thus no rop must go through the mutexes and every rop must reach the out packet. every thread has its own 
+// stack, so that its thread-local storage never has the same address of an exited thread.
+
+#include "EoCommon.h"
+#include "EOYtheSystem.h"
+#include "EOhostTransceiver.h"
+#include "EOtransceiver.h"
+#include "EOtransmitter.h"
+#include "EOropframe_hid.h"
+#include "EoProtocol.h"
+#include "EoProtocolMC.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+#define NUMBEROFPRODUCERS   2
+#define NUMBEROFWAVES       16
+#define ROPSPERTHREAD       10
+#define SIZEOFSTACK         (256*1024)
+
+static EOtransmitter *s_transmitter = NULL;
+
+static void* s_producer(void *arg)
+{
+    eOropdescriptor_t ropdes = eok_ropdesc_basic;
+    int i = 0;
+    (void)arg;
+    
+    ropdes.ropcode = eo_ropcode_ask;
+    ropdes.id32 = eoprot_ID_get(eoprot_endpoint_motioncontrol, eoprot_entity_mc_joint, 0, eoprot_tag_mc_joint_status);
+    for(i=0; i<ROPSPERTHREAD; i++)
+    {
+        eo_transmitter_occasional_rops_Load(s_transmitter, &ropdes);
+    }
+    return(NULL);
+}
+
+static uint32_t s_transmit(void)
+{   // it prepares packets until the transmitter has nothing left and returns the number of rops
+    uint32_t total = 0;
+    for(;;)
+    {
+        uint16_t numberofrops = 0;
+        eOtransmitter_ropsnumber_t ropsnumber;
+        EOpacket *packet = NULL;
+        eo_transmitter_outpacket_Prepare(s_transmitter, &numberofrops, &ropsnumber);
+        eo_transmitter_outpacket_Get(s_transmitter, &packet);
+        if(0 == ropsnumber.numberofoccasionals)
+        {
+            return(total);
+        }
+        total += ropsnumber.numberofoccasionals;
+    }
+}
+
+int main(void)
+{
+    eOhosttransceiver_cfg_t cfg = eo_hosttransceiver_cfg_default;
+    EOhostTransceiver *hosttxrx = NULL;
+    pthread_t threads[NUMBEROFPRODUCERS];
+    pthread_attr_t attr;
+    void *stacks[NUMBEROFWAVES*NUMBEROFPRODUCERS];
+    uint32_t transmitted = 0;
+    uint32_t fallbacks = 0;
+    int errors = 0;
+    int w = 0;
+    int i = 0;
+    
+    eoy_sys_Initialise(NULL, NULL, NULL);
+    
+    cfg.nvsetbrdcfg = &eonvset_BRDcfgMax;
+    hosttxrx = eo_hosttransceiver_New(&cfg);
+    s_transmitter = eo_transceiver_GetTransmitter(eo_hosttransceiver_GetTransceiver(hosttxrx));
+    
+    if(eores_OK != eo_transmitter_Staging_Set(s_transmitter, NUMBEROFPRODUCERS, 1024))
+    {
+        printf("SKIP: the staging mode is not available\n");
+        return(0);
+    }
+    
+    for(w=0; w<NUMBEROFWAVES; w++)
+    {
+        for(i=0; i<NUMBEROFPRODUCERS; i++)
+        {
+            stacks[w*NUMBEROFPRODUCERS+i] = malloc(SIZEOFSTACK);
+            pthread_attr_init(&attr);
+            pthread_attr_setstack(&attr, stacks[w*NUMBEROFPRODUCERS+i], SIZEOFSTACK);
+            pthread_create(&threads[i], &attr, s_producer, NULL);
+            pthread_attr_destroy(&attr);
+        }
+        for(i=0; i<NUMBEROFPRODUCERS; i++)
+        {
+            pthread_join(threads[i], NULL);
+        }
+        transmitted += s_transmit();
+    }
+    
+    fallbacks = eo_transmitter_Staging_Fallbacks_Get(s_transmitter);
+    if(0 != fallbacks)
+    {
+        printf("FAIL: %u rops went through the mutexes\n", fallbacks);
+        errors++;
+    }
+    if((NUMBEROFWAVES * NUMBEROFPRODUCERS * ROPSPERTHREAD) != transmitted)
+    {
+        printf("FAIL: %u rops transmitted instead of %d\n", transmitted, NUMBEROFWAVES * NUMBEROFPRODUCERS * ROPSPERTHREAD);
+        errors++;
+    }
+    
+    eo_hosttransceiver_Delete(hosttxrx);
+    for(i=0; i<NUMBEROFWAVES*NUMBEROFPRODUCERS; i++)
+    {
+        free(stacks[i]);
+    }
+    
+    printf("%s: %u rops transmitted\n", (0 == errors) ? "OK" : "FAIL", transmitted);
+    return((0 == errors) ? 0 : 1);
+}
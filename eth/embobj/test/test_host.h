@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+// the host services shared by the tests and the benchmarks. test_host_Initialise() starts the EOYtheSystem with the
+// given mutex backend. the user backend is a recursive pthread mutex which, as ace_mutex_take() of the FeatureInterface,
+// ignores the timeout.
+
+#ifndef _TEST_HOST_H_
+#define _TEST_HOST_H_
+
+#include "EoCommon.h"
+#include "EOYtheSystem.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+
+
+static void* s_test_host_mutex_new(void)
+{
+    pthread_mutex_t *m = (pthread_mutex_t*) malloc(sizeof(pthread_mutex_t));
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(m, &attr);
+    pthread_mutexattr_destroy(&attr);
+    return(m);
+}
+
+static int8_t s_test_host_mutex_take(void *m, uint32_t tout_usec)
+{   // as the ace mutex: the timeout is ignored
+    (void)tout_usec;
+    return((0 == pthread_mutex_lock((pthread_mutex_t*)m)) ? (0) : (-1));
+}
+
+static int8_t s_test_host_mutex_release(void *m)
+{
+    return((0 == pthread_mutex_unlock((pthread_mutex_t*)m)) ? (0) : (-1));
+}
+
+static void s_test_host_mutex_delete(void *m)
+{
+    pthread_mutex_destroy((pthread_mutex_t*)m);
+    free(m);
+}
+
+static inline void test_host_Initialise(eOysystem_mutex_backend_t backend)
+{
+    eOysystem_cfg_t cfg = {0};
+    cfg.mutexcfg.fp_new = s_test_host_mutex_new;
+    cfg.mutexcfg.fp_take = s_test_host_mutex_take;
+    cfg.mutexcfg.fp_release = s_test_host_mutex_release;
+    cfg.mutexcfg.fp_delete = s_test_host_mutex_delete;
+    cfg.mutexcfg.backend = (uint8_t)backend;
+    eoy_sys_Initialise(&cfg, NULL, NULL);
+}
+
+static inline uint64_t test_host_Nanotime(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return((uint64_t)t.tv_sec*1000000000ULL + (uint64_t)t.tv_nsec);
+}
+
+// the duration of every measure of a benchmark, in milliseconds: the first argument or a default short enough for ctest
+static inline uint32_t test_host_Duration(int argc, char *argv[], uint32_t ms)
+{
+    return((argc > 1) ? ((uint32_t)atoi(argv[1])) : (ms));
+}
+
+#endif  // include-guard
+
+// - end-of-file (leave a blank line after)----------------------------------------------------------------------------
+